@@ -33,6 +33,7 @@
 #include <memory>
 #include <unordered_map>
 
+#include <scrimmage/common/EngagementGeometry.h>
 #include <scrimmage/math/State.h>
 #include <scrimmage/entity/Contact.h>
 #include <scrimmage/pubsub/Publisher.h>
@@ -43,10 +44,19 @@ namespace sc = scrimmage;
 
 namespace scrimmage_gtri_share {
     
+// geometry, if given, must hold the entities in contacts. The targets are
+// then looked up in it instead of checking every contact.
 bool find_hitable(sc::StatePtr &own_state, sc::ID &own_id,
                   sc::ContactMapPtr contacts, int &hitable_id,
                   double dist_thresh, double az_thresh, double el_thresh,
-                  bool use_2d=false);
+                  bool use_2d=false,
+                  sc::EngagementGeometryPtr geometry=nullptr);
+
+// Same, over the cached engagements of own_id. row has to include every
+// entity within dist_thresh.
+bool find_hitable(const sc::EngagementRow &row, sc::ID &own_id,
+                  sc::ContactMapPtr contacts, int &hitable_id,
+                  double dist_thresh, double az_thresh, double el_thresh);
 
 bool is_hitable(sc::StatePtr &own_state, sc::StatePtr &tgt_state,
                 double dist_thresh, double az_thresh, double el_thresh,
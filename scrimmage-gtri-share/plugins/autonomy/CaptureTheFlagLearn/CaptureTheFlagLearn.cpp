@@ -8,6 +8,8 @@
 #include <scrimmage/entity/Entity.h>
 #include <scrimmage/math/Angles.h>
 #include <scrimmage/plugin_manager/RegisterPlugin.h>
+#include <scrimmage/common/OpponentPool.h>
+#include <scrimmage/math/LowRankCMAES.h>
 #include <scrimmage/common/Random.h>
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/common/RTree.h>
@@ -15,6 +17,7 @@
 #include <scrimmage/parse/MissionParse.h>
 #include <scrimmage/parse/ParseUtils.h>
 #include <scrimmage/math/State.h>
+#include <scrimmage/simcontrol/InferenceBatch.h>
 
 #include <scrimmage-gtri-share/utilities/Utilities.h>
 #include "CaptureTheFlagLearn.h"
@@ -30,12 +33,31 @@ namespace sgs = scrimmage_gtri_share;
 using namespace tiny_dnn;
 using namespace tiny_dnn::layers;
 
-CaptureTheFlagLearn::CaptureTheFlagLearn() : dive_altitude_(500)
+CaptureTheFlagLearn::CaptureTheFlagLearn() : dive_altitude_(500),
+    use_fixed_mlp_(true), use_quantized_(false), quantization_report_(false)
 {
 }
 
+CaptureTheFlagLearn::~CaptureTheFlagLearn()
+{
+    if (quantization_report_ && report_.samples() > 0) {
+        report_.print(std::cout, "CaptureTheFlagLearn");
+    }
+}
+
 void CaptureTheFlagLearn::init(std::map<std::string,std::string> &params)
 {
+    pub_fire_ = create_publisher("Fire");
+    reset(params);
+}
+
+// Loads and perturbs the policy again, the parameter vector, policy files
+// and perturbation seed usually differ between rollouts
+bool CaptureTheFlagLearn::reset(std::map<std::string,std::string> &params)
+{
+    use_quantized_ = false;
+    quantization_report_ = false;
+
     // Hardcode max_speed_ to 30 right now and fix later
     double max_speed_ = 30;
     desired_state_->vel() = max_speed_*Vector3d::UnitX();
@@ -57,39 +79,113 @@ void CaptureTheFlagLearn::init(std::map<std::string,std::string> &params)
     fire_FOV_ = sc::Angles::deg2rad(std::stod(params["fire_FOV"]));
     fire_2D_mode_ = sc::str2bool(params["fire_2D_mode"]);
 
-    pub_fire_ = create_publisher("Fire");
     avoid_dist_ = std::stod(params["avoid_dist"]);
     avoid_ground_height_ = std::stod(params["avoid_ground_height"]);
 
     sigma_ = parent_.lock()->parameter_vector()[0];
     n_friends_ = parent_.lock()->parameter_vector()[1];
     n_enemies_ = parent_.lock()->parameter_vector()[2];
+    rtree_->request_neighbors(std::max(n_friends_, n_enemies_));
+
+    use_fixed_mlp_ = sc::get("fixed_mlp", params, true);
+    bool fast_math = sc::get("fast_math", params, false);
+
+    // In league training the team that isn't being trained plays a frozen
+    // opponent. Its weights are converted once and then shared by every
+    // aircraft and rollout that plays it.
+    sc::OpponentPtr opponent = parent_.lock()->opponent();
+    bool league_opponent = opponent &&
+        parent_.lock()->id().team_id() != parent_.lock()->parameter_vector()[7];
+    if (league_opponent && use_fixed_mlp_) {
+        std::shared_ptr<const FixedPolicy> policy = opponent->compiled<FixedPolicy>();
+        if (policy) {
+            fixed_policy_ = *policy;
+            fixed_policy_.set_fast_math(fast_math);
+            return true;
+        }
+    }
 
-    //peturb weights of neural network with random seed
-    if (parent_.lock()->id().team_id() == 1){
+    //peturb weights of neural network with random seed. With common random
+    //numbers the mission seed is the scenario, shared by several samples,
+    //and each sample has its own perturbation_seed.
+    std::map<std::string, std::string> &mission_params = parent_.lock()->mp()->params();
+    int seed = sc::get<int>("perturbation_seed", mission_params, std::stoi(mission_params["seed"]));
+    if (league_opponent) {
+        policy_network.load(opponent->nn_path());
+    } else if (opponent) {
+        // the trained team, which may be team 2 when playing against self
+        policy_network.load(parent_.lock()->nn_path());
+        perturb(seed);
+    } else if (parent_.lock()->id().team_id() == 1){
         std::string nn_path = parent_.lock()->nn_path();
         policy_network.load(nn_path);
-        policy_network.perturb_weights(std::stoi(parent_.lock()->mp()->params()["seed"]), sigma_);
+        perturb(seed);
     }else{
         std::string nn_path = parent_.lock()->nn_path2();
         policy_network.load(nn_path);
-        policy_network.perturb_weights(std::stoi(parent_.lock()->mp()->params()["seed"])+1, sigma_);
+        policy_network.perturb_weights(seed+1, sigma_);
+    }
+
+    // copy the perturbed weights into the fixed-topology network
+    if (use_fixed_mlp_ && !fixed_policy_.from_network(policy_network)) {
+        std::cout << "CaptureTheFlagLearn: unexpected network topology, "
+                  << "using tiny_dnn for inference" << std::endl;
+        use_fixed_mlp_ = false;
     }
+    fixed_policy_.set_fast_math(fast_math);
+
+    // quantized weights are only accurate enough for the unperturbed policy
+    sc::MLPPrecision precision;
+    std::string precision_str = sc::get<std::string>("quantized_policy", params, "none");
+    if (!sc::str2precision(precision_str, precision)) {
+        std::cout << "CaptureTheFlagLearn: unknown quantized_policy "
+                  << precision_str << ", using float" << std::endl;
+        precision = sc::MLPPrecision::FLOAT32;
+    }
+    if (precision != sc::MLPPrecision::FLOAT32 && sigma_ == 0) {
+        use_quantized_ = quantized_policy_.from_network(policy_network, precision);
+        if (!use_quantized_) {
+            std::cout << "CaptureTheFlagLearn: unexpected network topology, "
+                      << "using float policy" << std::endl;
+        }
+    }
+    quantization_report_ = use_quantized_ && sc::get("quantization_report", params, false);
+    return true;
+}
 
+void CaptureTheFlagLearn::perturb(size_t seed)
+{
+    // CMA-ES style learners sample from their adapted distribution, the
+    // others add isotropic noise
+    std::shared_ptr<const sc::LowRankCMAES> dist = parent_.lock()->search_distribution();
+    if (dist && sigma_ != 0) {
+        vec_t theta = policy_network.get_weights();
+        if (theta.size() == dist->size()) {
+            dist->sample(seed, theta);
+            policy_network.set_weights(theta);
+            return;
+        }
+        std::cout << "CaptureTheFlagLearn: search distribution has "
+                  << dist->size() << " weights, the network " << theta.size()
+                  << std::endl;
+    }
+    policy_network.perturb_weights(seed, sigma_);
 }
 
 bool CaptureTheFlagLearn::step_autonomy(double t, double dt)
 {
     // Search for closest enemy
-    std::vector<sc::ID> enemy_neighbors;
+    std::vector<sc::ID> enemy_storage;
     int other_team_id = parent_.lock()->id().team_id() == 1 ? 2 : 1;
-    rtree_->nearest_n_neighbors(state_->pos_const(), enemy_neighbors, n_enemies_, parent_.lock()->id().id(), other_team_id);
+    sc::IDSlice enemy_neighbors = rtree_->nearest_neighbors(
+        state_->pos_const(), parent_.lock()->id().id(), n_enemies_, enemy_storage, other_team_id);
 
     //shoot at enemies
     int hitable_id;
     if (sgs::find_hitable(state_, parent_.lock()->id(), contacts_, hitable_id,
                         fire_range_max_, fire_FOV_, fire_FOV_,
-                        fire_2D_mode_)) {
+                        fire_2D_mode_,
+                        parent_.lock()->engagement_geometry())) {
         sgs::publish_fire(t, pub_fire_, network_id_, parent_.lock()->id().id(),
                           hitable_id);
     }
@@ -116,8 +212,9 @@ bool CaptureTheFlagLearn::step_autonomy(double t, double dt)
             return true;
         }
     }
-    std::vector<sc::ID> my_neighbors;
-    rtree_->nearest_n_neighbors(state_->pos_const(), my_neighbors, n_friends_, parent_.lock()->id().id(), parent_.lock()->id().team_id());
+    std::vector<sc::ID> my_storage;
+    sc::IDSlice my_neighbors = rtree_->nearest_neighbors(
+        state_->pos_const(), parent_.lock()->id().id(), n_friends_, my_storage, parent_.lock()->id().team_id());
     if(!my_neighbors.empty()){
         int id = my_neighbors.front().id();
         sc::State &tgt_state = *contacts_->at(id).state();
@@ -133,8 +230,10 @@ bool CaptureTheFlagLearn::step_autonomy(double t, double dt)
         }
     }
 
-    //nn policy
-    vec_t in(policy_network.in_data_size(),0.0);
+    //nn policy. League opponents only load the shared fixed_policy_, their
+    //policy_network stays empty.
+    vec_t in(use_fixed_mlp_ ? fixed_policy_.in_data_size() :
+             policy_network.in_data_size(), 0.0);
     size_t input_idx=0;
 
     double pos_scale=100.0;
@@ -153,9 +252,9 @@ bool CaptureTheFlagLearn::step_autonomy(double t, double dt)
     in[input_idx++]=state_->pos()(0)/pos_scale*sign_change;
     in[input_idx++]=state_->pos()(1)/pos_scale*sign_change;
     in[input_idx++]=state_->pos()(2)/pos_scale;
-    in[input_idx++]=state_->quat().roll()/angle_scale;
-    in[input_idx++]=state_->quat().pitch()/angle_scale;
-    in[input_idx++]=state_->quat().yaw()/angle_scale+shift_angle;
+    in[input_idx++]=state_->roll()/angle_scale;
+    in[input_idx++]=state_->pitch()/angle_scale;
+    in[input_idx++]=state_->yaw()/angle_scale+shift_angle;
     in[input_idx++]=state_->vel()(0)/vel_scale*sign_change;
     in[input_idx++]=state_->vel()(1)/vel_scale*sign_change;
     in[input_idx++]=state_->vel()(2)/vel_scale;
@@ -186,9 +285,9 @@ bool CaptureTheFlagLearn::step_autonomy(double t, double dt)
             in[input_idx++]=(contacts_->at(id).state()->pos()(1) - state_->pos()(1))/pos_scale*sign_change;
             in[input_idx++]=(contacts_->at(id).state()->pos()(2) - state_->pos()(2))/pos_scale;
             in[input_idx++]=(contacts_->at(id).state()->pos() - state_->pos()).norm()/pos_scale;
-            in[input_idx++]=contacts_->at(id).state()->quat().roll()/angle_scale;
-            in[input_idx++]=contacts_->at(id).state()->quat().pitch()/angle_scale;
-            in[input_idx++]=contacts_->at(id).state()->quat().yaw()/angle_scale+shift_angle;
+            in[input_idx++]=contacts_->at(id).state()->roll()/angle_scale;
+            in[input_idx++]=contacts_->at(id).state()->pitch()/angle_scale;
+            in[input_idx++]=contacts_->at(id).state()->yaw()/angle_scale+shift_angle;
             in[input_idx++]=contacts_->at(id).state()->vel()(0)/vel_scale*sign_change;
             in[input_idx++]=contacts_->at(id).state()->vel()(1)/vel_scale*sign_change;
             in[input_idx++]=contacts_->at(id).state()->vel()(2)/vel_scale;
@@ -212,12 +311,32 @@ bool CaptureTheFlagLearn::step_autonomy(double t, double dt)
             input_idx+=7;
         }
     }
-    // pass input through neural network
-    auto res = policy_network.predict(in);
+    auto set_desired_state = [=](const vec_t &res) {
+        desired_state_->quat().set(0,0,res[0]*angle_scale+shift_angle); //set heading
+        desired_state_->pos() = (state_->pos()(2) + res[1]*pos_scale) * Vector3d::UnitZ(); //set altitude
+        desired_state_->vel()(0) = state_->vel().norm() + res[2]*vel_scale; //set velocity
+    };
+
+    // In a BatchSimControl the forward pass runs after every autonomy of the
+    // batch has stepped, together with the other entities that play the
+    // same weights, and before the controllers read the desired state.
+    sc::InferenceBatchPtr batch = parent_.lock()->inference_batch();
+    if (batch && use_fixed_mlp_ && !use_quantized_) {
+        batch->queue(fixed_policy_).add(in.data(), set_desired_state);
+        return true;
+    }
 
-    desired_state_->quat().set(0,0,res[0]*angle_scale+shift_angle); //set heading
-    desired_state_->pos() = (state_->pos()(2) + res[1]*pos_scale) * Vector3d::UnitZ(); //set altitude
-    desired_state_->vel()(0) = state_->vel().norm() + res[2]*vel_scale; //set velocity
+    // pass input through neural network
+    vec_t res;
+    if (use_quantized_) {
+        res = quantized_policy_.predict(in);
+        if (quantization_report_) {
+            report_.add(use_fixed_mlp_ ? fixed_policy_.predict(in) : policy_network.predict(in), res);
+        }
+    } else {
+        res = use_fixed_mlp_ ? fixed_policy_.predict(in) : policy_network.predict(in);
+    }
+    set_desired_state(res);
 
 
 //    //decide on greedy shooter or dive bomber behavior
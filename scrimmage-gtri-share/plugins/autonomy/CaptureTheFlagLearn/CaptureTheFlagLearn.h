@@ -29,11 +29,15 @@
 #define CaptureTheFlagLearn_H_
 #include <memory>
 #include <scrimmage/autonomy/Autonomy.h>
+#include <scrimmage/math/FixedMLP.h>
+#include <scrimmage/math/QuantizedMLP.h>
 #include "tiny_dnn/tiny_dnn.h"
 
 
 class CaptureTheFlagLearn : public scrimmage::Autonomy {
 public:
+    typedef scrimmage::FixedMLP<200, 200, 50, 3> FixedPolicy;
+
     typedef enum Mode {
          GreedyShooter = 0,
          DiveBomber,
@@ -41,12 +45,15 @@ public:
     } Mode_t;
 
     CaptureTheFlagLearn();
-    ~CaptureTheFlagLearn() {}
+    ~CaptureTheFlagLearn();
     virtual void init(std::map<std::string,std::string> &params);
+    virtual bool reset(std::map<std::string,std::string> &params);
     virtual bool step_autonomy(double t, double dt);
     virtual bool posthumous(double t);
 
 protected:
+    void perturb(size_t seed);
+
 private:     
     Mode_t mode_;
     double dist_xy_;
@@ -64,6 +71,16 @@ private:
 
     tiny_dnn::network<tiny_dnn::sequential> policy_network;
 
+    // fc(N,200) tanh fc(200,200) tanh fc(200,50) tanh fc(50,3) tanh
+    FixedPolicy fixed_policy_;
+    bool use_fixed_mlp_;
+
+    // int8 / bf16 policy, only used when sigma is 0 (evaluation and playback)
+    scrimmage::QuantizedMLP<200, 200, 50, 3> quantized_policy_;
+    bool use_quantized_;
+    bool quantization_report_;
+    scrimmage::QuantizationReport report_;
+
     scrimmage::PublisherPtr pub_fire_;
 };
 
@@ -28,6 +28,17 @@ QuadDefense::QuadDefense()
 }
 
 void QuadDefense::init(std::map<std::string,std::string> &params)
+{
+    pub_fire_ = create_publisher("Fire");
+    sub_oneteam_ = create_subscriber("OneTeamPresent");
+
+    // nearest enemy and nearest friend
+    rtree_->request_neighbors(1);
+
+    reset(params);
+}
+
+bool QuadDefense::reset(std::map<std::string,std::string> &params)
 {
     desired_state_->vel() = Eigen::Vector3d::Zero();
     desired_state_->quat().set(0,0,state_->quat().yaw());
@@ -45,12 +56,10 @@ void QuadDefense::init(std::map<std::string,std::string> &params)
     fire_FOV_ = sc::Angles::deg2rad(std::stod(params["fire_FOV"]));
     fire_2D_mode_ = sc::str2bool(params["fire_2D_mode"]);
 
-    pub_fire_ = create_publisher("Fire");
     avoid_dist_ = std::stod(params["avoid_dist"]);
 
-    sub_oneteam_ = create_subscriber("OneTeamPresent");
-
     in_position_ = false;
+    return true;
 }
 
 bool QuadDefense::step_autonomy(double t, double dt)
@@ -61,14 +70,16 @@ bool QuadDefense::step_autonomy(double t, double dt)
         return true;
     }
 
-    std::vector<sc::ID> neighbors; 
+    std::vector<sc::ID> storage;
     int other_team_id = parent_.lock()->id().team_id() == 1 ? 2 : 1;
-    rtree_->nearest_n_neighbors(state_->pos(), neighbors, 1, parent_.lock()->id().id(), other_team_id);
+    sc::IDSlice neighbors = rtree_->nearest_neighbors(
+        state_->pos_const(), parent_.lock()->id().id(), 1, storage, other_team_id);
 
     int hitable_id;
     if (sgs::find_hitable(state_, parent_.lock()->id(), contacts_, hitable_id,
                           fire_range_max_, fire_FOV_, fire_FOV_,
-                          fire_2D_mode_)) {
+                          fire_2D_mode_,
+                          parent_.lock()->engagement_geometry())) {
         sgs::publish_fire(t, pub_fire_, network_id_, parent_.lock()->id().id(),
                           hitable_id);
     }
@@ -88,8 +99,9 @@ bool QuadDefense::step_autonomy(double t, double dt)
             return true;
         }
     }
-    std::vector<sc::ID> friends;
-    rtree_->nearest_n_neighbors(state_->pos_const(), friends, 1, parent_.lock()->id().id(), parent_.lock()->id().team_id());
+    std::vector<sc::ID> friend_storage;
+    sc::IDSlice friends = rtree_->nearest_neighbors(
+        state_->pos_const(), parent_.lock()->id().id(), 1, friend_storage, parent_.lock()->id().team_id());
     if(!friends.empty()){
         int id = friends.front().id();
         sc::State &tgt_state = *contacts_->at(id).state();
@@ -12,6 +12,7 @@ class QuadDefense : public scrimmage::Autonomy{
 public:
      QuadDefense();
      virtual void init(std::map<std::string,std::string> &params);
+     virtual bool reset(std::map<std::string,std::string> &params);
      virtual bool step_autonomy(double t, double dt);
 protected:     
      double x_offset_;
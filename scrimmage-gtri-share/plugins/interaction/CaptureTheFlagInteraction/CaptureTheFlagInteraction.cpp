@@ -26,7 +26,11 @@
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/LocalCartesian.hpp>
 
+#include <scrimmage/common/Arena.h>
 #include <scrimmage/common/RTree.h>
+#include <scrimmage/common/EngagementGeometry.h>
+#include <scrimmage/simcontrol/EntityIndex.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 #include <scrimmage/autonomy/Autonomy.h>
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/common/Random.h>
@@ -112,7 +116,7 @@ bool CaptureTheFlagInteraction::create_cube(std::string cube_name,
         };
 
         for (int f = 0; f < num_faces; f++) {
-            sc::ShapePtr shape(new sp::Shape);
+            sc::ShapePtr shape = network_->arena()->make_shared<sp::Shape>();
             shape->set_type(sp::Shape::Polygon);
             shape->set_opacity(0.2);
             sc::set(shape->mutable_color(), color[0], color[1], color[2]);
@@ -130,6 +134,24 @@ bool CaptureTheFlagInteraction::create_cube(std::string cube_name,
 bool CaptureTheFlagInteraction::init(std::map<std::string,std::string> &mission_params,
                                      std::map<std::string,std::string> &plugin_params)
 {
+    // Setup subscribers
+    sub_fire_ = create_subscriber("Fire");
+    sub_ent_pres_end_ = create_subscriber("EntityPresentAtEnd");
+
+    // Setup publishers
+    pub_base_coll_ = create_publisher("BaseCollision");
+    pub_fire_result_ = create_publisher("FireResult");
+    pub_distancefrombase_ = create_publisher("DistanceFromBase");
+
+    return reset(mission_params, plugin_params);
+}
+
+bool CaptureTheFlagInteraction::reset(std::map<std::string,std::string> &mission_params,
+                                      std::map<std::string,std::string> &plugin_params)
+{
+    prev_fire_.clear();
+    num_fires_.clear();
+
     base_collision_range_ = sc::get("base_collision_range", plugin_params, 0.0);
 
     double fire_rate = sc::get("fire_rate_max", plugin_params, -1);
@@ -177,15 +199,6 @@ bool CaptureTheFlagInteraction::init(std::map<std::string,std::string> &mission_
     if (!create_cube("red_defense_cube", plugin_params,
                      Eigen::Vector3d(255,0,0))) return false;
 
-    // Setup subscribers
-    sub_fire_ = create_subscriber("Fire");
-    sub_ent_pres_end_ = create_subscriber("EntityPresentAtEnd");
-
-    // Setup publishers
-    pub_base_coll_ = create_publisher("BaseCollision");
-    pub_fire_result_ = create_publisher("FireResult");
-    pub_distancefrombase_ = create_publisher("DistanceFromBase");
-
     return true;
 }
 
@@ -198,11 +211,6 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
         return true;
     }
 
-    std::map<int, sc::EntityPtr> int_to_ent_map;
-    for (sc::EntityPtr &ent : ents) {
-        int_to_ent_map[ent->id().id()] = ent;
-    }
-
     // Account for aircraft colliding with bases
     if (ents.front()->autonomies().empty()) {
         cout << "CaptureTheFlagInteraction:  cannot get autonomy" << endl;
@@ -220,11 +228,11 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
 
                 for (sc::ID &id : neighbors) {
 //                    std::cout << id.id() << " has hit base " << base_team_id << std::endl;
-                    if(int_to_ent_map.count(id.id())){
-                        sc::EntityPtr &ent = int_to_ent_map[id.id()];
+                    if(entity_index_->count(id.id())){
+                        const sc::EntityPtr &ent = entity_index_->at(id.id());
                         ent->collision();
 
-                        auto msg = std::make_shared<sc::Message<sgs::BaseCollision>>();
+                        auto msg = network_->arena()->make_shared<sc::Message<sgs::BaseCollision>>();
                         msg->data.set_entity_id(id.id());
                         msg->data.set_base_id(base_team_id);
                         if (base_team_id == id.team_id()) {
@@ -240,19 +248,19 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
     }
 
     for (auto msg : sub_ent_pres_end_->pop_msgs<sc::Message<sm::EntityPresentAtEnd>>()) {
-        for (sc::EntityPtr &ent : ents) {
-            if (ent->id().id() == msg->data.entity_id()){
-                for (auto &kv : mp_->team_info()) {
-                    int base_team_id = kv.first;
-                    if(base_team_id != ent->id().team_id()){
-                        for(Eigen::Vector3d &base_pos : kv.second.bases){
-                            auto msg = std::make_shared<sc::Message<sgs::DistanceFromBase>>();
-                            msg->data.set_entity_id(ent->id().id());
-                            msg->data.set_base_id(base_team_id);
-                            msg->data.set_distance((base_pos-ent->state()->pos()).norm());
-                            publish_immediate(t, pub_distancefrombase_, msg);
-                        }
-                    }
+        const sc::EntityPtr &ent = entity_index_->at(msg->data.entity_id());
+        if (ent == nullptr) {
+            continue;
+        }
+        for (auto &kv : mp_->team_info()) {
+            int base_team_id = kv.first;
+            if(base_team_id != ent->id().team_id()){
+                for(Eigen::Vector3d &base_pos : kv.second.bases){
+                    auto msg = network_->arena()->make_shared<sc::Message<sgs::DistanceFromBase>>();
+                    msg->data.set_entity_id(ent->id().id());
+                    msg->data.set_base_id(base_team_id);
+                    msg->data.set_distance((base_pos-ent->state()->pos()).norm());
+                    publish_immediate(t, pub_distancefrombase_, msg);
                 }
             }
         }
@@ -295,25 +303,22 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
         }
 
         int target_id = msg->data.target_id();
-        auto it_target_ent = int_to_ent_map.find(target_id);
-        if (it_target_ent == int_to_ent_map.end()) {
+        const sc::EntityPtr &target_ent = entity_index_->at(target_id);
+        if (target_ent == nullptr) {
             continue;
         }
 
-        sc::EntityPtr &target_ent = it_target_ent->second;
-
         int src_team_id = (*team_lookup_)[src_id];
         bool is_friendly = target_ent->id().team_id() == src_team_id;
 
-        auto it_src_ent = int_to_ent_map.find(src_id);
-        if (it_src_ent == int_to_ent_map.end()) {
+        const sc::EntityPtr &src_ent = entity_index_->at(src_id);
+        if (src_ent == nullptr) {
             std::cout << "Warning: couldn't find source id in map" << std::endl;
             continue;
         }
-        sc::EntityPtr &src_ent = it_src_ent->second;
 
         // Add a line between the two to show the fire event
-        sc::ShapePtr attempt_shape(new sp::Shape());
+        sc::ShapePtr attempt_shape = network_->arena()->make_shared<sp::Shape>();
         attempt_shape->set_type(sp::Shape::Line);
         sc::set(attempt_shape->mutable_color(), 255,255,255);
         attempt_shape->set_opacity(1.0);
@@ -327,13 +332,25 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
 
         double range = diff.norm();
 
+        // Bearings of the target from this tick's engagement geometry, if
+        // it has the pair
+        sc::EngagementGeometryPtr geometry = src_ent->engagement_geometry();
+        sc::Engagement engagement;
+
         if (hit_detection_ == HitDetection::shrinking_cone) {
 
-            Eigen::Vector3d rel_pos = src_ent->state()->rel_pos_local_frame(target_ent->state()->pos());
-            double dist = rel_pos.norm();
-            double dist_xy = rel_pos.head<2>().norm();
-            double az = atan2(rel_pos(1), rel_pos(0));
-            double el = atan2(rel_pos(2), dist_xy);
+            double dist, az, el;
+            if (geometry && geometry->get(src_id, target_id, engagement)) {
+                dist = engagement.range;
+                az = engagement.az;
+                el = engagement.el;
+            } else {
+                Eigen::Vector3d rel_pos = src_ent->state()->rel_pos_local_frame(target_ent->state()->pos());
+                dist = rel_pos.norm();
+                double dist_xy = rel_pos.head<2>().norm();
+                az = atan2(rel_pos(1), rel_pos(0));
+                el = atan2(rel_pos(2), dist_xy);
+            }
 
             if (dist == 0) {
                 is_hit = true;
@@ -353,7 +370,7 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
             double fov_width = (exp(-range/fire_effective_range_) * M_PI);
             double fov_height = fov_width;
 
-            sc::ShapePtr fire_shape(new sp::Shape);
+            sc::ShapePtr fire_shape = network_->arena()->make_shared<sp::Shape>();
             fire_shape->set_type(sp::Shape::Line);
             sc::set(fire_shape->mutable_color(), 0, 0, 255);
             fire_shape->set_opacity(1.0);
@@ -365,8 +382,10 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
                 is_hit = true;
             }
         } else if (hit_detection_ == HitDetection::cone) {
-            if (range <= fire_range_max_ &&
-                src_ent->state()->InFieldOfView(*target_ent->state(), fire_fov_width_, fire_fov_height_)) {
+            bool in_fov = geometry && geometry->get(src_id, target_id, engagement) ?
+                engagement.in_field_of_view(fire_fov_width_, fire_fov_height_) :
+                src_ent->state()->InFieldOfView(*target_ent->state(), fire_fov_width_, fire_fov_height_);
+            if (range <= fire_range_max_ && in_fov) {
                 is_hit = true;
             }
         } else if (hit_detection_ == HitDetection::acs) {
@@ -415,7 +434,7 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
         }
 
         if (is_hit) {
-            sc::ShapePtr hit_shape(new sp::Shape);
+            sc::ShapePtr hit_shape = network_->arena()->make_shared<sp::Shape>();
             hit_shape->set_type(sp::Shape::Line);
             sc::set(hit_shape->mutable_color(), 255, 0, 0);
             hit_shape->set_opacity(1.0);
@@ -427,7 +446,7 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
             bool is_alive_before = target_ent->is_alive();
             target_ent->hit();
 
-            auto hit_msg = std::make_shared<sc::Message<sgs::FireResult>>();
+            auto hit_msg = network_->arena()->make_shared<sc::Message<sgs::FireResult>>();
             hit_msg->data.set_source_id(src_id);
             hit_msg->data.set_target_id(target_id);
             if (is_friendly) {
@@ -438,7 +457,7 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
             publish_immediate(t, pub_fire_result_, hit_msg);
 
             if (is_alive_before && !(target_ent->is_alive())) {
-                auto kill_msg = std::make_shared<sc::Message<sgs::FireResult>>();
+                auto kill_msg = network_->arena()->make_shared<sc::Message<sgs::FireResult>>();
                 kill_msg->data.set_source_id(src_id);
                 kill_msg->data.set_target_id(target_id);
                 if (is_friendly) {
@@ -449,7 +468,7 @@ bool CaptureTheFlagInteraction::step_entity_interaction(std::list<sc::EntityPtr>
                 publish_immediate(t, pub_fire_result_, kill_msg);
             }
         } else {
-            auto miss_msg = std::make_shared<sc::Message<sgs::FireResult>>();
+            auto miss_msg = network_->arena()->make_shared<sc::Message<sgs::FireResult>>();
             miss_msg->data.set_source_id(src_id);
             miss_msg->data.set_target_id(target_id);
             if (is_friendly) {
@@ -471,3 +490,19 @@ bool CaptureTheFlagInteraction::collision_exists(std::list<sc::EntityPtr> &ents,
     // mission.xml file to get startup collisions
     return false;
 }
+
+void CaptureTheFlagInteraction::save_state(sc::Snapshot &snapshot, const std::string &prefix)
+{
+    sc::EntityInteraction::save_state(snapshot, prefix);
+    snapshot.set(prefix + "/prev_fire", prev_fire_);
+    snapshot.set(prefix + "/num_fires", num_fires_);
+}
+
+bool CaptureTheFlagInteraction::restore_state(const sc::Snapshot &snapshot, const std::string &prefix)
+{
+    if (!snapshot.get(prefix + "/prev_fire", prev_fire_) ||
+        !snapshot.get(prefix + "/num_fires", num_fires_)) {
+        return false;
+    }
+    return sc::EntityInteraction::restore_state(snapshot, prefix);
+}
@@ -25,12 +25,16 @@ public:
     CaptureTheFlagInteraction();
     virtual bool init(std::map<std::string,std::string> &mission_params,
                       std::map<std::string,std::string> &plugin_params);
+    virtual bool reset(std::map<std::string,std::string> &mission_params,
+                       std::map<std::string,std::string> &plugin_params);
     
     virtual bool step_entity_interaction(std::list<sc::EntityPtr> &ents, 
                                          double t, double dt);
     
     virtual bool collision_exists(std::list<sc::EntityPtr> &ents,
                                   Eigen::Vector3d &p);
+    virtual void save_state(sc::Snapshot &snapshot, const std::string &prefix);
+    virtual bool restore_state(const sc::Snapshot &snapshot, const std::string &prefix);
 protected:
     
     bool create_cube(std::string cube_name, 
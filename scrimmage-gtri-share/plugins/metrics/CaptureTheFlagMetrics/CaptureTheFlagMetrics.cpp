@@ -33,6 +33,7 @@
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/pubsub/Subscriber.h>
 #include <scrimmage/plugin_manager/RegisterPlugin.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 
 #include "CaptureTheFlagMetrics.h"
 
@@ -60,6 +61,17 @@ void CaptureTheFlagMetrics::init(std::map<std::string,std::string> &params)
 
 }
 
+bool CaptureTheFlagMetrics::reset(std::map<std::string,std::string> &params)
+{
+    params_ = params;
+    scores_.clear();
+    ctf_scores_.clear();
+    team_metrics_.clear();
+    team_scores_.clear();
+    headers_.clear();
+    return true;
+}
+
 bool CaptureTheFlagMetrics::step_metrics(double t, double dt)
 {    
     for (auto msg : sub_base_coll_->pop_msgs<sc::Message<sgs::BaseCollision>>()) {
@@ -127,3 +139,15 @@ void CaptureTheFlagMetrics::calc_team_scores() {
     headers_.push_back("enemy_base_coll");
     headers_.push_back("distance_from_base");
 }
+
+void CaptureTheFlagMetrics::save_state(sc::Snapshot &snapshot, const std::string &prefix)
+{
+    sc::Metrics::save_state(snapshot, prefix);
+    snapshot.set(prefix + "/scores", scores_);
+}
+
+bool CaptureTheFlagMetrics::restore_state(const sc::Snapshot &snapshot, const std::string &prefix)
+{
+    if (!snapshot.get(prefix + "/scores", scores_)) return false;
+    return sc::Metrics::restore_state(snapshot, prefix);
+}
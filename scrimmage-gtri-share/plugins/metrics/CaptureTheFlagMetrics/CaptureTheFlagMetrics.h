@@ -41,10 +41,13 @@ class CaptureTheFlagMetrics : public scrimmage::Metrics {
 
     virtual std::string name() { return std::string("CaptureTheFlagMetrics"); }
     virtual void init(std::map<std::string,std::string> &params);
+    virtual bool reset(std::map<std::string,std::string> &params);
     virtual bool step_metrics(double t, double dt);
     virtual void calc_team_scores();
     virtual void print_team_summaries();    
     std::map<int, CaptureTheFlagScore> &scores() {return scores_;}
+    virtual void save_state(scrimmage::Snapshot &snapshot, const std::string &prefix);
+    virtual bool restore_state(const scrimmage::Snapshot &snapshot, const std::string &prefix);
     
 protected:
     std::map<std::string,std::string> params_;
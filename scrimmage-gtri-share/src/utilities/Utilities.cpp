@@ -23,8 +23,18 @@ namespace scrimmage_gtri_share {
 bool find_hitable(sc::StatePtr &own_state, sc::ID &own_id,
                   sc::ContactMapPtr contacts, int &hitable_id,
                   double dist_thresh, double az_thresh, double el_thresh,
-                  bool use_2d)
+                  bool use_2d, sc::EngagementGeometryPtr geometry)
 {
+    // The cached geometry is 3D and holds every entity within its max
+    // range, so only the targets in the row can be hit
+    if (geometry && !use_2d && dist_thresh <= geometry->max_range()) {
+        const sc::EngagementRow *row = geometry->row(own_id.id());
+        if (row != nullptr) {
+            return find_hitable(*row, own_id, contacts, hitable_id,
+                                dist_thresh, az_thresh, el_thresh);
+        }
+    }
+
     for (auto &kv : *contacts) {
         sc::Contact &cnt = kv.second;
 
@@ -44,6 +54,37 @@ bool find_hitable(sc::StatePtr &own_state, sc::ID &own_id,
     return false;
 }
 
+bool find_hitable(const sc::EngagementRow &row, sc::ID &own_id,
+                  sc::ContactMapPtr contacts, int &hitable_id,
+                  double dist_thresh, double az_thresh, double el_thresh)
+{
+    auto hitable = [&](const sc::Engagement &e) {
+        if (e.range > dist_thresh ||
+            !e.in_field_of_view(az_thresh, el_thresh)) return false;
+        auto it = contacts->find(e.target_id);
+        return it != contacts->end() &&
+            it->second.id().team_id() != own_id.team_id();
+    };
+
+    int num_hitable = 0;
+    for (const sc::Engagement &e : row) {
+        if (hitable(e)) {
+            hitable_id = e.target_id;
+            num_hitable++;
+        }
+    }
+    if (num_hitable <= 1) return num_hitable == 1;
+
+    // Pick the same target as a search through the contacts would
+    for (auto &kv : *contacts) {
+        const sc::Engagement *e = row.find(kv.first);
+        if (e != nullptr && hitable(*e)) {
+            hitable_id = e->target_id;
+            return true;
+        }
+    }
+    return false;
+}
 
 bool is_hitable(sc::StatePtr &own_state, sc::StatePtr &tgt_state,
                 double dist_thresh, double az_thresh, double el_thresh,
@@ -68,7 +109,7 @@ bool is_hitable(sc::StatePtr &own_state, sc::StatePtr &tgt_state,
 bool publish_fire(double t, sc::PublisherPtr pub, int network_id,
                   int own_id, int tgt_id)
 {
-    auto msg = std::make_shared<sc::Message<Fire>>();
+    auto msg = sc::make_shared_from<sc::Message<Fire>>(pub->arena());
     msg->data.set_source_id(own_id);
     msg->data.set_target_id(tgt_id);
 
@@ -0,0 +1,192 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <scrimmage/autonomy/Autonomy.h>
+#include <scrimmage/common/FileSearch.h>
+#include <scrimmage/common/OpponentPool.h>
+#include <scrimmage/common/Random.h>
+#include <scrimmage/common/RTree.h>
+#include <scrimmage/entity/Contact.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/plugin_manager/PluginManager.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/simcontrol/InferenceBatch.h>
+#include <GeographicLib/LocalCartesian.hpp>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+using namespace tiny_dnn;
+using namespace tiny_dnn::layers;
+
+class CaptureTheFlagLearnTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        std::string dir = SCRIMMAGE_GTRI_SHARE_DIR;
+        std::string plugin_path = dir + "/plugin_libs:" + dir + "/plugins";
+        const char *env = std::getenv("SCRIMMAGE_PLUGIN_PATH");
+        if (env != nullptr) plugin_path += std::string(":") + env;
+        setenv("SCRIMMAGE_PLUGIN_PATH", plugin_path.c_str(), 1);
+
+        // 9 own states, 8 for the bases, 10 per friend and 7 per enemy
+        network<sequential> net;
+        net << fc(34, 200) << activation::tanh()
+            << fc(200, 200) << activation::tanh()
+            << fc(200, 50) << activation::tanh()
+            << fc(50, 3) << activation::tanh();
+        net.weight_init(weight_init::lecun());
+        net.bias_init(weight_init::lecun());
+        net.init_weight();
+
+        char name[] = "/tmp/test_capture_the_flag_learn_XXXXXX";
+        close(mkstemp(name));
+        nn_path = name;
+        net.save(nn_path);
+
+        opponent = std::make_shared<sc::Opponent>(0, nn_path);
+        ASSERT_TRUE(opponent->load());
+
+        mp = std::make_shared<sc::MissionParse>();
+        mp->params()["seed"] = "1";
+        mp->team_info()[1].bases.push_back(Eigen::Vector3d(-1000, 0, 0));
+        mp->team_info()[2].bases.push_back(Eigen::Vector3d(1000, 0, 0));
+
+        rtree->init(2);
+        random->seed(1);
+    }
+
+    void TearDown() override {
+        std::remove(nn_path.c_str());
+    }
+
+    // An aircraft of team 2 with sigma = 0, one friend and one enemy as
+    // the network's inputs. trained_team is the team the learner trains,
+    // the other team plays the league opponent.
+    sc::EntityPtr make_entity(int id, int trained_team, double y = 100) {
+        std::map<std::string, std::string> info = {
+            {"team_id", "2"}, {"x", "500"}, {"y", std::to_string(y)}, {"z", "300"},
+            {"heading", "180"}, {"autonomy0", "CaptureTheFlagLearn"}};
+
+        sc::EntityPtr ent = std::make_shared<sc::Entity>();
+        ent->set_random(random);
+        ent->set_parameter_vector({0, 1, 1, 0, 0, 0, 0, static_cast<double>(trained_team)});
+        ent->set_nn_path(nn_path);
+        ent->set_opponent(opponent);
+
+        sc::AttributeMap overrides;
+        if (!ent->init(overrides, info, contacts, mp, proj, id, 1,
+                       plugin_manager, pubsub, file_search, rtree)) {
+            return nullptr;
+        }
+        return ent;
+    }
+
+    std::string nn_path;
+    sc::OpponentPtr opponent;
+    sc::MissionParsePtr mp;
+    sc::ContactMapPtr contacts = std::make_shared<sc::ContactMap>();
+    std::shared_ptr<GeographicLib::LocalCartesian> proj =
+        std::make_shared<GeographicLib::LocalCartesian>();
+    sc::PluginManagerPtr plugin_manager = std::make_shared<sc::PluginManager>();
+    sc::NetworkPtr pubsub = std::make_shared<sc::Network>();
+    sc::FileSearch file_search;
+    sc::RTreePtr rtree = std::make_shared<sc::RTree>();
+    sc::RandomPtr random = std::make_shared<sc::Random>();
+};
+
+TEST_F(CaptureTheFlagLearnTest, league_opponent_steps)
+{
+    // The league opponent only copies the policy compiled from the
+    // opponent's network, the trained team loads the same network itself.
+    sc::EntityPtr league = make_entity(1, 1);
+    sc::EntityPtr trained = make_entity(2, 2);
+    ASSERT_NE(league, nullptr);
+    ASSERT_NE(trained, nullptr);
+
+    sc::AutonomyPtr &league_autonomy = league->autonomies().front();
+    sc::AutonomyPtr &trained_autonomy = trained->autonomies().front();
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(league_autonomy->step_autonomy(i * 0.1, 0.1));
+        ASSERT_TRUE(trained_autonomy->step_autonomy(i * 0.1, 0.1));
+
+        // Both see the same inputs and, unperturbed, act the same
+        sc::State &a = *league_autonomy->desired_state();
+        sc::State &b = *trained_autonomy->desired_state();
+        EXPECT_DOUBLE_EQ(a.quat().yaw(), b.quat().yaw());
+        EXPECT_DOUBLE_EQ(a.pos()(2), b.pos()(2));
+        EXPECT_DOUBLE_EQ(a.vel()(0), b.vel()(0));
+    }
+
+    // and the action comes from the policy
+    EXPECT_NE(league_autonomy->desired_state()->pos()(2), 300);
+}
+
+TEST_F(CaptureTheFlagLearnTest, batched_forward_pass)
+{
+    // Unbatched reference actions of three league opponents, far enough
+    // apart that none of them evades another
+    std::vector<sc::State> expected;
+    for (int i = 0; i < 3; i++) {
+        sc::EntityPtr ent = make_entity(i + 1, 2, 100 + 300 * i);
+        ASSERT_NE(ent, nullptr);
+        ASSERT_TRUE(ent->autonomies().front()->step_autonomy(0, 0.1));
+        expected.push_back(*ent->autonomies().front()->desired_state());
+    }
+
+    // The same entities with a batch only act once it runs, and then
+    // exactly like the unbatched ones
+    sc::InferenceBatchPtr batch = std::make_shared<sc::InferenceBatch>();
+    std::vector<sc::EntityPtr> ents;
+    for (int i = 0; i < 3; i++) {
+        ents.push_back(make_entity(i + 11, 2, 100 + 300 * i));
+        ASSERT_NE(ents.back(), nullptr);
+        ents.back()->set_inference_batch(batch);
+        ASSERT_TRUE(ents.back()->autonomies().front()->step_autonomy(0, 0.1));
+    }
+    EXPECT_EQ(ents[0]->autonomies().front()->desired_state()->pos()(2), 300);
+
+    batch->run();
+    for (int i = 0; i < 3; i++) {
+        sc::State &state = *ents[i]->autonomies().front()->desired_state();
+        EXPECT_EQ(state.quat().yaw(), expected[i].quat().yaw());
+        EXPECT_EQ(state.pos(), expected[i].pos());
+        EXPECT_EQ(state.vel(), expected[i].vel());
+    }
+}
@@ -0,0 +1,79 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <list>
+#include <memory>
+
+#include <scrimmage/common/Arena.h>
+#include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/NetworkDevice.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+struct Fire {
+    int source_id;
+    int target_id;
+};
+} // namespace
+
+// One time step of a rollout: range(0) messages published, queued for a
+// subscriber and dropped. Each thread is a rollout of its own.
+static void BM_heap_messages(benchmark::State &state)
+{
+    sc::MessageList queue;
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            auto msg = std::make_shared<sc::Message<Fire>>();
+            msg->data.source_id = i;
+            queue.push_back(msg);
+        }
+        benchmark::DoNotOptimize(queue.back());
+        queue.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_heap_messages)->Arg(64)->Arg(1024)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_arena_messages(benchmark::State &state)
+{
+    sc::ArenaPtr arena = sc::Arena::create();
+    sc::MessageList queue(sc::ArenaAllocator<sc::MessageBasePtr>{arena.get()});
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            auto msg = arena->make_shared<sc::Message<Fire>>();
+            msg->data.source_id = i;
+            queue.push_back(msg);
+        }
+        benchmark::DoNotOptimize(queue.back());
+        queue.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_arena_messages)->Arg(64)->Arg(1024)->ThreadRange(1, 8)->UseRealTime();
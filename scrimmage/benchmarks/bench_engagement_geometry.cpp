@@ -0,0 +1,118 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <scrimmage/common/EngagementGeometry.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+const double fire_range = 100;
+const double fire_fov = 0.5;
+const double max_range = 100;
+
+// Two teams spread over a capture the flag sized field
+std::list<sc::EntityPtr> make_entities(size_t n)
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> xy(-500, 500), z(50, 200);
+    std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+    std::list<sc::EntityPtr> ents;
+    for (size_t i = 0; i < n; i++) {
+        sc::EntityPtr ent = std::make_shared<sc::Entity>();
+        sc::ID id(i, 0, i < n / 2 ? 1 : 2);
+        ent->set_id(id);
+        ent->state()->pos() << xy(gen), xy(gen), z(gen);
+        ent->state()->quat().set(0, 0, yaw(gen));
+        ents.push_back(ent);
+    }
+    return ents;
+}
+} // namespace
+
+// Every entity checking every enemy for a shot the way is_hitable did
+static void BM_direct_fire_check(benchmark::State &state)
+{
+    std::list<sc::EntityPtr> ents = make_entities(state.range(0));
+    for (auto _ : state) {
+        int hitable = 0;
+        for (sc::EntityPtr &src : ents) {
+            for (sc::EntityPtr &tgt : ents) {
+                if (tgt->id().team_id() == src->id().team_id()) continue;
+                sc::State tgt_state = *tgt->state();
+                double dist = (tgt_state.pos() - src->state()->pos()).norm();
+                if (dist <= fire_range &&
+                    src->state()->InFieldOfView(tgt_state, fire_fov, fire_fov)) {
+                    hitable++;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(hitable);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_direct_fire_check)->Range(16, 1024);
+
+// The same checks over the rows of the engagement geometry, including its
+// update, the way find_hitable uses them
+static void BM_cached_fire_check(benchmark::State &state)
+{
+    std::list<sc::EntityPtr> ents = make_entities(state.range(0));
+    std::vector<int> team_ids(state.range(0));
+    for (sc::EntityPtr &ent : ents) {
+        team_ids[ent->id().id()] = ent->id().team_id();
+    }
+
+    sc::EngagementGeometry geometry;
+    geometry.set_max_range(max_range);
+    for (auto _ : state) {
+        geometry.update(ents);
+        int hitable = 0;
+        for (sc::EntityPtr &src : ents) {
+            const sc::EngagementRow *row = geometry.row(src->id().id());
+            for (const sc::Engagement &e : *row) {
+                if (e.range <= fire_range &&
+                    e.in_field_of_view(fire_fov, fire_fov) &&
+                    team_ids[e.target_id] != src->id().team_id()) {
+                    hitable++;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(hitable);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_cached_fire_check)->Range(16, 1024);
@@ -0,0 +1,123 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <scrimmage/math/FastMath.h>
+
+#include <benchmark/benchmark.h>
+
+namespace fm = scrimmage::fast_math;
+
+namespace {
+std::vector<double> make_angles(size_t n, double range)
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-range, range);
+    std::vector<double> x(n);
+    for (double &v : x) v = dist(gen);
+    return x;
+}
+} // namespace
+
+static void BM_sin_libm(benchmark::State &state)
+{
+    std::vector<double> x = make_angles(state.range(0), M_PI);
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < x.size(); i++) out[i] = std::sin(x[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_sin_libm)->Range(64, 4096);
+
+static void BM_sin_fast(benchmark::State &state)
+{
+    std::vector<double> x = make_angles(state.range(0), M_PI);
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        fm::sin(x.data(), out.data(), x.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_sin_fast)->Range(64, 4096);
+
+static void BM_atan2_libm(benchmark::State &state)
+{
+    std::vector<double> y = make_angles(state.range(0), 500);
+    std::vector<double> x = make_angles(state.range(0) + 1, 500);
+    std::vector<double> out(y.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < y.size(); i++) out[i] = std::atan2(y[i], x[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_atan2_libm)->Range(64, 4096);
+
+static void BM_atan2_fast(benchmark::State &state)
+{
+    std::vector<double> y = make_angles(state.range(0), 500);
+    std::vector<double> x = make_angles(state.range(0) + 1, 500);
+    std::vector<double> out(y.size());
+    for (auto _ : state) {
+        fm::atan2(y.data(), x.data(), out.data(), y.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_atan2_fast)->Range(64, 4096);
+
+// The activations of a 200 wide layer
+static void BM_tanh_libm(benchmark::State &state)
+{
+    std::vector<double> d = make_angles(state.range(0), 3);
+    std::vector<float> x(d.begin(), d.end()), out(x.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < x.size(); i++) out[i] = std::tanh(x[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_tanh_libm)->Arg(200);
+
+static void BM_tanh_fast(benchmark::State &state)
+{
+    std::vector<double> d = make_angles(state.range(0), 3);
+    std::vector<float> x(d.begin(), d.end()), out(x.size());
+    for (auto _ : state) {
+        fm::tanh(x.data(), out.data(), x.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_tanh_fast)->Arg(200);
@@ -0,0 +1,111 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <scrimmage/common/FitnessShaping.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+// Scores with ties, like the integer-valued capture the flag scores
+std::vector<double> make_scores(size_t n)
+{
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(0, 50);
+    std::vector<double> scores(n);
+    for (double &s : scores) s = dist(gen);
+    return scores;
+}
+
+// The rank transform that was inlined in scrimmage-learn
+std::vector<double> original_rank_transform(const std::vector<double> &scores)
+{
+    size_t num_threads = scores.size();
+    std::vector<double> rank(scores.size());
+    std::vector<double> rank_scores(scores.size());
+    std::size_t m(0);
+    std::generate(std::begin(rank), std::end(rank), [&]{ return m++; });
+    std::sort(std::begin(rank), std::end(rank), [&](double i1, double i2) { return scores[i1] < scores[i2]; });
+
+    size_t num_similar = 0;
+    double last_value = scores[rank[0]];
+    rank_scores[rank[0]] = 0.0;
+    for (size_t i = 1; i < num_threads; i++) {
+        if (last_value == scores[rank[i]]) num_similar++;
+        rank_scores[rank[i]] = (double) (i - num_similar);
+        last_value = scores[rank[i]];
+    }
+    for (size_t i = 0; i < num_threads; i++)
+        rank_scores[i] = (double)(rank_scores[i] + 1) / (double)(m - num_similar) - 0.5;
+    return rank_scores;
+}
+} // namespace
+
+static void BM_original_rank_transform(benchmark::State &state)
+{
+    std::vector<double> scores = make_scores(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(original_rank_transform(scores));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_original_rank_transform)->Range(300, 300000);
+
+static void BM_centered_ranks(benchmark::State &state)
+{
+    std::vector<double> scores = make_scores(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sc::centered_ranks(scores));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_centered_ranks)->Range(300, 300000);
+
+static void BM_utility_weights(benchmark::State &state)
+{
+    std::vector<double> scores = make_scores(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sc::utility_weights(scores));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_utility_weights)->Range(300, 300000);
+
+static void BM_elite_weights(benchmark::State &state)
+{
+    std::vector<double> scores = make_scores(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sc::elite_weights(scores, 0.2));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_elite_weights)->Range(300, 300000);
@@ -0,0 +1,68 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <random>
+#include <vector>
+
+#include <scrimmage/math/State.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+const size_t num_states = 1024;
+
+std::vector<sc::State> make_states()
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> xy(-500, 500), z(50, 200);
+    std::uniform_real_distribution<double> angle(-0.3, 0.3), yaw(-M_PI, M_PI);
+    std::vector<sc::State> states(num_states);
+    for (sc::State &state : states) {
+        state.pos() << xy(gen), xy(gen), z(gen);
+        state.quat().set(angle(gen), angle(gen), yaw(gen));
+    }
+    return states;
+}
+} // namespace
+
+// Each state checking the next one, with the capture the flag fire cone
+static void BM_in_field_of_view(benchmark::State &state)
+{
+    std::vector<sc::State> states = make_states();
+    for (auto _ : state) {
+        int visible = 0;
+        for (size_t i = 0; i < states.size(); i++) {
+            sc::State &other = states[(i + 1) % states.size()];
+            visible += states[i].InFieldOfView(other, 0.5, 0.5);
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+BENCHMARK(BM_in_field_of_view);
@@ -0,0 +1,147 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+#include <scrimmage/log/Log.h>
+#include <scrimmage/network/Interface.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/simcontrol/SimControl.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+// Two teams of aircraft starting 1 km apart and flying at each other, the
+// layout of capture the flag with the core plugins: Straight, SimpleAircraft
+// and SimpleCollision. Returns the name of the mission file.
+std::string write_mission(int count)
+{
+    char name[] = "/tmp/bench_mission_XXXXXX";
+    close(mkstemp(name));
+    std::ofstream file(name);
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<runscript name=\"bench_mission\">\n"
+         << "  <run start=\"0.0\" end=\"10\" dt=\"0.1\" time_warp=\"0\"\n"
+         << "       enable_gui=\"false\" network_gui=\"false\" start_paused=\"false\"/>\n"
+         << "  <end_condition>time</end_condition>\n"
+         << "  <grid_spacing>10</grid_spacing>\n"
+         << "  <grid_size>1000</grid_size>\n"
+         << "  <output_type>summary</output_type>\n"
+         << "  <show_plugins>false</show_plugins>\n"
+         << "  <metrics order=\"0\">SimpleCollisionMetrics</metrics>\n"
+         << "  <entity_interaction order=\"0\">SimpleCollision</entity_interaction>\n"
+         << "  <latitude_origin>35.721025</latitude_origin>\n"
+         << "  <longitude_origin>-120.767925</longitude_origin>\n"
+         << "  <altitude_origin>300</altitude_origin>\n"
+         << "  <seed>1</seed>\n";
+
+    // enough room that the spawn positions don't take long to find
+    double variance = 50 * std::sqrt(count);
+    for (int team = 1; team <= 2; team++) {
+        file << "  <entity>\n"
+             << "    <team_id>" << team << "</team_id>\n"
+             << "    <color>" << (team == 1 ? "77 77 255" : "255 0 0") << "</color>\n"
+             << "    <count>" << count / 2 << "</count>\n"
+             << "    <health>1</health>\n"
+             << "    <variance_x>" << variance << "</variance_x>\n"
+             << "    <variance_y>" << variance << "</variance_y>\n"
+             << "    <variance_z>10</variance_z>\n"
+             << "    <x>" << (team == 1 ? -500 : 500) << "</x>\n"
+             << "    <y>0</y>\n"
+             << "    <z>200</z>\n"
+             << "    <heading>" << (team == 1 ? 0 : 180) << "</heading>\n"
+             << "    <controller>SimpleAircraftControllerPID</controller>\n"
+             << "    <motion_model>SimpleAircraft</motion_model>\n"
+             << "    <autonomy>Straight</autonomy>\n"
+             << "  </entity>\n";
+    }
+    file << "</runscript>\n";
+    return name;
+}
+
+bool setup(sc::SimControl &sim, sc::MissionParsePtr mp)
+{
+    std::shared_ptr<sc::Log> log = std::make_shared<sc::Log>();
+    log->set_enable_log(false);
+    log->init(mp->log_dir(), sc::Log::NONE);
+    sim.set_log(log);
+
+    sc::InterfacePtr to_gui_interface = std::make_shared<sc::Interface>();
+    sc::InterfacePtr from_gui_interface = std::make_shared<sc::Interface>();
+    to_gui_interface->set_log(log);
+    from_gui_interface->set_log(log);
+    sim.set_incoming_interface(from_gui_interface);
+    sim.set_outgoing_interface(to_gui_interface);
+
+    sim.set_mission_parse(mp);
+    if (!sim.init()) return false;
+    sim.display_progress(false);
+    return true;
+}
+} // namespace
+
+// Ticks per second of the whole simulation loop with range(0) aircraft. Only
+// run() is timed, the plugins are loaded from SCRIMMAGE_PLUGIN_PATH.
+static void BM_mission(benchmark::State &state)
+{
+    std::string mission_file = write_mission(state.range(0));
+    sc::MissionParsePtr mission = std::make_shared<sc::MissionParse>();
+    bool parsed = mission->parse(mission_file);
+    std::remove(mission_file.c_str());
+    if (!parsed) {
+        state.SkipWithError("Failed to parse the mission");
+        return;
+    }
+
+    double ticks = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<sc::SimControl> sim(new sc::SimControl());
+        if (!setup(*sim, mission->clone())) {
+            state.SkipWithError("SimControl init() failed");
+            break;
+        }
+        state.ResumeTiming();
+
+        sim->run();
+
+        state.PauseTiming();
+        ticks += std::round((sim->t() - mission->t0()) / mission->dt());
+        sim = nullptr;
+        state.ResumeTiming();
+    }
+    state.counters["ticks_per_second"] = benchmark::Counter(ticks, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_mission)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,107 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <map>
+#include <memory>
+#include <string>
+
+#include <scrimmage/autonomy/Autonomy.h>
+#include <scrimmage/common/FileSearch.h>
+#include <scrimmage/common/Random.h>
+#include <scrimmage/common/RTree.h>
+#include <scrimmage/entity/Contact.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/motion/Controller.h>
+#include <scrimmage/motion/MotionModel.h>
+#include <scrimmage/plugin_manager/PluginManager.h>
+#include <scrimmage/pubsub/Network.h>
+#include <GeographicLib/LocalCartesian.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+// A tick of one entity's controller and motion model with the plugins'
+// default parameters, the autonomy (Straight) only setting the desired state
+// once. The plugins are loaded from SCRIMMAGE_PLUGIN_PATH.
+static void BM_motion_model(benchmark::State &state, const char *motion_model,
+                            const char *controller)
+{
+    std::map<std::string, std::string> info;
+    info["motion_model"] = motion_model;
+    info["controller0"] = controller;
+    info["autonomy0"] = "Straight";
+    info["team_id"] = "1";
+    info["x"] = "0";
+    info["y"] = "0";
+    info["z"] = "100";
+    info["heading"] = "0";
+    info["dt"] = "0.1";
+    info["motion_multiplier"] = "1";
+
+    sc::AttributeMap overrides;
+    sc::ContactMapPtr contacts = std::make_shared<sc::ContactMap>();
+    auto proj = std::make_shared<GeographicLib::LocalCartesian>();
+    sc::PluginManagerPtr plugin_manager = std::make_shared<sc::PluginManager>();
+    sc::NetworkPtr network = std::make_shared<sc::Network>();
+    sc::FileSearch file_search;
+    sc::RTreePtr rtree = std::make_shared<sc::RTree>();
+    rtree->init(1);
+
+    sc::RandomPtr random = std::make_shared<sc::Random>();
+    random->seed(1);
+
+    sc::EntityPtr ent = std::make_shared<sc::Entity>();
+    ent->set_random(random);
+    if (!ent->init(overrides, info, contacts, nullptr, proj, 1, 1,
+                   plugin_manager, network, file_search, rtree)) {
+        state.SkipWithError("Failed to load the plugins");
+        return;
+    }
+
+    double dt = 0.1;
+    double t = 0;
+    for (sc::AutonomyPtr &autonomy : ent->autonomies()) {
+        autonomy->step_autonomy(t, dt);
+    }
+    for (auto _ : state) {
+        for (sc::ControllerPtr &ctrl : ent->controllers()) {
+            ctrl->step(t, dt);
+        }
+        ent->motion()->step(t, dt);
+        t += dt;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_motion_model, SimpleAircraft, "SimpleAircraft", "SimpleAircraftControllerPID");
+BENCHMARK_CAPTURE(BM_motion_model, SimpleQuadrotor, "SimpleQuadrotor", "SimpleQuadrotorControllerLQR");
+BENCHMARK_CAPTURE(BM_motion_model, SimpleCar, "SimpleCar", "SimpleCarControllerHeading");
+BENCHMARK_CAPTURE(BM_motion_model, Unicycle, "Unicycle", "UnicycleControllerPoint");
+BENCHMARK_CAPTURE(BM_motion_model, SingleIntegrator, "SingleIntegrator", "SingleIntegratorControllerSimple");
+BENCHMARK_CAPTURE(BM_motion_model, DoubleIntegrator, "DoubleIntegrator", "DoubleIntegratorControllerWaypoint");
+BENCHMARK_CAPTURE(BM_motion_model, RigidBody6DOF, "RigidBody6DOF", "RigidBody6DOFControllerPID");
+BENCHMARK_CAPTURE(BM_motion_model, FixedWing6DOF, "FixedWing6DOF", "FixedWing6DOFControllerPID");
@@ -0,0 +1,103 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <random>
+#include <vector>
+
+#include <scrimmage/common/ID.h>
+#include <scrimmage/common/RTree.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+// Two teams spread over a capture the flag sized field
+void make_tree(size_t n, unsigned int k, sc::RTree &rtree,
+               std::vector<Eigen::Vector3d> &positions, std::vector<sc::ID> &ids)
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> xy(-500, 500), z(50, 200);
+    positions.resize(n);
+    ids.resize(n);
+    rtree.init(n);
+    rtree.request_neighbors(k);
+    for (size_t i = 0; i < n; i++) {
+        positions[i] << xy(gen), xy(gen), z(gen);
+        ids[i] = sc::ID(i, 0, i < n / 2 ? 1 : 2);
+        rtree.add(positions[i], ids[i]);
+    }
+}
+} // namespace
+
+// What every autonomy plugin did each tick: a friend and an enemy query
+static void BM_per_entity_queries(benchmark::State &state)
+{
+    unsigned int k = 5;
+    sc::RTree rtree;
+    std::vector<Eigen::Vector3d> positions;
+    std::vector<sc::ID> ids;
+    make_tree(state.range(0), k, rtree, positions, ids);
+
+    std::vector<sc::ID> friends, enemies;
+    for (auto _ : state) {
+        for (size_t i = 0; i < ids.size(); i++) {
+            int team_id = ids[i].team_id();
+            rtree.nearest_n_neighbors(positions[i], friends, k, ids[i].id(), team_id);
+            rtree.nearest_n_neighbors(positions[i], enemies, k, ids[i].id(), 3 - team_id);
+            benchmark::DoNotOptimize(friends.data());
+            benchmark::DoNotOptimize(enemies.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_per_entity_queries)->Range(16, 4096);
+
+// The batched pass plus reading the same slices
+static void BM_batched_neighbors(benchmark::State &state)
+{
+    unsigned int k = 5;
+    sc::RTree rtree;
+    std::vector<Eigen::Vector3d> positions;
+    std::vector<sc::ID> ids;
+    make_tree(state.range(0), k, rtree, positions, ids);
+
+    sc::IDSlice friends, enemies;
+    for (auto _ : state) {
+        rtree.compute_neighbors();
+        for (size_t i = 0; i < ids.size(); i++) {
+            int team_id = ids[i].team_id();
+            rtree.nearest_neighbors(ids[i].id(), k, friends, team_id);
+            rtree.nearest_neighbors(ids[i].id(), k, enemies, 3 - team_id);
+            benchmark::DoNotOptimize(friends.begin());
+            benchmark::DoNotOptimize(enemies.begin());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_batched_neighbors)->Range(16, 4096);
@@ -0,0 +1,93 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <memory>
+#include <vector>
+
+#include <scrimmage/autonomy/Autonomy.h>
+#include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/pubsub/Subscriber.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+struct Plugins {
+    sc::NetworkPtr network = std::make_shared<sc::Network>();
+    std::vector<sc::AutonomyPtr> plugins;
+    std::vector<sc::PublisherPtr> pubs;
+    sc::MessageBasePtr msg = std::make_shared<sc::Message<int>>();
+
+    // n plugins publishing on topic, every plugin also subscribing to it
+    // if broadcast, only one other plugin (an interaction) otherwise
+    Plugins(size_t n, bool broadcast) {
+        for (size_t i = 0; i < n; i++) {
+            plugins.push_back(std::make_shared<sc::Autonomy>());
+            plugins.back()->set_network(network);
+            pubs.push_back(plugins.back()->create_publisher("Topic"));
+            if (broadcast) plugins.back()->create_subscriber("Topic");
+        }
+        if (!broadcast) {
+            plugins.push_back(std::make_shared<sc::Autonomy>());
+            plugins.back()->set_network(network);
+            plugins.back()->create_subscriber("Topic");
+        }
+    }
+
+    // one message from every publisher, as in a tick
+    void tick() {
+        for (sc::PublisherPtr &pub : pubs) pub->publish(msg);
+        network->distribute();
+        network->clear_subscriber_msgs();
+    }
+};
+} // namespace
+
+// Every entity reporting to an interaction, e.g. Fire in capture the flag
+static void BM_distribute_to_one(benchmark::State &state)
+{
+    Plugins plugins(state.range(0), false);
+    for (auto _ : state) {
+        plugins.tick();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_distribute_to_one)->Range(16, 4096);
+
+// Every entity hearing every other one
+static void BM_distribute_broadcast(benchmark::State &state)
+{
+    Plugins plugins(state.range(0), true);
+    for (auto _ : state) {
+        plugins.tick();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_distribute_broadcast)->Range(16, 1024);
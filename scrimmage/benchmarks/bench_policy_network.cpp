@@ -0,0 +1,123 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <vector>
+
+#include <scrimmage/math/FixedMLP.h>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+using namespace tiny_dnn;
+using namespace tiny_dnn::layers;
+
+namespace {
+// CaptureTheFlagLearn's policy with 5 friends and 5 enemies, as built by
+// scrimmage-learn
+const size_t num_inputs = 9 + 4 + 4 + 10 * 5 + 7 * 5;
+
+void make_policy(network<sequential> &net)
+{
+    net << fc(num_inputs, 200) << activation::tanh()
+        << fc(200, 200) << activation::tanh()
+        << fc(200, 50) << activation::tanh()
+        << fc(50, 3) << activation::tanh();
+    net.weight_init(weight_init::lecun());
+    net.bias_init(weight_init::lecun());
+    net.init_weight();
+}
+
+vec_t make_input()
+{
+    vec_t in(num_inputs);
+    for (size_t i = 0; i < in.size(); i++) {
+        in[i] = static_cast<float_t>((i % 17) * 0.1 - 0.8);
+    }
+    return in;
+}
+} // namespace
+
+// One action, as every CaptureTheFlagLearn entity does each tick
+static void BM_policy_predict(benchmark::State &state)
+{
+    network<sequential> net;
+    make_policy(net);
+    vec_t in = make_input();
+    for (auto _ : state) {
+        vec_t out = net.predict(in);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_policy_predict);
+
+// The same policy copied into a FixedMLP
+static void BM_policy_predict_fixed_mlp(benchmark::State &state)
+{
+    network<sequential> net;
+    make_policy(net);
+    sc::FixedMLP<200, 200, 50, 3> mlp;
+    if (!mlp.from_network(net)) {
+        state.SkipWithError("FixedMLP doesn't match the policy");
+        return;
+    }
+    vec_t in = make_input();
+    for (auto _ : state) {
+        const vec_t &out = mlp.predict(in);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_policy_predict_fixed_mlp);
+
+// Reading the parameter vector for an update, into a reused buffer
+static void BM_policy_get_weights(benchmark::State &state)
+{
+    network<sequential> net;
+    make_policy(net);
+    vec_t theta;
+    for (auto _ : state) {
+        net.get_weights(theta);
+        benchmark::DoNotOptimize(theta.data());
+    }
+    state.SetBytesProcessed(state.iterations() * net.num_weights() * sizeof(float_t));
+}
+BENCHMARK(BM_policy_get_weights);
+
+static void BM_policy_set_weights(benchmark::State &state)
+{
+    network<sequential> net;
+    make_policy(net);
+    vec_t theta = net.get_weights();
+    for (auto _ : state) {
+        net.set_weights(theta);
+    }
+    state.SetBytesProcessed(state.iterations() * net.num_weights() * sizeof(float_t));
+}
+BENCHMARK(BM_policy_set_weights);
@@ -0,0 +1,116 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <random>
+#include <vector>
+
+#include <scrimmage/common/ID.h>
+#include <scrimmage/common/RTree.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+// Two teams spread over a capture the flag sized field
+void make_entities(size_t n, std::vector<Eigen::Vector3d> &positions,
+                   std::vector<sc::ID> &ids)
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> xy(-500, 500), z(50, 200);
+    positions.resize(n);
+    ids.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        positions[i] << xy(gen), xy(gen), z(gen);
+        ids[i] = sc::ID(i, 0, i < n / 2 ? 1 : 2);
+    }
+}
+
+void make_tree(size_t n, sc::RTree &rtree, std::vector<Eigen::Vector3d> &positions,
+               std::vector<sc::ID> &ids)
+{
+    make_entities(n, positions, ids);
+    rtree.init(n);
+    for (size_t i = 0; i < n; i++) rtree.add(positions[i], ids[i]);
+}
+} // namespace
+
+// Rebuilding the tree, as SimControl does every tick
+static void BM_rtree_insert(benchmark::State &state)
+{
+    std::vector<Eigen::Vector3d> positions;
+    std::vector<sc::ID> ids;
+    make_entities(state.range(0), positions, ids);
+
+    sc::RTree rtree;
+    rtree.init(state.range(0));
+    for (auto _ : state) {
+        rtree.clear();
+        for (size_t i = 0; i < ids.size(); i++) rtree.add(positions[i], ids[i]);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rtree_insert)->Range(16, 4096);
+
+// The 5 nearest neighbors of every entity over all teams
+static void BM_rtree_knn(benchmark::State &state)
+{
+    sc::RTree rtree;
+    std::vector<Eigen::Vector3d> positions;
+    std::vector<sc::ID> ids;
+    make_tree(state.range(0), rtree, positions, ids);
+
+    std::vector<sc::ID> neighbors;
+    for (auto _ : state) {
+        for (size_t i = 0; i < ids.size(); i++) {
+            rtree.nearest_n_neighbors(positions[i], neighbors, 5, ids[i].id());
+            benchmark::DoNotOptimize(neighbors.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rtree_knn)->Range(16, 4096);
+
+// The entities within 100 m of every entity, about the fire range in
+// capture the flag
+static void BM_rtree_range(benchmark::State &state)
+{
+    sc::RTree rtree;
+    std::vector<Eigen::Vector3d> positions;
+    std::vector<sc::ID> ids;
+    make_tree(state.range(0), rtree, positions, ids);
+
+    std::vector<sc::ID> neighbors;
+    for (auto _ : state) {
+        for (size_t i = 0; i < ids.size(); i++) {
+            rtree.neighbors_in_range(positions[i], neighbors, 100, ids[i].id());
+            benchmark::DoNotOptimize(neighbors.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rtree_range)->Range(16, 4096);
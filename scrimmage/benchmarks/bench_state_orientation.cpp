@@ -0,0 +1,146 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <scrimmage/math/State.h>
+
+#include <benchmark/benchmark.h>
+
+namespace sc = scrimmage;
+
+namespace {
+const int num_neighbors = 10;
+const int inputs_per_state = 9;
+
+struct Entities {
+    std::vector<sc::StatePtr> states;
+    std::vector<std::vector<int>> neighbors;
+    std::vector<double> yaw_rate;
+};
+
+// Two teams of aircraft, each observing its nearest friends the way
+// CaptureTheFlagLearn does. Which states are neighbors doesn't matter here.
+Entities make_entities(size_t n)
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> xy(-500, 500), z(50, 200);
+    std::uniform_real_distribution<double> angle(-0.3, 0.3);
+    std::uniform_int_distribution<size_t> other(0, n - 1);
+
+    Entities ents;
+    for (size_t i = 0; i < n; i++) {
+        sc::StatePtr state = std::make_shared<sc::State>();
+        state->pos() << xy(gen), xy(gen), z(gen);
+        state->vel() << 20, 0, 0;
+        state->quat().set(angle(gen), angle(gen), 10 * angle(gen));
+        ents.states.push_back(state);
+        ents.yaw_rate.push_back(angle(gen));
+
+        std::vector<int> neighbors;
+        for (int j = 0; j < num_neighbors; j++) neighbors.push_back(other(gen));
+        ents.neighbors.push_back(neighbors);
+    }
+    return ents;
+}
+
+// Stands in for the motion models, which set every quaternion each tick
+void move(Entities &ents, double dt)
+{
+    for (size_t i = 0; i < ents.states.size(); i++) {
+        sc::Quaternion &quat = ents.states[i]->quat();
+        quat.set(0.1, 0.05, quat.yaw() + ents.yaw_rate[i] * dt);
+    }
+}
+
+template <class GetAngles>
+void observe(Entities &ents, std::vector<double> &in, GetAngles angles)
+{
+    for (size_t i = 0; i < ents.states.size(); i++) {
+        sc::State &own = *ents.states[i];
+        size_t idx = 0;
+        in[idx++] = own.pos()(0);
+        in[idx++] = own.pos()(1);
+        in[idx++] = own.pos()(2);
+        angles(own, &in[idx]);
+        idx += 3;
+        in[idx++] = own.vel()(0);
+        in[idx++] = own.vel()(1);
+        in[idx++] = own.vel()(2);
+
+        for (int id : ents.neighbors[i]) {
+            sc::State &other = *ents.states[id];
+            in[idx++] = other.pos()(0) - own.pos()(0);
+            in[idx++] = other.pos()(1) - own.pos()(1);
+            in[idx++] = other.pos()(2) - own.pos()(2);
+            angles(other, &in[idx]);
+            idx += 3;
+            in[idx++] = other.vel()(0);
+            in[idx++] = other.vel()(1);
+            in[idx++] = other.vel()(2);
+        }
+        benchmark::DoNotOptimize(in.data());
+    }
+}
+} // namespace
+
+// Euler angles from the quaternion on every read, as before
+static void BM_observation_quaternion(benchmark::State &state)
+{
+    Entities ents = make_entities(state.range(0));
+    std::vector<double> in((num_neighbors + 1) * inputs_per_state);
+    for (auto _ : state) {
+        move(ents, 0.1);
+        observe(ents, in, [](sc::State &s, double *out) {
+                out[0] = s.quat().roll();
+                out[1] = s.quat().pitch();
+                out[2] = s.quat().yaw();
+            });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_observation_quaternion)->Range(16, 1024);
+
+// Euler angles from the state's cache
+static void BM_observation_cached(benchmark::State &state)
+{
+    Entities ents = make_entities(state.range(0));
+    std::vector<double> in((num_neighbors + 1) * inputs_per_state);
+    for (auto _ : state) {
+        move(ents, 0.1);
+        observe(ents, in, [](sc::State &s, double *out) {
+                out[0] = s.roll();
+                out[1] = s.pitch();
+                out[2] = s.yaw();
+            });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_observation_cached)->Range(16, 1024);
@@ -53,6 +53,11 @@ class Autonomy : public Plugin {
     virtual bool posthumous(double t);
     virtual void init();
     virtual void init(std::map<std::string,std::string> &params);
+
+    // Called instead of init() when the entity is reused for another
+    // rollout, see Entity::reset(). Returns false if the plugin doesn't
+    // support it.
+    virtual bool reset(std::map<std::string,std::string> &params);
     bool need_reset();
 
     // getters/setters
@@ -67,6 +72,9 @@ class Autonomy : public Plugin {
     scrimmage::RTreePtr &rtree();
     void set_rtree(scrimmage::RTreePtr &rtree);
 
+    EntityIndexPtr &entity_index();
+    void set_entity_index(EntityIndexPtr &entity_index);
+
     StatePtr &state();
     virtual void set_state(StatePtr &state);
 
@@ -79,6 +87,10 @@ class Autonomy : public Plugin {
     bool get_is_controlling();
     void set_is_controlling(bool is_controlling);
 
+    // saves the desired state as well
+    virtual void save_state(Snapshot &snapshot, const std::string &prefix);
+    virtual bool restore_state(const Snapshot &snapshot, const std::string &prefix);
+
  protected:
     std::shared_ptr<GeographicLib::LocalCartesian> proj_;
 
@@ -86,6 +98,7 @@ class Autonomy : public Plugin {
     StatePtr desired_state_;
     ContactMapPtr contacts_;    
     scrimmage::RTreePtr rtree_;
+    EntityIndexPtr entity_index_;
 
     std::list<scrimmage_proto::ShapePtr> shapes_;
     bool need_reset_;
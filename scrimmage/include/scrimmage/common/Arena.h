@@ -0,0 +1,189 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef ARENA_H_
+#define ARENA_H_
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <scrimmage/fwd_decl.h>
+
+namespace scrimmage {
+
+/// Memory for the many small objects a rollout allocates while it runs:
+/// messages, shapes, and publisher and subscriber queue nodes. Objects
+/// kept from one rollout to the next, like recycled entities, come from
+/// the heap, since every rollout gets a new arena.
+///
+/// The arena is a single reservation of capacity bytes of address space.
+/// Blocks are bumped off it in multiples of granularity bytes, and a block
+/// freed by the owner thread goes on the free list of its size, so a
+/// simulation that publishes the same messages every time step reuses the
+/// same blocks. There are no locks: only the owner thread, the simulation
+/// thread of the rollout, allocates from the arena or reuses its blocks.
+/// Other threads, e.g. entity workers, get heap memory, and blocks they
+/// free are left for the release. Blocks larger than max_block_size, with
+/// a stricter alignment, or allocated once the arena is full also come
+/// from the heap.
+///
+/// An arena is created with create() and released with the last ArenaPtr.
+/// Messages kept in a snapshot can outlive the rollout that published
+/// them, so the arena keeps an atomic count of its blocks, and the whole
+/// reservation is unmapped in one step once the last of them is returned.
+class Arena {
+ public:
+    static constexpr size_t granularity = 16;
+    static constexpr size_t max_block_size = 2048;
+
+    /// The calling thread is the owner
+    static ArenaPtr create(size_t capacity = 64 * 1024 * 1024);
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /// Makes the calling thread the owner, e.g. when a simulation that was
+    /// initialized on one thread runs on another
+    void set_owner_thread();
+
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    void deallocate(void *p, size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    /// std::make_shared with the object and its reference counts in one
+    /// block of the arena
+    template <class T, class... Args>
+    std::shared_ptr<T> make_shared(Args&&... args);
+
+    /// Bytes of the reservation handed out so far, and in blocks that the
+    /// owner thread hasn't freed
+    size_t bytes_reserved() const { return next_ - begin_; }
+    size_t bytes_in_use() const { return bytes_in_use_; }
+    size_t capacity() const { return end_ - begin_; }
+
+ protected:
+    explicit Arena(size_t capacity);
+    ~Arena();
+
+    // called by the last ArenaPtr and by deallocate()
+    void unref();
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    static bool pooled(size_t bytes, size_t alignment) {
+        return bytes <= max_block_size && alignment <= granularity;
+    }
+    static size_t size_class(size_t bytes) {
+        return bytes == 0 ? 0 : (bytes - 1) / granularity;
+    }
+
+    bool owner() const { return std::this_thread::get_id() == owner_; }
+    bool contains(void *p) const {
+        return static_cast<char*>(p) >= begin_ && static_cast<char*>(p) < end_;
+    }
+
+    char *begin_;
+    char *next_;
+    char *end_;
+    std::array<FreeBlock*, max_block_size / granularity> free_;
+    size_t bytes_in_use_;
+    std::thread::id owner_;
+    // blocks, plus one for the ArenaPtrs
+    std::atomic<size_t> refs_;
+};
+
+/// Standard allocator over an arena, or the heap without one. The arena
+/// has to outlive allocators that aren't holding any of its blocks, e.g.
+/// empty containers, which the owner of the container keeps an ArenaPtr
+/// for.
+template <class T>
+class ArenaAllocator {
+ public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    ArenaAllocator() : arena_(nullptr) {}
+    explicit ArenaAllocator(Arena *arena) : arena_(arena) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena()) {}
+
+    T *allocate(size_t n) {
+        if (!arena_) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, size_t n) {
+        if (!arena_) {
+            ::operator delete(p);
+        } else {
+            arena_->deallocate(p, n * sizeof(T), alignof(T));
+        }
+    }
+
+    Arena *arena() const { return arena_; }
+
+ protected:
+    Arena *arena_;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+    return a.arena() == b.arena();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+    return !(a == b);
+}
+
+/// Arena::make_shared, or std::make_shared when arena is null
+template <class T, class... Args>
+std::shared_ptr<T> make_shared_from(Arena *arena, Args&&... args) {
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                   std::forward<Args>(args)...);
+}
+
+template <class T, class... Args>
+std::shared_ptr<T> make_shared_from(const ArenaPtr &arena, Args&&... args) {
+    return make_shared_from<T>(arena.get(), std::forward<Args>(args)...);
+}
+
+template <class T, class... Args>
+std::shared_ptr<T> Arena::make_shared(Args&&... args) {
+    return make_shared_from<T>(this, std::forward<Args>(args)...);
+}
+
+} // namespace scrimmage
+#endif
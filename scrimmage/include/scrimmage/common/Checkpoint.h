@@ -0,0 +1,151 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace scrimmage {
+
+/// A set of named binary fields saved to / loaded from a single file.
+///
+/// Scalars and vectors of trivially copyable types are stored as raw bytes,
+/// so values round-trip bit-exactly. save() writes to a temporary file,
+/// fsyncs it and renames it over the destination, so a checkpoint on disk is
+/// always either the old one or the new one.
+class Checkpoint {
+ public:
+    template <class T>
+    void set(std::string key, const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Checkpoint::set requires a trivially copyable type");
+        fields_[key].assign(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <class T, class Alloc>
+    void set(std::string key, const std::vector<T, Alloc> &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Checkpoint::set requires a trivially copyable type");
+        fields_[key].assign(reinterpret_cast<const char *>(value.data()),
+                            value.size() * sizeof(T));
+    }
+
+    void set(std::string key, const std::string &value) { fields_[key] = value; }
+
+    template <class K, class V>
+    void set(std::string key, const std::map<K, V> &value) {
+        std::vector<K> keys;
+        std::vector<V> values;
+        for (auto &kv : value) {
+            keys.push_back(kv.first);
+            values.push_back(kv.second);
+        }
+        set(key + "/keys", keys);
+        set(key + "/values", values);
+    }
+
+    template <class T>
+    bool get(std::string key, T &value) const {
+        auto it = fields_.find(key);
+        if (it == fields_.end() || it->second.size() != sizeof(T)) return false;
+        std::memcpy(&value, it->second.data(), sizeof(T));
+        return true;
+    }
+
+    template <class T, class Alloc>
+    bool get(std::string key, std::vector<T, Alloc> &value) const {
+        auto it = fields_.find(key);
+        if (it == fields_.end() || it->second.size() % sizeof(T) != 0) return false;
+        value.resize(it->second.size() / sizeof(T));
+        std::memcpy(value.data(), it->second.data(), it->second.size());
+        return true;
+    }
+
+    template <class K, class V>
+    bool get(std::string key, std::map<K, V> &value) const {
+        std::vector<K> keys;
+        std::vector<V> values;
+        if (!get(key + "/keys", keys) || !get(key + "/values", values) ||
+            keys.size() != values.size()) {
+            return false;
+        }
+        value.clear();
+        for (size_t i = 0; i < keys.size(); i++) {
+            value.emplace(keys[i], values[i]);
+        }
+        return true;
+    }
+
+    bool get(std::string key, std::string &value) const;
+
+    bool has(std::string key) const;
+    void clear();
+
+    bool save(std::string filename);
+    bool load(std::string filename);
+
+    /// The fields without the file header, e.g. to send as a message
+    std::string serialize() const;
+    bool deserialize(const std::string &data);
+
+ protected:
+    std::map<std::string, std::string> fields_;
+};
+
+/// Saves checkpoints on a background thread so that writing to disk doesn't
+/// stall the caller. The checkpoint is moved in, so the caller is free to
+/// keep mutating its own state. Only one save is in flight at a time; a new
+/// save waits for the previous one to finish.
+class CheckpointWriter {
+ public:
+    CheckpointWriter();
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    void save(Checkpoint &&checkpoint, std::string filename);
+
+    /// Blocks until the pending save is done. Returns false if it failed.
+    bool wait();
+
+ protected:
+    std::thread thread_;
+    bool success_;
+};
+
+using CheckpointPtr = std::shared_ptr<Checkpoint>;
+} // namespace scrimmage
+#endif
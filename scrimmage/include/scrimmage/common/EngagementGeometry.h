@@ -0,0 +1,121 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef ENGAGEMENTGEOMETRY_H_
+#define ENGAGEMENTGEOMETRY_H_
+#include <Eigen/Dense>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <scrimmage/fwd_decl.h>
+
+namespace scrimmage {
+
+/// Where a target is as seen from a source entity
+struct Engagement {
+    int target_id;
+    Eigen::Vector3d rel_pos;    // in the source's body frame
+    double range;
+    double az;                  // body frame, as in State::InFieldOfView
+    double el;
+
+    bool in_field_of_view(double fov_width, double fov_height) const {
+        return std::abs(az) < fov_width / 2 && std::abs(el) < fov_height / 2;
+    }
+};
+
+/// The engagements of one source, sorted by target id
+class EngagementRow {
+ public:
+    const Engagement *find(int target_id) const;
+
+    std::vector<Engagement>::const_iterator begin() const { return engagements_.begin(); }
+    std::vector<Engagement>::const_iterator end() const { return engagements_.end(); }
+    size_t size() const { return engagements_.size(); }
+
+ protected:
+    friend class EngagementGeometry;
+    std::vector<Engagement> engagements_;
+};
+
+/// Pairwise range and bearings between entities, shared by the sensors,
+/// autonomies and interactions that would otherwise each rotate every
+/// relative position themselves. SimControl takes a snapshot of all poses
+/// with update() before the entities run and again before the interactions.
+/// A source's row is filled the first time it is asked for and reused by
+/// every later query in that snapshot.
+class EngagementGeometry {
+ public:
+    EngagementGeometry();
+
+    /// Pairs farther apart than max_range are left out of the rows
+    /// (default: no limit)
+    void set_max_range(double max_range);
+    double max_range() const { return max_range_; }
+
+    void update(const std::list<EntityPtr> &ents);
+
+    /// Whether the entity was in the last update
+    bool contains(int id) const;
+
+    /// Engagements of src_id with every other entity within max_range,
+    /// nullptr if src_id wasn't in the last update. The row stays valid
+    /// until the next update. Thread safe.
+    const EngagementRow *row(int src_id);
+
+    /// False if either entity wasn't in the last update or they are
+    /// farther apart than max_range
+    bool get(int src_id, int target_id, Engagement &engagement);
+
+ protected:
+    void fill(size_t src, std::vector<Engagement> &engagements) const;
+    int index(int id) const;
+
+    double max_range_;
+    uint64_t stamp_;
+
+    // Snapshot, one entry per entity, in id order
+    std::vector<int> ids_;
+    std::vector<double> x_, y_, z_;
+    std::vector<Eigen::Matrix3d> world_to_body_;
+    std::vector<int> index_;    // snapshot index of each entity id, -1 if none
+
+    std::vector<EngagementRow> rows_;
+    std::unique_ptr<std::atomic<uint64_t>[]> row_stamps_;
+    size_t row_stamps_size_;
+    std::mutex mutex_;
+};
+
+typedef std::shared_ptr<EngagementGeometry> EngagementGeometryPtr;
+}  // namespace scrimmage
+#endif // ENGAGEMENTGEOMETRY_H_
@@ -0,0 +1,84 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef FITNESSSHAPING_H_
+#define FITNESSSHAPING_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scrimmage {
+
+/// Fitness shaping for evolution strategies. Each transform maps raw scores
+/// (higher is better) to the weights of the samples' noise in the update.
+/// NaN scores count as -infinity. Tied scores always get the same weight.
+enum class FitnessShaping {
+    CENTERED_RANKS = 0, // rank / (n-1) - 0.5, Salimans et al. 2017
+    UTILITY,            // NES utilities, Wierstra et al. 2014
+    DENSE_RANKS,        // the transform scrimmage-learn used originally
+    ELITE               // cross-entropy method: 1 for the top fraction
+};
+
+/// "centered_ranks", "utility", "dense_ranks" or "elite"
+bool str2fitness_shaping(std::string str, FitnessShaping &shaping);
+
+/// Indices that sort scores in ascending order. Equal scores keep their
+/// order.
+std::vector<uint32_t> argsort(const std::vector<double> &scores);
+
+/// Ranks from 0 (worst) to n-1 (best). Tied scores get the average of their
+/// ranks.
+std::vector<double> fractional_ranks(const std::vector<double> &scores);
+
+/// Fractional ranks scaled to [-0.5, 0.5]. They sum to zero, so all equal
+/// scores give no update.
+std::vector<double> centered_ranks(const std::vector<double> &scores);
+
+/// max(0, log(n/2 + 1) - log(k)) normalized to sum to one, minus 1/n, where
+/// k = 1 is the best sample.
+std::vector<double> utility_weights(const std::vector<double> &scores);
+
+/// (d + 1) / D - 0.5, where d is the dense rank and D the number of distinct
+/// scores. Kept to reproduce old runs; it isn't centered.
+std::vector<double> dense_rank_weights(const std::vector<double> &scores);
+
+/// 1 for the best ceil(fraction * n) samples, 0 for the others. Samples tied
+/// with the last elite are all elite.
+std::vector<double> elite_weights(const std::vector<double> &scores,
+                                  double fraction);
+
+/// CMA-ES recombination weights: log(mu + 1/2) - log(k) for the best
+/// mu = n/2 samples, where k = 1 is the best, normalized to sum to one. The
+/// other samples get 0.
+std::vector<double> recombination_weights(const std::vector<double> &scores);
+
+std::vector<double> shape_fitness(const std::vector<double> &scores,
+                                  FitnessShaping shaping,
+                                  double elite_fraction = 0.2);
+
+} // namespace scrimmage
+#endif
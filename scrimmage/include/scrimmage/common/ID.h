@@ -39,9 +39,9 @@ class ID {
     void set_sub_swarm_id(int sub_swarm_id);
     void set_team_id(int team_id);
 
-    int id();
-    int sub_swarm_id();
-    int team_id();
+    int id() const;
+    int sub_swarm_id() const;
+    int team_id() const;
 
     bool operator==(const ID &other) const;
 
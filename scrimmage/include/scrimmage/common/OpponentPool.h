@@ -0,0 +1,142 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef OPPONENTPOOL_H_
+#define OPPONENTPOOL_H_
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+namespace scrimmage {
+
+class Random;
+
+/// A policy frozen at some generation of training, played against by the
+/// current policy. The network is loaded once and only read afterwards, so
+/// every rollout and aircraft in the process can share it.
+class Opponent {
+ public:
+    typedef tiny_dnn::network<tiny_dnn::sequential> Network;
+
+    Opponent(int32_t id, std::string nn_path);
+
+    /// Generation the policy was taken from, -1 for the initial policy
+    int32_t id() const { return id_; }
+    const std::string &nn_path() const { return nn_path_; }
+
+    bool load();
+    const Network &network() const { return *network_; }
+
+    /// The network converted to T (e.g. a FixedMLP) with T::from_network.
+    /// It is converted on first use and the same T is returned to every
+    /// caller afterwards, nullptr if the conversion failed. Thread safe.
+    template <class T>
+    std::shared_ptr<const T> compiled() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = compiled_.find(std::type_index(typeid(T)));
+        if (it == compiled_.end()) {
+            std::shared_ptr<T> value = std::make_shared<T>();
+            if (!value->from_network(*network_)) value = nullptr;
+            it = compiled_.emplace(std::type_index(typeid(T)), value).first;
+        }
+        return std::static_pointer_cast<const T>(it->second);
+    }
+
+    /// Result of one rollout against this opponent, from the learner's side
+    void record(double score, double opponent_score);
+
+    uint64_t games() const { return wins_ + losses_ + draws_; }
+    uint64_t wins() const { return wins_; }
+    uint64_t losses() const { return losses_; }
+    uint64_t draws() const { return draws_; }
+
+    /// Draws count as half a win. 0.5 before any games.
+    double win_rate() const;
+
+    /// Average learner score against this opponent
+    double avg_score() const;
+
+    void set_stats(uint64_t wins, uint64_t losses, uint64_t draws,
+                   double total_score);
+    double total_score() const { return total_score_; }
+
+ protected:
+    int32_t id_;
+    std::string nn_path_;
+    std::shared_ptr<const Network> network_;
+
+    std::mutex mutex_;
+    std::map<std::type_index, std::shared_ptr<const void>> compiled_;
+
+    uint64_t wins_;
+    uint64_t losses_;
+    uint64_t draws_;
+    double total_score_;
+};
+
+typedef std::shared_ptr<Opponent> OpponentPtr;
+
+/// A bounded league of past policies. Once it holds max_size opponents,
+/// adding one drops the oldest. Sampling favors the opponents the learner
+/// does worst against: opponent i is drawn with probability proportional to
+/// (1 - win_rate_i)^priority_exponent, so an exponent of 0 is uniform.
+class OpponentPool {
+ public:
+    explicit OpponentPool(size_t max_size = 1, double priority_exponent = 0);
+
+    size_t max_size() const { return max_size_; }
+    size_t size() const { return opponents_.size(); }
+    bool empty() const { return opponents_.empty(); }
+
+    /// Loads nn_path, returns nullptr if it couldn't be loaded
+    OpponentPtr add(int32_t id, std::string nn_path);
+    OpponentPtr find(int32_t id) const;
+    const std::deque<OpponentPtr> &opponents() const { return opponents_; }
+
+    OpponentPtr sample(Random &random) const;
+
+    /// One line per opponent: id,games,wins,losses,draws,win_rate,avg_score
+    void write_stats(std::ostream &out) const;
+
+ protected:
+    size_t max_size_;
+    double priority_exponent_;
+    std::deque<OpponentPtr> opponents_;
+};
+
+typedef std::shared_ptr<OpponentPool> OpponentPoolPtr;
+
+} // namespace scrimmage
+#endif
@@ -37,6 +37,11 @@ namespace scrimmage {
         double step(double dt, double measurement);
         void set_integral_band(double integral_band);
         void set_is_angle(bool is_angle);
+
+        // integrator and derivative state, e.g. for snapshots
+        double integral();
+        double prev_error();
+        void set_state(double integral, double prev_error);
     protected:
         double kp_;
         double ki_;
@@ -29,6 +29,7 @@
 #define RTREE_H_
 
 #include <Eigen/Dense>
+#include <functional>
 #include <map>
 #include <vector>
 #include <scrimmage/common/ID.h>
@@ -58,6 +59,24 @@ typedef boost::geometry::index::rtree<
 
 typedef std::shared_ptr<rtree_t> rtreePtr;
 
+// Read-only view of ids stored contiguously by the neighbor service
+class IDSlice {
+ public:
+    IDSlice() : begin_(nullptr), end_(nullptr) {}
+    IDSlice(const ID *begin, const ID *end) : begin_(begin), end_(end) {}
+
+    const ID *begin() const { return begin_; }
+    const ID *end() const { return end_; }
+    size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    const ID &operator[](size_t i) const { return begin_[i]; }
+    const ID &front() const { return *begin_; }
+
+ protected:
+    const ID *begin_;
+    const ID *end_;
+};
+
 class RTree {
  public:
     RTree();
@@ -67,16 +86,85 @@ class RTree {
     void add(Eigen::Vector3d &pos, ID &id);
     void nearest_n_neighbors(const Eigen::Vector3d &pos,
                              std::vector<ID> &neighbors, unsigned int n,
-                             int self_id=-1, int team_id=-1);
+                             int self_id=-1, int team_id=-1) const;
     void neighbors_in_range(const Eigen::Vector3d &pos,
                             std::vector<ID> &neighbors, double dist,
-                            int self_id=-1, int team_id=-1);
+                            int self_id=-1, int team_id=-1) const;
+
+    // Neighbor service. Plugins request the number of nearest neighbors
+    // they need in init(), either per team or over all teams. SimControl
+    // calls compute_neighbors() once per tick after building the tree,
+    // which finds for every entity its k nearest neighbors on each team
+    // and/or on all teams (team_id -1) in one batched pass, k being the
+    // largest request.
+    void request_neighbors(unsigned int k, bool by_team=true);
+    unsigned int neighbors_k() const;
+
+    // Runs all the jobs, possibly concurrently, and returns once they are
+    // done. compute_neighbors() splits its rows into num_threads jobs for
+    // it; SimControl passes its entity worker pool, so no threads are
+    // started per tick. Without a runner the rows are computed in the
+    // calling thread.
+    typedef std::function<void(std::vector<std::function<void()>> &jobs)> JobRunner;
+    void set_job_runner(JobRunner runner, int num_threads);
+    void compute_neighbors();
+
+    // The (at most) n nearest neighbors of entity self_id on team_id,
+    // nearest first and without self_id. Returns false if they weren't
+    // computed this tick or n is larger than the requested k.
+    bool nearest_neighbors(int self_id, unsigned int n, IDSlice &neighbors,
+                           int team_id=-1) const;
+
+    // Same, but falls back to a tree query around pos, stored in storage,
+    // when the neighbors of self_id weren't computed
+    IDSlice nearest_neighbors(const Eigen::Vector3d &pos, int self_id,
+                              unsigned int n, std::vector<ID> &storage,
+                              int team_id=-1) const;
+
  protected:
+    // the neighbors of rows [begin, end)
+    void compute_neighbors(size_t begin, size_t end);
 
     rtreePtr rtree_;
     std::map<int, rtreePtr> rtree_team_;
     int size_;
 
+    // Entities added since the last clear(), in order
+    std::vector<Eigen::Vector3d> positions_;
+    std::vector<ID> ids_;
+
+    unsigned int neighbors_k_;
+    bool neighbors_by_team_;
+    bool neighbors_all_teams_;
+    JobRunner job_runner_;
+    int num_threads_;
+    bool neighbors_valid_;
+    std::vector<std::function<void()>> jobs_;
+
+    // Each group holds one team, or all entities for team -1. Its members
+    // are binned on a uniform x-y grid and stored cell by cell, with their
+    // coordinates per axis, so queries scan contiguous memory.
+    struct NeighborGroup {
+        double x0, y0, cell_size;
+        int nx, ny;
+        std::vector<size_t> cell_start;
+        std::vector<size_t> rows;
+        std::vector<double> x, y, z;
+
+        size_t cell(const Eigen::Vector3d &pos) const;
+        int cell_x(double x) const;
+        int cell_y(double y) const;
+    };
+    std::vector<int> group_teams_;
+    std::vector<NeighborGroup> groups_;
+
+    // Row of each entity id, -1 if it wasn't added. The neighbors of row r
+    // in group g are neighbor_ids_[(r * groups + g) * k, ...), with
+    // neighbor_counts_[r * groups + g] of them.
+    std::vector<int> rows_;
+    std::vector<ID> neighbor_ids_;
+    std::vector<unsigned int> neighbor_counts_;
+
  private:
 };
 
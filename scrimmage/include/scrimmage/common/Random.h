@@ -29,6 +29,7 @@
 #define RANDOM_H_
 #include <memory>
 #include <random>
+#include <string>
 
 
 namespace scrimmage {
@@ -50,6 +51,12 @@ class Random {
 
     std::default_random_engine &gener();
 
+    // Complete generator state (including the cached value of the normal
+    // distribution) as text, so that a restored Random continues the exact
+    // same sequence.
+    std::string state();
+    bool set_state(std::string state);
+
  protected:
     uint32_t seed_;
     std::default_random_engine gener_;
@@ -86,6 +86,15 @@ public:
 
         return update;
     }
+
+    // Moment estimates, used to checkpoint and restore the optimizer
+    const T &first_moment() const { return m; }
+    const T &second_moment() const { return v; }
+
+    void set_moments(const T &m_, const T &v_){
+        m=m_;
+        v=v_;
+    }
 };
 
 }
@@ -64,6 +64,20 @@ class Entity : public std::enable_shared_from_this<Entity> {
               FileSearch &file_search,
               RTreePtr &rtree);
 
+    /// Readies an entity that took part in a rollout for another one of a
+    /// mission with the same entities, instead of building a new one with
+    /// init(). The state and health are set from info and every plugin is
+    /// reset() with the parameters it was initialized with, keeping its
+    /// publishers and subscribers. Returns false if a plugin can't be
+    /// reset; the entity's plugins are then disconnected from the network
+    /// and it has to be replaced.
+    bool reset(std::map<std::string, std::string> &info,
+               MissionParsePtr mp,
+               std::shared_ptr<GeographicLib::LocalCartesian> proj);
+
+    /// Stops the publishers and subscribers of all the entity's plugins
+    void stop_networking();
+
     bool parse_visual(std::map<std::string, std::string> &info,
                       MissionParsePtr mp, FileSearch &file_search);
 
@@ -95,6 +109,18 @@ class Entity : public std::enable_shared_from_this<Entity> {
     std::string nn_path() {return nn_path_; }
     void set_nn_path2(std::string nn_path){nn_path2_=nn_path;}
     std::string nn_path2() {return nn_path2_; }
+    // frozen policy the other team plays with in league training
+    void set_opponent(OpponentPtr opponent) { opponent_ = opponent; }
+    OpponentPtr opponent() { return opponent_; }
+    // adapted search distribution the trained team samples its weights from
+    void set_search_distribution(std::shared_ptr<const LowRankCMAES> dist) { search_distribution_ = dist; }
+    std::shared_ptr<const LowRankCMAES> search_distribution() { return search_distribution_; }
+    // pairwise ranges and bearings of this tick, shared by all entities
+    void set_engagement_geometry(EngagementGeometryPtr geometry) { engagement_geometry_ = geometry; }
+    EngagementGeometryPtr engagement_geometry() { return engagement_geometry_; }
+    // forward passes run together by BatchSimControl, null when stepped alone
+    void set_inference_batch(InferenceBatchPtr batch) { inference_batch_ = batch; }
+    InferenceBatchPtr inference_batch() { return inference_batch_; }
 
     Contact::Type type();
 
@@ -114,6 +140,10 @@ class Entity : public std::enable_shared_from_this<Entity> {
 
     std::unordered_map<std::string, Service> &services();
 
+    // The entity's state, health and plugins, see SimControl::snapshot()
+    void save_state(Snapshot &snapshot, const std::string &prefix);
+    bool restore_state(const Snapshot &snapshot, const std::string &prefix);
+
  protected:
     ID id_;
 
@@ -137,6 +167,10 @@ class Entity : public std::enable_shared_from_this<Entity> {
     std::vector<double> parameter_vector_;
     std::string nn_path_;
     std::string nn_path2_;
+    OpponentPtr opponent_;
+    std::shared_ptr<const LowRankCMAES> search_distribution_;
+    EngagementGeometryPtr engagement_geometry_;
+    InferenceBatchPtr inference_batch_;
 
     StatePtr state_;
     std::unordered_map<std::string, std::list<SensablePtr>> sensables_;
@@ -145,6 +179,11 @@ class Entity : public std::enable_shared_from_this<Entity> {
     bool active_;
     bool visual_changed_;
     std::unordered_map<std::string, Service> services_;
+
+    // The parameters each plugin was initialized with, for reset()
+    std::map<PluginPtr, std::map<std::string, std::string>> plugin_params_;
+
+    void init_state(std::map<std::string, std::string> &info);
 };
 
 using EntityPtr = std::shared_ptr<Entity>;
@@ -73,6 +73,26 @@ using EntityInteractionPtr = std::shared_ptr<EntityInteraction>;
 class Metrics;
 using MetricsPtr = std::shared_ptr<Metrics>;
 
+class EntityIndex;
+using EntityIndexPtr = std::shared_ptr<EntityIndex>;
+
+class Opponent;
+using OpponentPtr = std::shared_ptr<Opponent>;
+
+class EngagementGeometry;
+using EngagementGeometryPtr = std::shared_ptr<EngagementGeometry>;
+
+class Snapshot;
+using SnapshotPtr = std::shared_ptr<Snapshot>;
+
+class Arena;
+using ArenaPtr = std::shared_ptr<Arena>;
+
+class InferenceBatch;
+using InferenceBatchPtr = std::shared_ptr<InferenceBatch>;
+
+class LowRankCMAES;
+
 class CameraInterface;
 }
 
@@ -0,0 +1,140 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef COLUMNARLOG_H_
+#define COLUMNARLOG_H_
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace scrimmage_proto {
+class Frame;
+}
+
+namespace scrimmage {
+
+/// Compact alternative to frames.bin for bulk rollouts.
+///
+/// Frames are buffered and written in chunks of N ticks. Within a chunk each
+/// contact field is stored as its own fixed-width column (time, row count,
+/// entity key, active, position, velocity, orientation), and contacts refer
+/// to an entity dictionary entry (id, sub_swarm_id, team_id, type) instead
+/// of repeating the ID message on every tick. Each chunk is zlib compressed
+/// independently, so a truncated file loses at most the last chunk.
+///
+/// File layout:
+///   "SCCOL001"
+///   chunk*: uint32 num_ticks, uint32 num_rows, uint32 num_new_keys,
+///           uint8 compressed, uint64 raw_size, uint64 stored_size,
+///           payload[stored_size]
+///
+/// Payload (uncompressed):
+///   new keys  : num_new_keys x (int32 id, int32 sub_swarm_id,
+///                               int32 team_id, int32 type)
+///   times     : double[num_ticks]
+///   row counts: uint32[num_ticks]
+///   keys      : uint32[num_rows]
+///   active    : uint8[num_rows]
+///   pos x,y,z, vel x,y,z, quat w,x,y,z : double[num_rows] each
+class ColumnarLogWriter {
+ public:
+    ColumnarLogWriter();
+    ~ColumnarLogWriter();
+
+    ColumnarLogWriter(const ColumnarLogWriter &) = delete;
+    ColumnarLogWriter &operator=(const ColumnarLogWriter &) = delete;
+
+    bool open(std::string filename, unsigned int ticks_per_chunk = 256,
+              bool compress = true);
+    bool is_open();
+
+    bool write_frame(const scrimmage_proto::Frame &frame);
+
+    /// Writes the buffered ticks as a chunk
+    bool flush();
+
+    /// Flushes and closes the file
+    bool close();
+
+ protected:
+    using Key = std::tuple<int, int, int, int>;
+
+    std::ofstream output_;
+    unsigned int ticks_per_chunk_;
+    bool compress_;
+
+    std::map<Key, uint32_t> keys_;
+    std::vector<Key> new_keys_;
+
+    std::vector<double> times_;
+    std::vector<uint32_t> row_counts_;
+    std::vector<uint32_t> row_keys_;
+    std::vector<uint8_t> active_;
+    std::vector<double> columns_[10];
+};
+
+class ColumnarLogReader {
+ public:
+    ColumnarLogReader();
+
+    bool open(std::string filename);
+    void close();
+    bool is_open();
+
+    /// Decodes the next chunk into frames. Returns false at the end of the
+    /// file or if the chunk is truncated / corrupt.
+    bool read_chunk(std::vector<std::shared_ptr<scrimmage_proto::Frame>> &frames);
+
+    /// Reads every remaining chunk
+    bool read_all(std::list<std::shared_ptr<scrimmage_proto::Frame>> &frames);
+
+    /// false if the last chunk in the file was truncated
+    bool clean_eof();
+
+ protected:
+    std::ifstream input_;
+    uint64_t file_size_;
+    bool clean_eof_;
+    std::vector<std::tuple<int, int, int, int>> keys_;
+};
+
+/// Converts frames.bin (length-delimited Frame messages) to the columnar
+/// format and back. Returns false if the input can't be read or the output
+/// can't be written.
+bool frames_to_columnar(std::string frames_file, std::string columnar_file,
+                        unsigned int ticks_per_chunk = 256, bool compress = true);
+bool columnar_to_frames(std::string columnar_file, std::string frames_file);
+
+using ColumnarLogWriterPtr = std::shared_ptr<ColumnarLogWriter>;
+using ColumnarLogReaderPtr = std::shared_ptr<ColumnarLogReader>;
+} // namespace scrimmage
+#endif
@@ -0,0 +1,97 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef FRAMEREADER_H_
+#define FRAMEREADER_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace scrimmage_proto {
+class Frame;
+}
+
+namespace scrimmage {
+
+/// Random access reader for frames.bin. The file is memory-mapped and only
+/// an index of (time, offset, size) per frame is kept in memory. Frames are
+/// decoded on demand, so opening a log costs one pass over the message
+/// headers regardless of how many contacts each frame holds.
+///
+/// The index is cached next to the log in a sidecar file (frames.bin.idx)
+/// and reused on the next open if the log file size hasn't changed.
+class FrameReader {
+ public:
+    struct IndexEntry {
+        double time;
+        uint64_t offset; // offset of the message body (after the size varint)
+        uint32_t size;
+    };
+
+    FrameReader();
+    ~FrameReader();
+
+    FrameReader(const FrameReader &) = delete;
+    FrameReader &operator=(const FrameReader &) = delete;
+
+    bool open(std::string filename, bool use_index_file = true);
+    void close();
+    bool is_open();
+
+    size_t size();
+    double time(size_t i);
+
+    /// Index of the first frame with time >= t (size() if none).
+    size_t find(double t);
+
+    bool read(size_t i, scrimmage_proto::Frame &frame);
+    std::shared_ptr<scrimmage_proto::Frame> read(size_t i);
+
+    std::vector<IndexEntry> &index();
+    std::string index_filename();
+
+    /// false if the last message in the file was truncated (e.g., the
+    /// simulation is still writing or was killed)
+    bool clean_eof();
+
+ protected:
+    std::string filename_;
+    int fd_;
+    const uint8_t *data_;
+    uint64_t file_size_;
+    bool clean_eof_;
+    std::vector<IndexEntry> index_;
+
+    bool build_index();
+    bool load_index_file();
+    bool save_index_file();
+};
+
+using FrameReaderPtr = std::shared_ptr<FrameReader>;
+} // namespace scrimmage
+#endif
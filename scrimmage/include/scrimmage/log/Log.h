@@ -33,6 +33,8 @@
 #include <scrimmage/entity/Contact.h>
 #include <scrimmage/math/Quaternion.h>
 #include <scrimmage/log/Frame.h>
+#include <scrimmage/log/FrameReader.h>
+#include <scrimmage/log/ColumnarLog.h>
 #include <scrimmage/math/State.h>
 
 #include <google/protobuf/message_lite.h>
@@ -84,6 +86,8 @@ class Log {
     bool parse_frames(std::string filename, 
                       ZeroCopyInputStreamPtr input);
     
+    bool parse_columnar_frames(std::string filename);
+
     bool parse_shapes(std::string filename, 
                       ZeroCopyInputStreamPtr input);
 
@@ -107,6 +111,16 @@ class Log {
     std::list<std::shared_ptr<scrimmage_proto::UTMTerrain> > & utm_terrain();
     std::list<std::shared_ptr<scrimmage_proto::ContactVisual> > & contact_visual();
 
+    // When enabled, parse() indexes frames.bin with a FrameReader instead
+    // of loading every frame into frames() and scrimmage_frames().
+    void set_lazy_frames(bool lazy_frames);
+    FrameReaderPtr &frame_reader();
+
+    // When enabled before init(dir, WRITE), frames are written to the
+    // compact columnar format (frames.col) instead of frames.bin.
+    void set_columnar_frames(bool columnar_frames,
+                             unsigned int ticks_per_chunk = 256);
+
     std::string log_dir();
 
     bool write_ascii(std::string str);
@@ -122,6 +136,7 @@ class Log {
     //bool save_messages();
     
     std::string frames_filename();
+    std::string columnar_frames_filename();
     std::string shapes_filename();
     std::string utm_terrain_filename();
     std::string contact_visual_filename();
@@ -130,16 +145,22 @@ class Log {
     void set_enable_log(bool enable);
 
     void init_network(NetworkPtr network);
+    // unsubscribes from the network init_network() was called with
+    void close_network();
     
  protected:
     using MessageLitePtr = std::shared_ptr<google::protobuf::MessageLite>;
 
     bool enable_log_;
+    bool lazy_frames_;
+    bool columnar_frames_;
+    unsigned int columnar_ticks_per_chunk_;
     Mode mode_;
 
     bool open_file(std::string name, int &fd);
 
     std::string frames_name_;
+    std::string columnar_frames_name_;
     std::string shapes_name_;
     std::string utm_terrain_name_;
     std::string contact_visual_name_;
@@ -168,6 +189,9 @@ class Log {
     std::list<std::shared_ptr<scrimmage_proto::UTMTerrain> > utm_terrain_;
     std::list<std::shared_ptr<scrimmage_proto::ContactVisual> > contact_visual_;
 
+    FrameReaderPtr frame_reader_;
+    ColumnarLogWriterPtr columnar_writer_;
+
     PluginPtr pubsub_;
     SubscriberPtr sub_ent_collisions_;
 
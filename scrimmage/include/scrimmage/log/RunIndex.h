@@ -0,0 +1,101 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef RUNINDEX_H_
+#define RUNINDEX_H_
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scrimmage {
+
+/// Index of the summary.csv results under a log directory tree.
+///
+/// update() walks the tree with a pool of threads and only parses the
+/// summary.csv files that are new or have changed since the index was last
+/// saved, so re-aggregating a large training log only pays for new runs.
+/// A summary.csv counts as changed when its modification time (in
+/// nanoseconds) or its size differs from the indexed one. The index is
+/// persisted as a single consolidated CSV file with one line per run:
+///
+///   outcome,summary_mtime_ns,summary_size,team_id:score team_id:score ...,run_dir
+///
+/// where outcome is "team_<id>" for a single winner, "draw_<id>_<id>..."
+/// or empty if no team scored.
+class RunIndex {
+ public:
+    struct Run {
+        int64_t mtime_ns = -1;
+        int64_t size = -1;
+        std::string outcome;
+        std::map<int, double> team_scores;
+    };
+
+    RunIndex();
+
+    /// Returns false, with an empty index, if filename doesn't exist or was
+    /// written in another format
+    bool load(std::string filename);
+
+    /// Writes to a temporary file and renames it over filename
+    bool save(std::string filename);
+
+    /// Rescans log_dir (skipping exclude_dir) and brings the index up to
+    /// date. Runs whose summary.csv no longer exists are dropped. Returns
+    /// the number of summary.csv files that had to be parsed.
+    int update(std::string log_dir, int num_threads,
+               std::string exclude_dir = "");
+
+    /// Key: run directory
+    std::map<std::string, Run> &runs();
+
+    /// Run directories grouped by outcome, without the runs that have no
+    /// winner
+    std::map<std::string, std::vector<std::string>> outcomes();
+
+    static bool parse_summary(std::string filename,
+                              std::map<int, double> &team_scores);
+
+    /// Empty if no team scored
+    static std::string outcome(std::map<int, double> &team_scores);
+
+    /// Finds the summary.csv files under dir in parallel. Run directories
+    /// are leaves: a directory holding a summary.csv isn't descended into.
+    /// Symlinks to directories aren't followed.
+    static void find_summaries(std::string dir, int num_threads,
+                               std::vector<std::string> &paths,
+                               std::string exclude_dir = "");
+
+ protected:
+    std::map<std::string, Run> runs_;
+};
+
+using RunIndexPtr = std::shared_ptr<RunIndex>;
+} // namespace scrimmage
+#endif
@@ -0,0 +1,322 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef FASTMATH_H_
+#define FASTMATH_H_
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+namespace scrimmage {
+
+/// Replacements for the libm functions that dominate the simulation's hot
+/// loops: motion model integration, field of view tests and tanh
+/// activations. The scalar versions are inline and free of branches on the
+/// argument, so a loop over them vectorizes; the batch versions are such
+/// loops over arrays. Arguments the kernels don't cover are passed on to
+/// libm, so results are always finite where libm's are.
+///
+/// Max error against correctly rounded results, measured by test_fast_math
+/// over the stated ranges:
+///
+///   sin, cos      1.5 ulp for |x| <= 10, 2.5 ulp for |x| <= 1e5 (libm beyond)
+///   tan           3 ulp for |x| <= 10, 4 ulp for |x| <= 1e5 (libm beyond)
+///   atan2         1.5 ulp (NaN where both arguments are infinite)
+///   exp           1.5 ulp, 0 below -708 and inf above 709.7
+///   tanh          1.5 ulp
+///
+/// The results aren't bit-identical to libm's, so plugins only use them
+/// when their fast_math parameter is set.
+namespace fast_math {
+
+namespace detail {
+
+const double pi = 3.14159265358979311600e+00;
+const double pi_2 = 1.57079632679489655800e+00;
+const double pi_4 = 7.85398163397448278999e-01;
+const double two_over_pi = 6.36619772367581382433e-01;
+const double log2e = 1.44269504088896338700e+00;
+
+// Adding and subtracting 1.5 * 2^52 rounds to the nearest integer, which
+// is left in the low bits of the sum
+const double round_shift = 6755399441055744.0;
+
+// pi/2 and ln 2 split so that k * hi is exact (Cody-Waite)
+const double pio2_1 = 1.57079632673412561417e+00;
+const double pio2_2 = 6.07710050630396597660e-11;
+const double pio2_3 = 2.02226624871116645580e-21;
+const double ln2_hi = 6.93147180369123816490e-01;
+const double ln2_lo = 1.90821492927058770002e-10;
+
+const double trig_max = 1e5;
+const double exp_min = -708.0;
+const double exp_max = 709.7;
+
+inline int64_t to_bits(double x) {
+    int64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+inline double from_bits(int64_t bits) {
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// c ? a : b on the bits. Both a and b are always computed, which lets a
+// loop over it vectorize where a conditional expression is compiled to a
+// branch.
+inline double select(bool c, double a, double b) {
+    int64_t mask = -static_cast<int64_t>(c);
+    return from_bits((to_bits(a) & mask) | (to_bits(b) & ~mask));
+}
+
+// sin and cos of r in [-pi/4, pi/4] (fdlibm's minimax polynomials)
+inline double sin_poly(double r) {
+    double z = r * r;
+    double p = -2.50507602534068634195e-08 + z * 1.58969099521155010221e-10;
+    p = 2.75573137070700676789e-06 + z * p;
+    p = -1.98412698298579493134e-04 + z * p;
+    p = 8.33333333332248946124e-03 + z * p;
+    p = -1.66666666666666324348e-01 + z * p;
+    return r + r * z * p;
+}
+
+inline double cos_poly(double r) {
+    double z = r * r;
+    double p = 2.08757232129817482790e-09 + z * -1.13596475577881948265e-11;
+    p = -2.75573143513906633035e-07 + z * p;
+    p = 2.48015872894767294178e-05 + z * p;
+    p = -1.38888888888741095749e-03 + z * p;
+    p = 4.16666666666666019037e-02 + z * p;
+    double hz = 0.5 * z;
+    double w = 1.0 - hz;
+    return w + (((1.0 - w) - hz) + z * z * p);
+}
+
+// Reduces x to r in [-pi/4, pi/4] with x = r + k * pi/2, k = quadrant mod 4
+inline double reduce_pio2(double x, int64_t &quadrant) {
+    double t = x * two_over_pi + round_shift;
+    double k = t - round_shift;
+    quadrant = to_bits(t) & 3;
+    return ((x - k * pio2_1) - k * pio2_2) - k * pio2_3;
+}
+
+// Accurate for |x| <= trig_max
+inline void sincos_reduced(double x, double &s, double &c) {
+    int64_t q;
+    double r = reduce_pio2(x, q);
+    double sr = sin_poly(r);
+    double cr = cos_poly(r);
+    // Selects and sign flips on the bits, which vectorize where branches
+    // on the quadrant don't
+    int64_t swap = -(q & 1);
+    int64_t sr_bits = to_bits(sr), cr_bits = to_bits(cr);
+    int64_t sq = (cr_bits & swap) | (sr_bits & ~swap);
+    int64_t cq = (sr_bits & swap) | (cr_bits & ~swap);
+    s = from_bits(sq ^ ((q & 2) << 62));
+    c = from_bits(cq ^ (((q + 1) & 2) << 62));
+}
+
+// atan of x in [-inf, inf] (Cephes' rational approximation)
+inline double atan_kernel(double x) {
+    const double more_bits = 6.123233995736765886130e-17;
+    double ax = std::fabs(x);
+    bool big = ax > 2.41421356237309504880;    // tan(3 pi / 8)
+    bool mid = ax > 0.66;
+    double t = select(big, -1.0 / ax, select(mid, (ax - 1.0) / (ax + 1.0), ax));
+    double y0 = big ? pi_2 : (mid ? pi_4 : 0.0);
+    double extra = big ? more_bits : (mid ? 0.5 * more_bits : 0.0);
+
+    double z = t * t;
+    double p = -8.750608600031904122785e-01;
+    p = p * z - 1.615753718733365076637e+01;
+    p = p * z - 7.500855792314704667340e+01;
+    p = p * z - 1.228866684490136173410e+02;
+    p = p * z - 6.485021904942025371773e+01;
+    double q = z + 2.485846490142306297962e+01;
+    q = q * z + 1.650270098316988542046e+02;
+    q = q * z + 4.328810604912902668951e+02;
+    q = q * z + 4.853903996359136964868e+02;
+    q = q * z + 1.945506571482613964425e+02;
+
+    double r = y0 + (t * z * p / q + extra + t);
+    return std::copysign(r, x);
+}
+
+// Accurate for exp_min <= x <= exp_max
+inline double exp_reduced(double x) {
+    double t = x * log2e + round_shift;
+    double k = t - round_shift;
+    int64_t ki = to_bits(t) - to_bits(round_shift);
+    double r = (x - k * ln2_hi) - k * ln2_lo;
+
+    // Taylor series, the terms after r^13 / 13! are below half an ulp
+    double p = 1.0 / 6227020800.0;
+    p = 1.0 / 479001600.0 + r * p;
+    p = 1.0 / 39916800.0 + r * p;
+    p = 1.0 / 3628800.0 + r * p;
+    p = 1.0 / 362880.0 + r * p;
+    p = 1.0 / 40320.0 + r * p;
+    p = 1.0 / 5040.0 + r * p;
+    p = 1.0 / 720.0 + r * p;
+    p = 1.0 / 120.0 + r * p;
+    p = 1.0 / 24.0 + r * p;
+    p = 1.0 / 6.0 + r * p;
+    p = 0.5 + r * p;
+    p = 1.0 + r * p;
+    p = 1.0 + r * p;
+
+    // 2^k split in two factors so k = 1024 doesn't overflow the exponent
+    int64_t k1 = ki / 2;
+    return p * from_bits((k1 + 1023) << 52) * from_bits((ki - k1 + 1023) << 52);
+}
+
+// tanh of |x| < 0.625 (Cephes' rational approximation)
+inline double tanh_small(double x) {
+    double z = x * x;
+    double p = -9.64399179425052238628e-01;
+    p = p * z - 9.92877231001918586564e+01;
+    p = p * z - 1.61468768441708447952e+03;
+    double q = z + 1.12811678491632931402e+02;
+    q = q * z + 2.23548839060100448583e+03;
+    q = q * z + 4.84406305325125486048e+03;
+    return x + x * z * p / q;
+}
+
+} // namespace detail
+
+inline double sin(double x) {
+    if (!(std::fabs(x) <= detail::trig_max)) return std::sin(x);
+    double s, c;
+    detail::sincos_reduced(x, s, c);
+    return s;
+}
+
+inline double cos(double x) {
+    if (!(std::fabs(x) <= detail::trig_max)) return std::cos(x);
+    double s, c;
+    detail::sincos_reduced(x, s, c);
+    return c;
+}
+
+inline void sincos(double x, double &s, double &c) {
+    if (!(std::fabs(x) <= detail::trig_max)) {
+        s = std::sin(x);
+        c = std::cos(x);
+        return;
+    }
+    detail::sincos_reduced(x, s, c);
+}
+
+inline double tan(double x) {
+    if (!(std::fabs(x) <= detail::trig_max)) return std::tan(x);
+    double s, c;
+    detail::sincos_reduced(x, s, c);
+    return s / c;
+}
+
+inline double atan2(double y, double x) {
+    double a = detail::atan_kernel(y / x);
+    // the other half plane, with the sign of y (+-0 included)
+    bool negative_x = detail::to_bits(x) < 0;
+    double offset = detail::select(negative_x, std::copysign(detail::pi, y), 0.0);
+    double r = detail::select(negative_x, a + offset, a);
+    // atan2(+-0, +-0) and NaNs
+    return detail::select((x == 0.0) & (y == 0.0), std::copysign(offset, y) + y, r);
+}
+
+inline double exp(double x) {
+    double xc = detail::select(x < detail::exp_min, detail::exp_min, x);
+    xc = detail::select(xc > detail::exp_max, detail::exp_max, xc);
+    double r = detail::select(x < detail::exp_min, 0.0, detail::exp_reduced(xc));
+    // NaN falls through every comparison and propagates
+    return detail::select(x > detail::exp_max, HUGE_VAL, r);
+}
+
+inline double tanh(double x) {
+    double ax = detail::select(std::fabs(x) > 20.0, 20.0, std::fabs(x));
+    double large = 1.0 - 2.0 / (detail::exp_reduced(2.0 * ax) + 1.0);
+    return detail::select(ax < 0.625, detail::tanh_small(x), std::copysign(large, x));
+}
+
+/// Batch versions: out[i] = f(x[i]) for i < n. For exp and tanh out may
+/// be x, for the others the arrays must not overlap.
+inline void sin(const double *x, double *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double s, c;
+        detail::sincos_reduced(x[i], s, c);
+        out[i] = s;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!(std::fabs(x[i]) <= detail::trig_max)) out[i] = std::sin(x[i]);
+    }
+}
+
+inline void cos(const double *x, double *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double s, c;
+        detail::sincos_reduced(x[i], s, c);
+        out[i] = c;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!(std::fabs(x[i]) <= detail::trig_max)) out[i] = std::cos(x[i]);
+    }
+}
+
+inline void tan(const double *x, double *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double s, c;
+        detail::sincos_reduced(x[i], s, c);
+        out[i] = s / c;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!(std::fabs(x[i]) <= detail::trig_max)) out[i] = std::tan(x[i]);
+    }
+}
+
+inline void atan2(const double *y, const double *x, double *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = atan2(y[i], x[i]);
+}
+
+inline void exp(const double *x, double *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = exp(x[i]);
+}
+
+inline void tanh(const double *x, double *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = tanh(x[i]);
+}
+
+inline void tanh(const float *x, float *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = static_cast<float>(tanh(static_cast<double>(x[i])));
+}
+
+} // namespace fast_math
+} // namespace scrimmage
+#endif // FASTMATH_H_
@@ -0,0 +1,373 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef FIXEDMLP_H_
+#define FIXEDMLP_H_
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "tiny_dnn/tiny_dnn.h"
+
+#include <scrimmage/math/FastMath.h>
+
+namespace scrimmage {
+
+namespace mlp_detail {
+using float_t = tiny_dnn::float_t;
+using aligned_vec = tiny_dnn::vec_t;
+
+// Layer widths are padded to a whole number of AVX-512 registers
+constexpr size_t padded(size_t n) { return (n + 15) / 16 * 16; }
+
+constexpr size_t max_size(size_t a) { return a; }
+
+template <class... T>
+constexpr size_t max_size(size_t a, size_t b, T... rest) {
+    return max_size(a > b ? a : b, rest...);
+}
+
+constexpr size_t last(size_t a) { return a; }
+
+template <class... T>
+constexpr size_t last(size_t, size_t b, T... rest) { return last(b, rest...); }
+
+// acc[0:N] += w[0:N] * x, with a separate multiply and add so the result is
+// rounded exactly like tiny_dnn's scalar fully connected kernel.
+template <size_t N>
+inline void axpy(float_t *acc, const float_t *w, float_t x) {
+#if defined(__AVX512F__)
+    if (std::is_same<float_t, float>::value) {
+        const __m512 vx = _mm512_set1_ps(x);
+        for (size_t i = 0; i < N; i += 16) {
+            __m512 prod = _mm512_mul_ps(_mm512_load_ps(w + i), vx);
+            _mm512_store_ps(acc + i, _mm512_add_ps(_mm512_load_ps(acc + i), prod));
+        }
+        return;
+    }
+#elif defined(__AVX__)
+    if (std::is_same<float_t, float>::value) {
+        const __m256 vx = _mm256_set1_ps(x);
+        for (size_t i = 0; i < N; i += 8) {
+            __m256 prod = _mm256_mul_ps(_mm256_load_ps(w + i), vx);
+            _mm256_store_ps(acc + i, _mm256_add_ps(_mm256_load_ps(acc + i), prod));
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < N; i++) {
+        acc[i] += w[i] * x;
+    }
+}
+
+/// Fully connected layer with a fused bias + tanh. The input width is set
+/// at load time, the output width is a compile-time constant. Weights are
+/// stored input-major like tiny_dnn (W[c * out + i]) but with each row
+/// padded to an aligned block.
+template <size_t Out>
+class TanhDense {
+ public:
+    static constexpr size_t out_size = Out;
+    static constexpr size_t stride = padded(Out);
+
+    TanhDense() : in_size_(0), W_(), b_(stride, 0) {}
+
+    size_t in_size() const { return in_size_; }
+
+    void set(size_t in_size, const aligned_vec &W, const aligned_vec *b) {
+        in_size_ = in_size;
+        W_.assign(in_size * stride, float_t{0});
+        for (size_t c = 0; c < in_size; c++) {
+            std::memcpy(&W_[c * stride], &W[c * Out], Out * sizeof(float_t));
+        }
+        b_.assign(stride, float_t{0});
+        if (b != nullptr) {
+            std::memcpy(&b_[0], b->data(), Out * sizeof(float_t));
+        }
+    }
+
+    /// out must hold stride values and be 64-byte aligned
+    void forward(const float_t *in, float_t *out, bool fast_math) const {
+        std::fill(out, out + stride, float_t{0});
+        for (size_t c = 0; c < in_size_; c++) {
+            axpy<stride>(out, &W_[c * stride], in[c]);
+        }
+        activate(out, fast_math);
+    }
+
+    /// forward() of rows inputs, row r at in + r * row_stride, output row r
+    /// at out + r * row_stride. Each weight row is loaded once for all the
+    /// inputs, and every output row is summed in the same order as forward().
+    void forward_rows(const float_t *in, float_t *out, size_t rows,
+                      size_t row_stride, bool fast_math) const {
+        for (size_t r = 0; r < rows; r++) {
+            std::fill(out + r * row_stride, out + r * row_stride + stride, float_t{0});
+        }
+        for (size_t c = 0; c < in_size_; c++) {
+            const float_t *w = &W_[c * stride];
+            for (size_t r = 0; r < rows; r++) {
+                axpy<stride>(out + r * row_stride, w, in[r * row_stride + c]);
+            }
+        }
+        for (size_t r = 0; r < rows; r++) {
+            activate(out + r * row_stride, fast_math);
+        }
+    }
+
+ protected:
+    size_t in_size_;
+    aligned_vec W_;
+    aligned_vec b_;
+
+    void activate(float_t *out, bool fast_math) const {
+        if (fast_math) {
+            for (size_t i = 0; i < Out; i++) {
+                out[i] += b_[i];
+            }
+            fast_math::tanh(out, out, Out);
+            return;
+        }
+        for (size_t i = 0; i < Out; i++) {
+            out[i] = std::tanh(out[i] + b_[i]);
+        }
+    }
+};
+} // namespace mlp_detail
+
+/// Inference-only multilayer perceptron whose layers are all
+/// fc -> tanh, with the layer widths fixed at compile time, e.g.
+///
+///   FixedMLP<200, 200, 50, 3> policy;  // fc(N,200) tanh ... fc(50,3) tanh
+///
+/// The input width is taken from the network it is loaded from. Weights are
+/// copied out of a tiny_dnn network (optionally loaded from an nn.dat file),
+/// so the network can still be perturbed with tiny_dnn beforehand. predict()
+/// doesn't allocate and produces the same values as network::predict.
+///
+/// predict_rows() runs several inputs through the same weights at once,
+/// e.g. the entities of a batch of environments that play one policy (see
+/// InferenceBatch). Each row gives exactly what predict() gives for it.
+///
+/// The weights are immutable once loaded and copies share them, only the
+/// scratch buffers are per copy. Copying a loaded FixedMLP is cheap and the
+/// copies can run in different threads. weights() identifies the shared
+/// weights.
+template <size_t... Outs>
+class FixedMLP {
+ public:
+    using float_t = mlp_detail::float_t;
+    using vec_t = tiny_dnn::vec_t;
+
+    static constexpr size_t num_layers = sizeof...(Outs);
+    static constexpr size_t max_width = mlp_detail::padded(mlp_detail::max_size(Outs...));
+    static constexpr size_t out_size = mlp_detail::last(Outs...);
+
+    typedef std::tuple<mlp_detail::TanhDense<Outs>...> Layers;
+
+    FixedMLP() : loaded_(false), fast_math_(false), buf_a_(max_width),
+                 buf_b_(max_width), out_(out_size) {}
+
+    bool loaded() const { return loaded_; }
+
+    /// Use fast_math::tanh for the activations. The outputs then differ
+    /// from network::predict by a few ulp.
+    void set_fast_math(bool fast_math) { fast_math_ = fast_math; }
+    bool fast_math() const { return fast_math_; }
+
+    size_t in_data_size() const {
+        return layers_ ? std::get<0>(*layers_).in_size() : 0;
+    }
+    size_t out_data_size() const { return out_.size(); }
+
+    /// Equal for copies of the same loaded FixedMLP
+    const void *weights() const { return layers_.get(); }
+
+    /// Copies the weights of net. Returns false if its topology isn't
+    /// fc -> tanh repeated with the widths of this type.
+    bool from_network(const tiny_dnn::network<tiny_dnn::sequential> &net) {
+        loaded_ = false;
+        layers_ = nullptr;
+        if (net.depth() != 2 * num_layers) return false;
+
+        // new layers rather than overwriting the ones shared with copies
+        std::shared_ptr<Layers> layers = std::make_shared<Layers>();
+        if (!set_layers(net, *layers, std::integral_constant<size_t, 0>())) {
+            return false;
+        }
+        layers_ = layers;
+        loaded_ = true;
+        return true;
+    }
+
+    /// Loads a tiny_dnn nn.dat file
+    bool load(std::string filename) {
+        tiny_dnn::network<tiny_dnn::sequential> net;
+        try {
+            net.load(filename);
+        } catch (tiny_dnn::nn_error &e) {
+            std::cout << "FixedMLP: failed to load " << filename << ": "
+                      << e.what() << std::endl;
+            return false;
+        }
+        return from_network(net);
+    }
+
+    /// Returns a reference to an internal output buffer, valid until the
+    /// next call
+    const vec_t &predict(const vec_t &in) {
+        assert(in.size() >= in_data_size());
+        return predict(in.data());
+    }
+
+    /// in must hold in_data_size() values
+    const vec_t &predict(const float_t *in) {
+        // the input is copied so that the first layer reads aligned memory
+        std::memcpy(buf_a_.data(), in, in_data_size() * sizeof(float_t));
+        const float_t *result = forward(std::integral_constant<size_t, 0>(),
+                                        buf_a_.data(), buf_b_.data());
+        std::memcpy(out_.data(), result, out_.size() * sizeof(float_t));
+        return out_;
+    }
+
+    /// in holds rows inputs of in_data_size() values, one after the other.
+    /// Returns rows outputs of out_data_size() values in the same layout,
+    /// in an internal buffer valid until the next call.
+    const vec_t &predict_rows(const float_t *in, size_t rows) {
+        const size_t in_size = in_data_size();
+        const size_t width = max_width;
+        const size_t row_stride = std::max(width, mlp_detail::padded(in_size));
+        if (rows_a_.size() < rows * row_stride) {
+            rows_a_.resize(rows * row_stride);
+            rows_b_.resize(rows * row_stride);
+        }
+        for (size_t r = 0; r < rows; r++) {
+            std::memcpy(&rows_a_[r * row_stride], in + r * in_size,
+                        in_size * sizeof(float_t));
+        }
+        const float_t *result = forward_rows(std::integral_constant<size_t, 0>(),
+                                             rows_a_.data(), rows_b_.data(),
+                                             rows, row_stride);
+        rows_out_.resize(rows * out_size);
+        for (size_t r = 0; r < rows; r++) {
+            std::memcpy(&rows_out_[r * out_size], result + r * row_stride,
+                        out_size * sizeof(float_t));
+        }
+        return rows_out_;
+    }
+
+ protected:
+    bool loaded_;
+    bool fast_math_;
+    std::shared_ptr<const Layers> layers_;
+    vec_t buf_a_;
+    vec_t buf_b_;
+    vec_t out_;
+    vec_t rows_a_;
+    vec_t rows_b_;
+    vec_t rows_out_;
+
+    template <size_t I>
+    bool set_layers(const tiny_dnn::network<tiny_dnn::sequential> &net,
+                    Layers &layers, std::integral_constant<size_t, I>) {
+        auto &layer = std::get<I>(layers);
+        const tiny_dnn::layer *fc = net[2 * I];
+        const tiny_dnn::layer *act = net[2 * I + 1];
+
+        if (fc->layer_type() != "fully-connected" ||
+            act->layer_type() != "tanh-activation" ||
+            fc->out_data_size() != layer.out_size) {
+            return false;
+        }
+
+        size_t in_size = fc->in_data_size();
+        if (I > 0 && in_size != prev_out_size(std::integral_constant<size_t, I>())) {
+            return false;
+        }
+
+        std::vector<const vec_t *> w = fc->weights();
+        if (w.empty() || w[0]->size() != in_size * layer.out_size) return false;
+        layer.set(in_size, *w[0], w.size() > 1 ? w[1] : nullptr);
+
+        if (I == 0 && buf_a_.size() < mlp_detail::padded(in_size)) {
+            buf_a_.resize(mlp_detail::padded(in_size));
+        }
+        return set_layers(net, layers, std::integral_constant<size_t, I + 1>());
+    }
+
+    bool set_layers(const tiny_dnn::network<tiny_dnn::sequential> &, Layers &,
+                    std::integral_constant<size_t, num_layers>) {
+        return true;
+    }
+
+    template <size_t I>
+    size_t prev_out_size(std::integral_constant<size_t, I>) {
+        return std::tuple_element<I - 1, Layers>::type::out_size;
+    }
+
+    size_t prev_out_size(std::integral_constant<size_t, 0>) { return 0; }
+
+    // Ping-pong between the two buffers, returns the last output
+    template <size_t I>
+    const float_t *forward(std::integral_constant<size_t, I>,
+                           float_t *in, float_t *out) {
+        std::get<I>(*layers_).forward(in, out, fast_math_);
+        return forward(std::integral_constant<size_t, I + 1>(), out, in);
+    }
+
+    const float_t *forward(std::integral_constant<size_t, num_layers>,
+                           float_t *in, float_t *) {
+        return in;
+    }
+
+    template <size_t I>
+    const float_t *forward_rows(std::integral_constant<size_t, I>, float_t *in,
+                                float_t *out, size_t rows, size_t row_stride) {
+        std::get<I>(*layers_).forward_rows(in, out, rows, row_stride, fast_math_);
+        return forward_rows(std::integral_constant<size_t, I + 1>(), out, in,
+                            rows, row_stride);
+    }
+
+    const float_t *forward_rows(std::integral_constant<size_t, num_layers>,
+                                float_t *in, float_t *, size_t, size_t) {
+        return in;
+    }
+};
+
+} // namespace scrimmage
+#endif
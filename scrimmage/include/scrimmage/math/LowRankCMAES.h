@@ -0,0 +1,103 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef LOWRANKCMAES_H_
+#define LOWRANKCMAES_H_
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+namespace scrimmage {
+
+class Checkpoint;
+
+/// Search distribution of an evolution strategy with a diagonal plus low
+/// rank covariance, for policies with too many weights for a full CMA-ES.
+/// A sample around the mean m is
+///
+///   x = m + sigma * M (D z),  z ~ N(0, I)
+///
+/// where D is diagonal (separable CMA-ES / SNES) and M is the product of
+/// rank transforms built from `rank` evolution paths at different time
+/// scales, as in LM-MA-ES (Loshchilov, Glasmachers and Beyer 2017). sigma
+/// adapts by cumulative step-size adaptation on z.
+///
+/// Only n * (rank + 2) floats are stored. Drawing a sample and updating both
+/// cost O(n * rank), streaming over contiguous vectors. Samples are fully
+/// determined by a seed, so rollouts and the update regenerate the same
+/// noise from the seeds alone.
+class LowRankCMAES {
+ public:
+    typedef tiny_dnn::float_t float_t;
+    typedef tiny_dnn::vec_t vec_t;
+
+    LowRankCMAES();
+
+    /// n weights, lambda samples per generation, sigma the initial step size
+    void init(size_t n, size_t lambda, size_t rank, double sigma);
+
+    size_t size() const { return D_.size(); }
+    size_t rank() const { return paths_.size(); }
+    double sigma() const { return sigma_; }
+    uint64_t generation() const { return t_; }
+    const vec_t &diagonal() const { return D_; }
+
+    /// Adds the sample for seed to theta (the mean). Thread safe.
+    void sample(uint32_t seed, vec_t &theta) const;
+
+    /// Moves the mean theta to the weighted recombination of the samples
+    /// and adapts the distribution. weights (e.g. recombination_weights())
+    /// are non-negative and sum to one; samples with zero weight can be
+    /// left out.
+    void update(vec_t &theta, const std::vector<int32_t> &seeds,
+                const std::vector<double> &weights);
+
+    void save(Checkpoint &checkpoint) const;
+    bool load(Checkpoint &checkpoint);
+
+ protected:
+    size_t lambda_;
+    double sigma_;
+    uint64_t t_;
+    vec_t D_;
+    vec_t p_sigma_;
+    std::vector<vec_t> paths_;
+
+    // z ~ N(0, I) for seed
+    void latent(uint32_t seed, float_t *z) const;
+
+    // v = M v, with the paths that have been updated at least once
+    void transform(float_t *v) const;
+};
+
+typedef std::shared_ptr<LowRankCMAES> LowRankCMAESPtr;
+
+} // namespace scrimmage
+#endif
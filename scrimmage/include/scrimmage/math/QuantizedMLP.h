@@ -0,0 +1,333 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef QUANTIZEDMLP_H_
+#define QUANTIZEDMLP_H_
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <scrimmage/math/FixedMLP.h>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+namespace scrimmage {
+
+enum class MLPPrecision {
+    FLOAT32 = 0,
+    BF16,
+    INT8
+};
+
+/// Parses "float32", "bf16" or "int8" (also "none" for float32)
+inline bool str2precision(std::string str, MLPPrecision &precision) {
+    if (str == "float32" || str == "none" || str == "") {
+        precision = MLPPrecision::FLOAT32;
+    } else if (str == "bf16") {
+        precision = MLPPrecision::BF16;
+    } else if (str == "int8") {
+        precision = MLPPrecision::INT8;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+namespace mlp_detail {
+
+// Round to nearest even, the top 16 bits of the float
+inline uint16_t float2bf16(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    if (std::isnan(f)) return static_cast<uint16_t>((bits >> 16) | 0x40);
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+inline float bf162float(uint16_t h) {
+    uint32_t bits = static_cast<uint32_t>(h) << 16;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// acc[0:N] += float(w[0:N]) * x
+template <size_t N>
+inline void axpy_int8(float *acc, const int8_t *w, float x) {
+#if defined(__AVX2__)
+    const __m256 vx = _mm256_set1_ps(x);
+    for (size_t i = 0; i < N; i += 8) {
+        __m128i w8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(w + i));
+        __m256 wf = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(w8));
+        _mm256_store_ps(acc + i, _mm256_add_ps(_mm256_load_ps(acc + i),
+                                               _mm256_mul_ps(wf, vx)));
+    }
+#else
+    for (size_t i = 0; i < N; i++) {
+        acc[i] += static_cast<float>(w[i]) * x;
+    }
+#endif
+}
+
+template <size_t N>
+inline void axpy_bf16(float *acc, const uint16_t *w, float x) {
+#if defined(__AVX2__)
+    const __m256 vx = _mm256_set1_ps(x);
+    for (size_t i = 0; i < N; i += 8) {
+        __m128i w16 = _mm_load_si128(reinterpret_cast<const __m128i *>(w + i));
+        __m256 wf = _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_cvtepu16_epi32(w16), 16));
+        _mm256_store_ps(acc + i, _mm256_add_ps(_mm256_load_ps(acc + i),
+                                               _mm256_mul_ps(wf, vx)));
+    }
+#else
+    for (size_t i = 0; i < N; i++) {
+        acc[i] += bf162float(w[i]) * x;
+    }
+#endif
+}
+
+/// fc + tanh layer with int8 (one symmetric scale per layer) or bfloat16
+/// weights. Activations, biases and accumulation stay in fp32.
+template <size_t Out>
+class QuantizedTanhDense {
+ public:
+    static constexpr size_t out_size = Out;
+    static constexpr size_t stride = padded(Out);
+
+    QuantizedTanhDense() : in_size_(0), precision_(MLPPrecision::INT8),
+                           scale_(1), b_(stride, 0) {}
+
+    size_t in_size() const { return in_size_; }
+    float scale() const { return scale_; }
+
+    void set(size_t in_size, const tiny_dnn::vec_t &W,
+             const tiny_dnn::vec_t *b, MLPPrecision precision) {
+        in_size_ = in_size;
+        precision_ = precision;
+
+        if (precision_ == MLPPrecision::INT8) {
+            float max_abs = 0;
+            for (size_t j = 0; j < in_size * Out; j++) {
+                max_abs = std::max(max_abs, std::abs(static_cast<float>(W[j])));
+            }
+            scale_ = max_abs > 0 ? max_abs / 127.0f : 1.0f;
+
+            W8_.assign(in_size * stride, 0);
+            for (size_t c = 0; c < in_size; c++) {
+                for (size_t i = 0; i < Out; i++) {
+                    long q = std::lround(W[c * Out + i] / scale_);
+                    W8_[c * stride + i] = static_cast<int8_t>(std::max(-127L, std::min(127L, q)));
+                }
+            }
+        } else {
+            scale_ = 1;
+            W16_.assign(in_size * stride, 0);
+            for (size_t c = 0; c < in_size; c++) {
+                for (size_t i = 0; i < Out; i++) {
+                    W16_[c * stride + i] = float2bf16(W[c * Out + i]);
+                }
+            }
+        }
+
+        b_.assign(stride, 0);
+        if (b != nullptr) {
+            for (size_t i = 0; i < Out; i++) b_[i] = (*b)[i];
+        }
+    }
+
+    /// out must hold stride values and be 32-byte aligned
+    void forward(const float *in, float *out) const {
+        std::fill(out, out + stride, 0.0f);
+        if (precision_ == MLPPrecision::INT8) {
+            for (size_t c = 0; c < in_size_; c++) {
+                axpy_int8<stride>(out, &W8_[c * stride], in[c]);
+            }
+        } else {
+            for (size_t c = 0; c < in_size_; c++) {
+                axpy_bf16<stride>(out, &W16_[c * stride], in[c]);
+            }
+        }
+        for (size_t i = 0; i < Out; i++) {
+            out[i] = std::tanh(out[i] * scale_ + b_[i]);
+        }
+    }
+
+ protected:
+    size_t in_size_;
+    MLPPrecision precision_;
+    float scale_;
+    std::vector<int8_t, tiny_dnn::aligned_allocator<int8_t, 64>> W8_;
+    std::vector<uint16_t, tiny_dnn::aligned_allocator<uint16_t, 64>> W16_;
+    std::vector<float, tiny_dnn::aligned_allocator<float, 64>> b_;
+};
+} // namespace mlp_detail
+
+/// Quantized counterpart of FixedMLP for inference-only runs (playback of
+/// learned policies, test generations). Weights are stored as int8 with a
+/// per-layer scale (4x smaller than float) or as bfloat16 (2x smaller), so
+/// the policy of a whole swarm stays in cache.
+template <size_t... Outs>
+class QuantizedMLP {
+ public:
+    using vec_t = std::vector<float, tiny_dnn::aligned_allocator<float, 64>>;
+
+    static constexpr size_t num_layers = sizeof...(Outs);
+    static constexpr size_t max_width = mlp_detail::padded(mlp_detail::max_size(Outs...));
+    static constexpr size_t out_size = mlp_detail::last(Outs...);
+
+    QuantizedMLP() : loaded_(false), precision_(MLPPrecision::INT8),
+                     buf_a_(max_width), buf_b_(max_width), out_(out_size) {
+        static_assert(std::is_same<tiny_dnn::float_t, float>::value,
+                      "QuantizedMLP requires tiny_dnn built with float");
+    }
+
+    bool loaded() const { return loaded_; }
+    MLPPrecision precision() const { return precision_; }
+
+    size_t in_data_size() const { return std::get<0>(layers_).in_size(); }
+    size_t out_data_size() const { return out_.size(); }
+
+    /// Quantizes the weights of net. precision must be BF16 or INT8.
+    bool from_network(const tiny_dnn::network<tiny_dnn::sequential> &net,
+                      MLPPrecision precision) {
+        loaded_ = false;
+        precision_ = precision;
+        if (precision_ == MLPPrecision::FLOAT32) return false;
+        if (net.depth() != 2 * num_layers) return false;
+        loaded_ = set_layers(net, std::integral_constant<size_t, 0>());
+        return loaded_;
+    }
+
+    const vec_t &predict(const tiny_dnn::vec_t &in) {
+        assert(in.size() >= in_data_size());
+        std::memcpy(buf_a_.data(), in.data(), in_data_size() * sizeof(float));
+        const float *result = forward(std::integral_constant<size_t, 0>(),
+                                      buf_a_.data(), buf_b_.data());
+        std::memcpy(out_.data(), result, out_.size() * sizeof(float));
+        return out_;
+    }
+
+ protected:
+    bool loaded_;
+    MLPPrecision precision_;
+    std::tuple<mlp_detail::QuantizedTanhDense<Outs>...> layers_;
+    vec_t buf_a_;
+    vec_t buf_b_;
+    vec_t out_;
+
+    template <size_t I>
+    bool set_layers(const tiny_dnn::network<tiny_dnn::sequential> &net,
+                    std::integral_constant<size_t, I>) {
+        auto &layer = std::get<I>(layers_);
+        const tiny_dnn::layer *fc = net[2 * I];
+        const tiny_dnn::layer *act = net[2 * I + 1];
+
+        if (fc->layer_type() != "fully-connected" ||
+            act->layer_type() != "tanh-activation" ||
+            fc->out_data_size() != layer.out_size) {
+            return false;
+        }
+
+        size_t in_size = fc->in_data_size();
+        std::vector<const tiny_dnn::vec_t *> w = fc->weights();
+        if (w.empty() || w[0]->size() != in_size * layer.out_size) return false;
+        layer.set(in_size, *w[0], w.size() > 1 ? w[1] : nullptr, precision_);
+
+        if (I == 0 && buf_a_.size() < mlp_detail::padded(in_size)) {
+            buf_a_.resize(mlp_detail::padded(in_size));
+        }
+        return set_layers(net, std::integral_constant<size_t, I + 1>());
+    }
+
+    bool set_layers(const tiny_dnn::network<tiny_dnn::sequential> &,
+                    std::integral_constant<size_t, num_layers>) {
+        return true;
+    }
+
+    template <size_t I>
+    const float *forward(std::integral_constant<size_t, I>, float *in, float *out) {
+        std::get<I>(layers_).forward(in, out);
+        return forward(std::integral_constant<size_t, I + 1>(), out, in);
+    }
+
+    const float *forward(std::integral_constant<size_t, num_layers>, float *in, float *) {
+        return in;
+    }
+};
+
+/// Accumulates the error of a quantized policy against the float policy
+class QuantizationReport {
+ public:
+    QuantizationReport() : samples_(0), outputs_(0), max_abs_error_(0),
+                           sum_abs_error_(0), sum_sq_error_(0) {}
+
+    template <class V1, class V2>
+    void add(const V1 &reference, const V2 &quantized) {
+        samples_++;
+        for (size_t i = 0; i < reference.size() && i < quantized.size(); i++) {
+            double err = std::abs(static_cast<double>(reference[i]) - quantized[i]);
+            max_abs_error_ = std::max(max_abs_error_, err);
+            sum_abs_error_ += err;
+            sum_sq_error_ += err * err;
+            outputs_++;
+        }
+    }
+
+    size_t samples() const { return samples_; }
+    double max_abs_error() const { return max_abs_error_; }
+    double mean_abs_error() const { return outputs_ ? sum_abs_error_ / outputs_ : 0; }
+    double rms_error() const { return outputs_ ? std::sqrt(sum_sq_error_ / outputs_) : 0; }
+
+    void print(std::ostream &out, std::string name) const {
+        out << name << " quantization error over " << samples_ << " samples: "
+            << "max " << max_abs_error() << ", mean " << mean_abs_error()
+            << ", rms " << rms_error() << std::endl;
+    }
+
+ protected:
+    size_t samples_;
+    size_t outputs_;
+    double max_abs_error_;
+    double sum_abs_error_;
+    double sum_sq_error_;
+};
+
+} // namespace scrimmage
+#endif
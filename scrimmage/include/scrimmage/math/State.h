@@ -30,6 +30,8 @@
 
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <scrimmage/math/Quaternion.h>
 #include <scrimmage/math/Angles.h>
@@ -40,6 +42,8 @@ class State {
  public:
     State();
     State(Eigen::Vector3d _pos, Eigen::Vector3d _vel, Quaternion _quat);
+    State(const State &other);
+    State &operator=(const State &other);
 
     Eigen::Vector3d &pos();
     Eigen::Vector3d &vel();
@@ -53,6 +57,21 @@ class State {
     void set_vel(const Eigen::Vector3d &vel);
     void set_quat(const Quaternion &quat);
 
+    /*! \name orientation
+     * Euler angles and rotation of quat(). They are computed the first time
+     * they are asked for after quat() changes and cached until it changes
+     * again, so a state read by many plugins in a tick (e.g., as a contact)
+     * computes them once. Safe to call from several threads.
+     */
+    ///@{
+    double roll() const;
+    double pitch() const;
+    double yaw() const;
+
+    /*! \brief rotation from the body frame to the world frame */
+    Eigen::Matrix3d rotation() const;
+    ///@}
+
     /*! \brief Returns true if other state is in field-of-view */
     bool InFieldOfView(State &other, double fov_width, double fov_height);
 
@@ -76,10 +95,59 @@ class State {
     Eigen::Vector3d pos_;
     Eigen::Vector3d vel_;
     Quaternion quat_;
+
+    // The coefficients of quat_ the cache was computed for, followed by
+    // roll, pitch, yaw and the rotation matrix in row-major order.
+    // cache_seq_ is odd while a thread writes the cache.
+    enum {CACHE_KEY = 0, CACHE_VALUES = 4, NUM_CACHE_VALUES = 12};
+    bool read_cache(int first, int count, double *values) const;
+    void update_cache(double *values) const;
+    void clear_cache();
+    mutable std::atomic<uint32_t> cache_seq_;
+    mutable std::atomic<double> cache_[CACHE_VALUES + NUM_CACHE_VALUES];
 };
 
 using StatePtr = std::shared_ptr<State>;
 
+// The cache is read like a seqlock: the values are only used if no thread
+// wrote it while they were copied
+inline bool State::read_cache(int first, int count, double *values) const {
+    uint32_t seq = cache_seq_.load(std::memory_order_acquire);
+    if ((seq & 1) != 0 ||
+        cache_[CACHE_KEY].load(std::memory_order_relaxed) != quat_.w() ||
+        cache_[CACHE_KEY + 1].load(std::memory_order_relaxed) != quat_.x() ||
+        cache_[CACHE_KEY + 2].load(std::memory_order_relaxed) != quat_.y() ||
+        cache_[CACHE_KEY + 3].load(std::memory_order_relaxed) != quat_.z()) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        values[i] = cache_[CACHE_VALUES + first + i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return cache_seq_.load(std::memory_order_relaxed) == seq;
+}
+
+inline double State::roll() const {
+    double values[NUM_CACHE_VALUES];
+    if (read_cache(0, 1, values)) return values[0];
+    update_cache(values);
+    return values[0];
+}
+
+inline double State::pitch() const {
+    double values[NUM_CACHE_VALUES];
+    if (read_cache(1, 1, values)) return values[0];
+    update_cache(values);
+    return values[1];
+}
+
+inline double State::yaw() const {
+    double values[NUM_CACHE_VALUES];
+    if (read_cache(2, 1, values)) return values[0];
+    update_cache(values);
+    return values[2];
+}
+
 };
 
 #endif  // STATE_H_
@@ -45,9 +45,15 @@ class Metrics : public Plugin{
     virtual std::string name();
     virtual void init();
     virtual void init(std::map<std::string,std::string> &params);
+
+    // Called instead of init() when SimControl is reused for another
+    // rollout, see SimControl::reset(). Returns false if the plugin doesn't
+    // support it.
+    virtual bool reset(std::map<std::string,std::string> &params);
     virtual bool step_metrics(double t, double dt);
     
     void set_team_lookup(std::shared_ptr<std::unordered_map<int,int> > &lookup);
+    void set_entity_index(EntityIndexPtr &entity_index);
 
     virtual void calc_team_scores();
     virtual void print_team_summaries();
@@ -65,6 +71,7 @@ class Metrics : public Plugin{
  protected:
     std::string weights_file_;
     std::shared_ptr<std::unordered_map<int,int> > team_lookup_;
+    EntityIndexPtr entity_index_;
     std::map<int, std::map<std::string, double>> team_metrics_;
     std::map<int, double> team_scores_;
     std::list<std::string> headers_;
@@ -36,6 +36,8 @@ namespace scrimmage {
 class Controller : public Plugin {
  public:
     virtual void init(std::map<std::string, std::string> &params) = 0;
+    // see Entity::reset()
+    virtual bool reset(std::map<std::string, std::string> &params) { return false; }
     virtual bool step(double t, double dt) = 0;
     inline void set_state(StatePtr &state) {state_ = state;}
     inline void set_desired_state(StatePtr &desired_state) {desired_state_ = desired_state;}
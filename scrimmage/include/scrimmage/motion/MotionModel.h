@@ -49,6 +49,12 @@ class MotionModel : public Plugin {
     virtual bool init(std::map<std::string, std::string> &info,
                       std::map<std::string, std::string> &params);
 
+    // Called instead of init() when the entity is reused for another
+    // rollout, see Entity::reset(). Returns false if the plugin doesn't
+    // support it.
+    virtual bool reset(std::map<std::string, std::string> &info,
+                       std::map<std::string, std::string> &params);
+
     virtual bool step(double time, double dt);
     virtual bool posthumous(double t);
     virtual StatePtr &state();
@@ -57,6 +63,10 @@ class MotionModel : public Plugin {
     virtual void set_external_force(Eigen::Vector3d force);
     virtual void set_mass(double mass) { mass_ = mass; }
     virtual double mass() { return mass_; }
+
+    // saves x_ as well
+    virtual void save_state(Snapshot &snapshot, const std::string &prefix);
+    virtual bool restore_state(const Snapshot &snapshot, const std::string &prefix);
     
  protected:
     
@@ -0,0 +1,92 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef SOCKETCHANNEL_H_
+#define SOCKETCHANNEL_H_
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace scrimmage {
+
+class Checkpoint;
+
+/// Length-prefixed messages over a stream socket. Addresses are
+/// "tcp:host:port" or "unix:/path/to/socket".
+class SocketChannel {
+ public:
+    /// A received length over this closes the channel, it can only come
+    /// from a peer that isn't a SocketChannel
+    static constexpr uint64_t max_message_size = 256 << 20;
+
+    SocketChannel();
+    ~SocketChannel();
+
+    SocketChannel(const SocketChannel &) = delete;
+    SocketChannel &operator=(const SocketChannel &) = delete;
+
+    /// Retries until the server is up or timeout seconds have passed.
+    bool connect(std::string address, double timeout = 30);
+    void close();
+    bool is_open() const;
+
+    bool send(const std::string &msg);
+    bool recv(std::string &msg);
+
+    bool send(const Checkpoint &msg);
+    bool recv(Checkpoint &msg);
+
+ protected:
+    friend class SocketServer;
+    int fd_;
+};
+
+class SocketServer {
+ public:
+    SocketServer();
+    ~SocketServer();
+
+    SocketServer(const SocketServer &) = delete;
+    SocketServer &operator=(const SocketServer &) = delete;
+
+    /// A tcp port of 0 picks a free port, see address().
+    bool listen(std::string address);
+    bool accept(SocketChannel &channel);
+    void close();
+
+    /// The bound address, with the actual port for tcp
+    std::string address() const;
+
+ protected:
+    int fd_;
+    std::string address_;
+    std::string unix_path_;
+};
+
+using SocketChannelPtr = std::shared_ptr<SocketChannel>;
+} // namespace scrimmage
+#endif
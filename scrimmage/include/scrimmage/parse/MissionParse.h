@@ -78,6 +78,11 @@ public:
     bool parse(std::string filename);
     bool write(std::string filename);
 
+    // Copy of an already parsed mission, so repeated runs of the same
+    // mission don't re-read the file. The terrain is copied since SimControl
+    // modifies it; the projection is shared.
+    std::shared_ptr<MissionParse> clone() const;
+
     double t0();
     double tend();
     double dt();
@@ -29,6 +29,7 @@
 #define PLUGIN_H_
 #include <memory>
 #include <map>
+#include <string>
 
 #include <scrimmage/fwd_decl.h>
 
@@ -59,6 +60,8 @@ public:
     void stop_publishing(PublisherPtr &pub);
     SubscriberPtr create_subscriber(std::string topic);
     void stop_subscribing(SubscriberPtr &sub);
+    // stops all of the plugin's publishers and subscribers
+    void stop_networking();
 
     void publish(double t, PublisherPtr pub, MessageBasePtr msg);
     void publish_immediate(double t, PublisherPtr pub, MessageBasePtr msg);
@@ -66,8 +69,38 @@ public:
     void clear_subscribers();
     int get_network_id() {return network_id_;}
 
+    // Rate (Hz) at which the simulation steps the plugin, from its
+    // "loop_rate" parameter. 0 steps it every time step.
+    void set_loop_rate(double loop_rate);
+    double loop_rate();
+
+    // The number of time steps between steps of the plugin, set by
+    // SimControl from the loop rate. The plugin steps on the time steps
+    // that are multiples of it.
+    void set_loop_period(int loop_period);
+    int loop_period();
+    bool loop_due(unsigned int time_step) { return time_step % loop_period_ == 0; }
+
+    // The number of time steps since the plugin's previous step, when it
+    // steps on time_step. That is the loop period on the steps it is due.
+    // The final step of a simulation steps every plugin, and a plugin that
+    // isn't due then last stepped time_step % loop_period steps earlier.
+    unsigned int loop_steps(unsigned int time_step) {
+        unsigned int since_due = time_step % loop_period_;
+        return since_due == 0 ? loop_period_ : since_due;
+    }
+
+    // Snapshots of a running simulation, see SimControl::snapshot(). The
+    // base versions save the messages waiting in the plugin's publishers
+    // and subscribers. Plugins whose members change during a run extend
+    // them, saving under keys that start with prefix.
+    virtual void save_state(Snapshot &snapshot, const std::string &prefix);
+    virtual bool restore_state(const Snapshot &snapshot, const std::string &prefix);
+
 protected:    
     int network_id_;
+    double loop_rate_;
+    int loop_period_;
     static int plugin_count_;
     std::weak_ptr<Entity> parent_;
     NetworkPtr network_;    
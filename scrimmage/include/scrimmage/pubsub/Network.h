@@ -31,6 +31,7 @@
 #include <map>
 #include <memory>
 #include <list>
+#include <set>
 #include <scrimmage/fwd_decl.h>
 #include <scrimmage/plugin_manager/Plugin.h>
 
@@ -51,8 +52,19 @@ class Network : public Plugin {
     void rm_publisher(int id, PublisherPtr pub, std::string &topic);
     void rm_subscriber(int id, SubscriberPtr sub, std::string &topic);
     void clear_subscriber_msgs();
+    // Keeps the messages of the plugins in held_ids, which haven't stepped
+    // since they were delivered
+    void clear_subscriber_msgs(const std::set<int> &held_ids);
+    void clear_publisher_msgs();
     RTreePtr &rtree();
 
+    // Memory for the simulation's messages and shapes
+    ArenaPtr &arena();
+    // Replaces the arena of the network and of its publishers and
+    // subscribers, dropping their queued messages. The old arena is
+    // released with the last of its blocks.
+    void reset_arena();
+
     std::map<std::string, std::map<int, std::list<SubscriberPtr>>> &sub_map();
 
  protected:
@@ -61,6 +73,7 @@ class Network : public Plugin {
     std::map<std::string, std::map<int, std::list<PublisherPtr>>> pub_map_; 
     std::map<std::string, std::map<int, std::list<SubscriberPtr>>> sub_map_;
     RTreePtr rtree_;
+    ArenaPtr arena_;
 
 };
 
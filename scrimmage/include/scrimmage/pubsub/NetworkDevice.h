@@ -34,6 +34,7 @@
 #include <list>
 #include <memory>
 #include <scrimmage/fwd_decl.h>
+#include <scrimmage/common/Arena.h>
 #include <scrimmage/pubsub/MessageBase.h>
 #include <type_traits>
 #include <google/protobuf/message.h>
@@ -55,13 +56,23 @@ template <class T> bool construct_msg(MessageBasePtr msg, T msg_cast) {
 }
 template <> inline bool construct_msg<MessageBasePtr>(MessageBasePtr msg, MessageBasePtr msg_cast) {return false;}
 
+// Queued messages, with the nodes allocated from the simulation's arena
+using MessageList = std::list<MessageBasePtr, ArenaAllocator<MessageBasePtr>>;
+
 class NetworkDevice {
  public:
     inline std::string get_topic() const {return topic_;}
     inline void set_topic(std::string topic) {topic_ = topic;}
 
-    inline std::list<MessageBasePtr> &msg_list() {return msg_list_;}
-    inline void set_msg_list(std::list<MessageBasePtr> msg_list) {msg_list_ = msg_list;}
+    inline MessageList &msg_list() {return msg_list_;}
+    inline void set_msg_list(MessageList msg_list) {msg_list_ = msg_list;}
+
+    // Drops the queued messages
+    inline void set_arena(ArenaPtr arena) {
+        msg_list_ = MessageList(ArenaAllocator<MessageBasePtr>(arena.get()));
+        arena_ = arena;
+    }
+    inline const ArenaPtr &arena() const { return arena_; }
 
     inline void set_max_queue_size(unsigned int size) { max_queue_size_ = size; }
     inline unsigned int max_queue_size() { return max_queue_size_; }
@@ -120,7 +131,8 @@ class NetworkDevice {
 
  protected:
     std::string topic_;
-    std::list<MessageBasePtr> msg_list_;
+    MessageList msg_list_;
+    ArenaPtr arena_;
     std::weak_ptr<Plugin> plugin_;
     unsigned int max_queue_size_;
 };
@@ -37,6 +37,8 @@ namespace scrimmage {
 class Sensable : public Plugin {
  public:
     virtual inline void init(std::map<std::string,std::string> &params) {return;}
+    // see Entity::reset()
+    virtual inline bool reset(std::map<std::string,std::string> &params) {return false;}
     virtual inline bool update(double t, double dt) {return true;}
  protected:     
 };
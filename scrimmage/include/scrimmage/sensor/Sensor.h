@@ -39,6 +39,8 @@ namespace scrimmage {
 class Sensor : public Plugin {
  public:
     virtual inline void init(std::map<std::string,std::string> &params) {return;}
+    // see Entity::reset()
+    virtual inline bool reset(std::map<std::string,std::string> &params) {return false;}
     virtual inline bool sense(double t, double dt) {return true;}
     inline ContactMapPtr &contacts() {return contacts_;}
     inline RTreePtr &rtree() {return rtree_;}
@@ -0,0 +1,85 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef BATCHSIMCONTROL_H_
+#define BATCHSIMCONTROL_H_
+#include <thread>
+#include <vector>
+
+#include <scrimmage/fwd_decl.h>
+
+namespace scrimmage {
+
+class SimControl;
+
+/// Steps several simulations on one thread. Every time step, each
+/// environment that hasn't ended runs its sensors and autonomies
+/// (SimControl::run_step_autonomies()), then the forward passes the
+/// autonomies deferred to the batch's InferenceBatch run together, one
+/// multi-row pass per set of policy weights, then each environment finishes
+/// its step (SimControl::run_step_motion()). Rows only share a pass when
+/// they share weights, e.g. the league opponent every rollout plays against;
+/// rollouts with their own perturbed weights still get one pass each. The
+/// rest of the plugins run one entity at a time.
+///
+/// Environments keep their own entities, spatial index, network and
+/// contacts, so they can't see each other, and each ends bit-identical to a
+/// run on its own thread: a batched forward pass gives each row exactly what
+/// predict() would.
+///
+/// Grouping many short rollouts this way uses one thread per batch instead
+/// of one per rollout. That keeps the number of threads at the number of
+/// cores, and the weights of a shared policy are read once per step for the
+/// whole batch. The environments should run without a time warp, since each
+/// one waits for its own loop timer.
+class BatchSimControl {
+ public:
+    BatchSimControl();
+
+    /// Adds an environment, after its init() and instead of its start().
+    /// The BatchSimControl doesn't own it. The environment's entities defer
+    /// their forward passes to inference_batch() from now on.
+    void add(SimControl *env);
+    std::vector<SimControl*> &envs();
+    InferenceBatchPtr inference_batch();
+
+    void start();
+    void run();
+    void join();
+
+    /// Whether every environment has finished
+    bool finished();
+
+ protected:
+    std::vector<SimControl*> envs_;
+    InferenceBatchPtr inference_batch_;
+    std::thread thread_;
+};
+
+typedef std::shared_ptr<BatchSimControl> BatchSimControlPtr;
+} // namespace scrimmage
+#endif
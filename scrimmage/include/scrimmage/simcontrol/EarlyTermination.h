@@ -0,0 +1,81 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef EARLYTERMINATION_H_
+#define EARLYTERMINATION_H_
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <scrimmage/fwd_decl.h>
+
+namespace scrimmage {
+
+struct TeamInfo;
+
+/// Predicates that stop a rollout before the mission's end_condition once
+/// its outcome can no longer change. SimControl checks them after every
+/// time step. The metrics keep the values they had at that step.
+///
+/// Set from the mission file with a comma separated list of
+/// name[:arg[:arg]] entries:
+///   <early_termination>team_eliminated:1, bases_unreachable:30</early_termination>
+class EarlyTermination {
+ public:
+    typedef std::function<bool(double t, std::list<EntityPtr> &ents)> Predicate;
+
+    EarlyTermination();
+
+    void add(std::string name, Predicate predicate);
+    void clear();
+    bool empty() const;
+
+    /// Adds the predicates in str. Returns false for an unknown predicate
+    /// or a missing argument.
+    bool parse(std::string str, MissionParsePtr mp);
+
+    /// Returns true if any predicate holds. reason() is then its name.
+    bool check(double t, std::list<EntityPtr> &ents);
+    const std::string &reason() const;
+
+    /// No entity of team_id is left.
+    static Predicate team_eliminated(int team_id);
+
+    /// No entity can reach a base of another team, flying straight at
+    /// max_speed, before tend. Only valid when the score can't change
+    /// without reaching a base.
+    static Predicate bases_unreachable(std::map<int, TeamInfo> &team_info,
+                                       double tend, double max_speed);
+
+ protected:
+    std::list<std::pair<std::string, Predicate>> predicates_;
+    std::string reason_;
+};
+} // namespace scrimmage
+#endif
@@ -0,0 +1,76 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef ENTITYINDEX_H_
+#define ENTITYINDEX_H_
+#include <vector>
+#include <memory>
+
+#include <scrimmage/fwd_decl.h>
+
+namespace scrimmage {
+
+/// Dense lookup from entity ID to entity, maintained by SimControl as
+/// entities are generated and removed. Entity IDs are handed out
+/// sequentially, so the ID is used directly as an offset into a vector
+/// instead of building a map every time step. Each entity also has a
+/// "slot" in a contiguous array of active entities that can be used to
+/// index per-entity data owned by plugins.
+class EntityIndex {
+ public:
+    EntityIndex();
+
+    void clear();
+    void reserve(int num_entities);
+
+    void add(EntityPtr &ent);
+    void remove(int id);
+
+    /// Returns true if an active entity with this ID exists.
+    bool count(int id) const;
+
+    /// Returns the entity with this ID, or a null pointer if it doesn't
+    /// exist. Only reads the index, so autonomies may call it concurrently.
+    const EntityPtr &at(int id) const;
+
+    /// Returns the slot of the entity in entities(), or -1 if it doesn't
+    /// exist. Slots are not stable across removals.
+    int slot(int id) const;
+
+    std::vector<EntityPtr> &entities();
+    int size() const;
+
+ protected:
+    // Key: Entity ID
+    // Value: slot in ents_ (-1 when not present)
+    std::vector<int> slots_;
+    std::vector<EntityPtr> ents_;
+};
+
+using EntityIndexPtr = std::shared_ptr<EntityIndex>;
+} // namespace scrimmage
+#endif
@@ -49,6 +49,13 @@ class EntityInteraction : public Plugin {
                       std::map<std::string,std::string> &plugin_params) 
     { return true;}
 
+    // Called instead of init() when SimControl is reused for another
+    // rollout, see SimControl::reset(). Returns false if the plugin doesn't
+    // support it.
+    inline virtual bool reset(std::map<std::string,std::string> &mission_params,
+                              std::map<std::string,std::string> &plugin_params)
+    { return false; }
+
     inline virtual std::string name()
     { return std::string("EntityInteraction"); }
     
@@ -74,6 +81,9 @@ class EntityInteraction : public Plugin {
 
     inline void set_team_lookup(std::shared_ptr<std::unordered_map<int,int> > &lookup)
     { team_lookup_ = lookup; }
+
+    inline void set_entity_index(EntityIndexPtr &entity_index)
+    { entity_index_ = entity_index; }
     
  protected:        
     std::shared_ptr<GeographicLib::LocalCartesian> proj_;
@@ -82,6 +92,7 @@ class EntityInteraction : public Plugin {
     RandomPtr random_;
     MissionParsePtr mp_;
     std::shared_ptr<std::unordered_map<int,int> > team_lookup_;
+    EntityIndexPtr entity_index_;
 };
 
 typedef std::shared_ptr<EntityInteraction> EntityInteractionPtr;
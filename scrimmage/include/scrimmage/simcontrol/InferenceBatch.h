@@ -0,0 +1,123 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef INFERENCEBATCH_H_
+#define INFERENCEBATCH_H_
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace scrimmage {
+
+/// Policy forward passes collected from the autonomies of one time step and
+/// run together. BatchSimControl steps the autonomies of all its
+/// environments first, then run(), then the controllers and motion models,
+/// so one forward pass serves every entity of the batch that plays the same
+/// policy, e.g. the league opponent all the rollouts play against.
+///
+/// An autonomy that finds an InferenceBatch on its entity adds its input to
+/// the queue of its model instead of predicting, and sets its desired state
+/// in the callback, which run() calls before any controller steps. Model is
+/// a FixedMLP or has the same float_t, vec_t, weights(), fast_math(),
+/// in_data_size(), out_data_size() and predict_rows().
+class InferenceBatch {
+ public:
+    template <class Model>
+    class Queue;
+
+    /// The queue of the weights of model, which is copied on first use
+    template <class Model>
+    Queue<Model> &queue(const Model &model);
+
+    /// Runs and empties every queue, in the order they were first used.
+    /// Queues nothing was added to since the last run() are dropped, with
+    /// their copy of the weights.
+    void run();
+
+ protected:
+    struct QueueBase {
+        virtual ~QueueBase() {}
+        virtual bool empty() const = 0;
+        virtual void run() = 0;
+        const void *weights;
+        bool fast_math;
+    };
+    std::vector<std::unique_ptr<QueueBase>> queues_;
+};
+
+template <class Model>
+class InferenceBatch::Queue : public InferenceBatch::QueueBase {
+ public:
+    typedef typename Model::float_t float_t;
+    typedef typename Model::vec_t vec_t;
+    typedef std::function<void(const vec_t &out)> Callback;
+
+    explicit Queue(const Model &model) : model_(model) {
+        weights = model.weights();
+        fast_math = model.fast_math();
+    }
+
+    /// in holds the model's in_data_size() values and is copied
+    void add(const float_t *in, Callback done) {
+        in_.insert(in_.end(), in, in + model_.in_data_size());
+        done_.push_back(std::move(done));
+    }
+
+    bool empty() const override { return done_.empty(); }
+
+    void run() override {
+        const size_t n = model_.out_data_size();
+        const vec_t &out = model_.predict_rows(in_.data(), done_.size());
+        for (size_t r = 0; r < done_.size(); r++) {
+            row_.assign(out.begin() + r * n, out.begin() + (r + 1) * n);
+            done_[r](row_);
+        }
+        in_.clear();
+        done_.clear();
+    }
+
+ protected:
+    Model model_;
+    vec_t in_;
+    vec_t row_;
+    std::vector<Callback> done_;
+};
+
+template <class Model>
+InferenceBatch::Queue<Model> &InferenceBatch::queue(const Model &model) {
+    for (std::unique_ptr<QueueBase> &q : queues_) {
+        if (q->weights == model.weights() && q->fast_math == model.fast_math()) {
+            return static_cast<Queue<Model> &>(*q);
+        }
+    }
+    queues_.emplace_back(new Queue<Model>(model));
+    return static_cast<Queue<Model> &>(*queues_.back());
+}
+
+using InferenceBatchPtr = std::shared_ptr<InferenceBatch>;
+} // namespace scrimmage
+#endif
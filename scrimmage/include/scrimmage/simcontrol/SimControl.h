@@ -27,6 +27,7 @@
 /// ---------------------------------------------------------------------------
 #ifndef SIMCONTROL_H_
 #define SIMCONTROL_H_
+#include <functional>
 #include <string>
 #include <thread>
 #include <map>
@@ -34,9 +35,13 @@
 #include <mutex>
 #include <vector>
 
+#include <Eigen/Dense>
+
 #include <scrimmage/fwd_decl.h>
 #include <scrimmage/network/Interface.h>
+#include <scrimmage/common/FileSearch.h>
 #include <scrimmage/common/Timer.h>
+#include <scrimmage/simcontrol/EarlyTermination.h>
 
 #include <future>
 #include <memory>
@@ -68,9 +73,47 @@ class SimControl {
  public:
     SimControl();
     bool init();
+
+    /// Readies a SimControl whose run has finished for another rollout,
+    /// in place of init(). Set the next rollout's mission parse, log and
+    /// interfaces first. The mission has to have the same entities, entity
+    /// interactions and metrics, its seed and parameters can differ. The
+    /// network, entity interactions and metrics are kept and reset(), and
+    /// with the mission's recycle_entities parameter so are the entities
+    /// of the last rollout, saving the plugins' construction and parsing.
+    /// Entities whose plugins don't support reset() are built again.
+    /// Returns false if an entity interaction or metrics plugin doesn't;
+    /// the rollout then needs a new SimControl. Predicates added to
+    /// early_termination() have to be added again. Each rollout's messages
+    /// come from an arena of its own, see Network::reset_arena().
+    bool reset();
     void start();
     void display_progress(bool enable);
     void run();
+
+    /// run() in three parts, for stepping the simulation from outside
+    /// (BatchSimControl): run_start() once, then run_step() for every time
+    /// step until it returns false, then run_finish().
+    void run_start();
+    bool run_step();
+    void run_finish();
+
+    /// run_step() is run_step_autonomies(), then the inference batch, then
+    /// run_step_motion(), which returns what run_step() does.
+    /// BatchSimControl calls them itself so that one inference batch serves
+    /// all its environments.
+    void run_step_autonomies();
+    bool run_step_motion();
+
+    /// Autonomies may defer their forward passes to batch, which has to
+    /// run between run_step_autonomies() and run_step_motion(). Set it
+    /// after init() and before start() or run_start(). Ignored with entity
+    /// threads, since the autonomies and motion models of an entity then run
+    /// in one task.
+    void set_inference_batch(InferenceBatchPtr batch);
+    InferenceBatchPtr inference_batch() { return inference_batch_; }
+
+    NetworkPtr network() { return network_; }
     void force_exit();
     bool external_exit();
     void join();
@@ -111,14 +154,21 @@ class SimControl {
 
     bool end_condition_reached(double t, double dt);
 
+    /// Extra end conditions, parsed from the mission's early_termination
+    /// parameter. Predicates can also be added before start().
+    EarlyTermination &early_termination();
+
     Timer &timer();
 
     std::list<MetricsPtr> & metrics();
+    EntityIndexPtr &entity_index();
     PluginManagerPtr &plugin_manager();
     FileSearch &file_search();
 
+    // Steps ent, or runs job instead if it is set
     struct Task {
         EntityPtr ent;
+        std::function<void()> job;
         std::promise<bool> prom;
     };
     
@@ -135,13 +185,35 @@ class SimControl {
 
     void set_nn_path(std::string nn_path) { nn_path_ = nn_path; }
     void set_nn_path2(std::string nn_path) { nn_path2_ = nn_path; }
-    
+    void set_opponent(OpponentPtr opponent) { opponent_ = opponent; }
+    void set_search_distribution(std::shared_ptr<const LowRankCMAES> dist) { search_distribution_ = dist; }
+
+    /// Saves the simulation between two time steps, t() being the time of
+    /// the next one: the entities and their plugins, entity generation, the
+    /// random number generator, queued messages, and the state of entity
+    /// interactions and metrics. Don't call it while run() is in progress,
+    /// use set_snapshot_callback() instead.
+    void snapshot(Snapshot &snapshot);
+
+    /// Continues from a snapshot. Call it after init() of a SimControl with
+    /// the same mission, and before start(). Entities that don't exist in
+    /// the snapshot are removed; the parameter vector and the plugins'
+    /// parameters can differ, so several variants can be continued from
+    /// one snapshot.
+    bool restore(const Snapshot &snapshot);
+
+    /// Calls callback from the simulation thread with a snapshot taken
+    /// after the first time step at or after time t. The run then continues.
+    void set_snapshot_callback(double t, std::function<void(SnapshotPtr)> callback);
+
  protected:
     // Key: Entity ID
     // Value: Team ID
     std::vector<double> parameter_vector_;
     std::string nn_path_;
     std::string nn_path2_;
+    OpponentPtr opponent_;
+    std::shared_ptr<const LowRankCMAES> search_distribution_;
 
     std::shared_ptr<std::unordered_map<int,int> > team_lookup_;
 
@@ -154,6 +226,10 @@ class SimControl {
 
     std::list<EntityPtr> ents_;
 
+    // Dense ID -> entity lookup shared with interactions, metrics, and
+    // autonomies. Kept in sync with ents_.
+    EntityIndexPtr entity_index_;
+
     ContactMapPtr contacts_;
     
     std::map<int, std::list<ShapePtr> > shapes_;    
@@ -197,13 +273,19 @@ class SimControl {
     std::condition_variable_any entity_pool_condition_var_;
     std::vector<std::thread> entity_worker_threads_;
     void worker();
-    void run_entities();
+    // Sensors and autonomies, or whole entity steps with entity threads
+    void run_autonomies();
+    // Controllers and motion models, then the autonomies' shapes
+    void run_motion();
+    // Runs the jobs on the entity worker threads and waits for them
+    void run_jobs(std::vector<std::function<void()>> &jobs);
 
     std::shared_ptr<Log> log_;
 
     //InteractionDetection inter_detect_;
 
     EndConditionFlags end_conditions_;
+    EarlyTermination early_termination_;
 
     RandomPtr random_;
 
@@ -221,6 +303,38 @@ class SimControl {
     int next_id_;
     FileSearch file_search_;
     RTreePtr rtree_;
+    EngagementGeometryPtr engagement_geometry_;
+    InferenceBatchPtr inference_batch_;
+
+    // Multi-rate scheduling. Sensors, sensables, autonomies, entity
+    // interactions and metrics with a loop_rate only step on the time
+    // steps that are multiples of their loop period, and are passed the
+    // time since their last step. That includes the final step, which
+    // steps all of them. Controllers and motion models always step at the
+    // simulation rate. Messages are kept for a plugin until it steps.
+    void set_loop_period(const PluginPtr &plugin);
+    bool loop_due(const PluginPtr &plugin);
+    double loop_dt(const PluginPtr &plugin);
+    void clear_subscriber_msgs();
+    unsigned int time_step_;
+    int loop_number_;
+    bool exit_loop_;
+    bool multi_rate_;
+    bool final_step_;
+
+    bool restored_;
+    double snapshot_time_;
+    std::function<void(SnapshotPtr)> snapshot_callback_;
+
+    // Rollouts of the same mission, see reset()
+    bool init_mission();
+    bool init_entities();
+    void configure_entity(EntityPtr &ent);
+    EntityPtr spare_entity(int id, int sub_swarm_id);
+    std::map<PluginPtr, std::map<std::string, std::string>> plugin_params_;
+    bool recycle_entities_;
+    std::vector<EntityPtr> generated_ents_;
+    std::map<int, EntityPtr> spare_ents_;
 
     void create_rtree();
     void run_autonomy();
@@ -246,5 +360,7 @@ class SimControl {
     
 private:
 };
+
+typedef std::shared_ptr<SimControl> SimControlPtr;
 }
 #endif
@@ -0,0 +1,68 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <scrimmage/fwd_decl.h>
+#include <scrimmage/common/Checkpoint.h>
+
+namespace scrimmage {
+
+class State;
+
+/// The state of a running simulation between two time steps, taken by
+/// SimControl::snapshot() and continued from by SimControl::restore().
+///
+/// Values are stored as checkpoint fields under keys prefixed by their
+/// owner, e.g. "entity/3/motion/x". Messages waiting for a plugin are kept
+/// as shared pointers: messages aren't modified once published, so every
+/// simulation restored from a snapshot shares them instead of copying.
+/// Restoring only reads the snapshot, so several simulations can be
+/// restored from one snapshot concurrently.
+class Snapshot : public Checkpoint {
+ public:
+    using Checkpoint::set;
+    using Checkpoint::get;
+
+    void set(std::string key, const State &state);
+    bool get(std::string key, State &state) const;
+
+    // The messages in the plugin's publishers and subscribers
+    void save_messages(const std::string &prefix, Plugin &plugin);
+    void restore_messages(const std::string &prefix, Plugin &plugin) const;
+
+ protected:
+    std::map<std::string, std::list<MessageBasePtr>> messages_;
+};
+
+} // namespace scrimmage
+#endif
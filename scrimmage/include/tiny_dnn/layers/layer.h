@@ -155,34 +155,64 @@ class layer : public node {
   serial_size_t out_size() const { return out_data_size(); }
 
 
+  /**
+   * number of trainable parameters (weights and biases)
+   **/
+  size_t num_weights() const {
+      size_t n = 0;
+      for (size_t i = 0; i < in_channels_; i++) {
+        if (is_trainable_weight(in_type_[i])) {
+          n += get_weight_data(i)->size();
+        }
+      }
+      return n;
+  }
+
   /**
    * return vector of all weights
    **/
   vec_t get_weights() const {
-      vec_t allweights;
+      vec_t allweights(num_weights());
+      get_weights(allweights.data());
+      return allweights;
+  }
+
+  /**
+   * copy all weights to dst, returns the number of weights copied
+   **/
+  size_t get_weights(float_t *dst) const {
+      size_t n = 0;
       for (size_t i = 0; i < in_channels_; i++) {
         if (is_trainable_weight(in_type_[i])) {
           const vec_t *edgeweights = get_weight_data(i);
-          for(size_t j=0;j<edgeweights->size();j++)
-              allweights.push_back((*edgeweights)[j]);
+          std::copy(edgeweights->begin(), edgeweights->end(), dst + n);
+          n += edgeweights->size();
         }
       }
-      return allweights;
+      return n;
   }
 
   /**
-   * set all weights with vector of weights
+   * set all weights from src, returns the number of weights consumed
    **/
-  void set_weights(vec_t *allweights) {
+  size_t set_weights(const float_t *src) {
+      size_t n = 0;
       for (size_t i = 0; i < in_channels_; i++) {
         if (is_trainable_weight(in_type_[i])) {
-            vec_t *edgeweights = get_weight_data(i);
-            for(size_t j=0;j<edgeweights->size();j++){
-                (*edgeweights)[j] = (*allweights)[0];
-                allweights->erase(allweights->begin());
-            }
-          }
+          vec_t *edgeweights = get_weight_data(i);
+          std::copy(src + n, src + n + edgeweights->size(), edgeweights->begin());
+          n += edgeweights->size();
+        }
       }
+      return n;
+  }
+
+  /**
+   * set all weights with vector of weights
+   **/
+  void set_weights(const vec_t &allweights) {
+      assert(allweights.size() >= num_weights());
+      set_weights(allweights.data());
   }
 
 
@@ -597,28 +597,65 @@ class network {
     return true;
   }
 
+  /**
+   * number of trainable parameters in the network
+   **/
+  size_t num_weights() const {
+      size_t n = 0;
+      for (size_t i=0;i<net_.size();i++)
+        n += net_[i]->num_weights();
+      return n;
+  }
+
   /**
    * return vector of all network weights
    **/
   vec_t get_weights() const {
       vec_t allweights;
-      int numweights=0;
-      for (size_t i=0;i<net_.size();i++){
-        vec_t layerweights = net_[i]->get_weights();
-        allweights.resize(numweights+layerweights.size(),0.0);
-        for(size_t j=0; j<layerweights.size();j++)
-            allweights[j+numweights]=layerweights[j];
-        numweights+=layerweights.size();
-      }
+      get_weights(allweights);
       return allweights;
   }
 
+  /**
+   * copy all network weights into allweights, reusing its storage
+   **/
+  void get_weights(vec_t &allweights) const {
+      allweights.resize(num_weights());
+      float_t *dst = allweights.data();
+      for (size_t i=0;i<net_.size();i++)
+        dst += net_[i]->get_weights(dst);
+  }
+
   /**
    * set all network weights with vector of weights
    **/
-  void set_weights(vec_t *allweights) {
+  void set_weights(const vec_t &allweights) {
+      if (allweights.size() != num_weights()) {
+        throw nn_error("set_weights: expected " + std::to_string(num_weights()) +
+                       " weights, got " + std::to_string(allweights.size()));
+      }
+      const float_t *src = allweights.data();
       for (size_t i=0;i<net_.size();i++)
-        net_[i]->set_weights(allweights);
+        src += net_[i]->set_weights(src);
+  }
+
+  /**
+   * set all network weights with vector of weights. allweights is left
+   * unchanged.
+   **/
+  void set_weights(vec_t *allweights) { set_weights(*allweights); }
+
+  /**
+   * views of every trainable weight vector, in the same order as
+   * get_weights(), for reading or updating the parameters in place
+   **/
+  std::vector<vec_t *> weights() {
+      std::vector<vec_t *> v;
+      for (size_t i=0;i<net_.size();i++) {
+        std::vector<vec_t *> w = net_[i]->weights();
+        v.insert(v.end(), w.begin(), w.end());
+      }
+      return v;
   }
 
 
@@ -50,14 +50,20 @@ void Boids::init(std::map<std::string,std::string> &params)
     w_align_ = scrimmage::get("align_weight", params, 0.01);
     w_avoid_ = scrimmage::get("avoid_weight", params, 0.95);
     w_centroid_ = scrimmage::get("centroid_weight", params, 0.05);
+
+    // ownship and its nearest num_neighbors_ - 1 neighbors
+    num_neighbors_ = 10;
+    rtree_->request_neighbors(num_neighbors_ - 1, false);
 }
 
 bool Boids::step_autonomy(double t, double dt)
 {     
-    // Find n nearest neighbor of ownship
-    unsigned int num_neighbors = 10;
-    std::vector<scrimmage::ID> rtree_neighbors;     
-    rtree_->nearest_n_neighbors(state_->pos_const(), rtree_neighbors, num_neighbors);
+    // Find n nearest neighbor of ownship, which is nearest to itself
+    std::vector<scrimmage::ID> storage;
+    scrimmage::IDSlice others = rtree_->nearest_neighbors(
+        state_->pos_const(), parent_.lock()->id().id(), num_neighbors_ - 1, storage);
+    std::vector<scrimmage::ID> rtree_neighbors(1, parent_.lock()->id());
+    rtree_neighbors.insert(rtree_neighbors.end(), others.begin(), others.end());
      
     {
         // Ensure that the neighbors are "in front" (abs(bearing) < 100)
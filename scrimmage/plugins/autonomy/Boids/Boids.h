@@ -38,6 +38,7 @@ protected:
      double w_align_;
      double w_avoid_;
      double w_centroid_;
+     unsigned int num_neighbors_;
 private:     
 };
 
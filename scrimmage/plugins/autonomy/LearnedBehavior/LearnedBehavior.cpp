@@ -76,16 +76,21 @@ void LearnedBehavior::init(std::map<std::string,std::string> &params)
 //    w_avoid_=w_avoid_/w_sum;
 //    w_centroid_=w_centroid_/w_sum;
 
+    // ownship and its nearest num_neighbors_ - 1 neighbors
+    num_neighbors_ = 7;
+    rtree_->request_neighbors(num_neighbors_ - 1, false);
 }
 
 bool LearnedBehavior::step_autonomy(double t, double dt)
 {
 //    action_.clear(); // reset the action every step
 
-    // Find n nearest neighbor of ownship
-    int num_neighbors = 7;
-    std::vector<scrimmage::ID> rtree_neighbors;
-    rtree_->nearest_n_neighbors(state_->pos_const(), rtree_neighbors, num_neighbors);
+    // Find n nearest neighbor of ownship, which is nearest to itself
+    std::vector<scrimmage::ID> storage;
+    scrimmage::IDSlice others = rtree_->nearest_neighbors(
+        state_->pos_const(), parent_.lock()->id().id(), num_neighbors_ - 1, storage);
+    std::vector<scrimmage::ID> rtree_neighbors(1, parent_.lock()->id());
+    rtree_neighbors.insert(rtree_neighbors.end(), others.begin(), others.end());
 
 //    {
 //        // Ensure that the neighbors are "in front" (abs(bearing) < 100)
@@ -39,6 +39,7 @@ protected:
     double w_avoid_;
     double w_centroid_;
     double desired_vel;
+    unsigned int num_neighbors_;
 private:     
 };
 
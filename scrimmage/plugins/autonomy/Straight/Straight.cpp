@@ -29,6 +29,7 @@
 #include <scrimmage/plugin_manager/RegisterPlugin.h>
 #include <scrimmage/math/State.h>
 #include <scrimmage/parse/ParseUtils.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 
 #include "Straight.h"
 
@@ -57,6 +58,29 @@ void Straight::init(std::map<std::string,std::string> &params)
     goal_ = state_->pos() + unit_vector * rel_pos.norm();
 }
 
+bool Straight::reset(std::map<std::string,std::string> &params)
+{
+    init(params);
+    return true;
+}
+
+// the goal is projected from the position the entity started at
+void Straight::save_state(scrimmage::Snapshot &snapshot, const std::string &prefix)
+{
+    scrimmage::Autonomy::save_state(snapshot, prefix);
+    snapshot.set(prefix + "/goal", std::vector<double>(goal_.data(), goal_.data() + 3));
+}
+
+bool Straight::restore_state(const scrimmage::Snapshot &snapshot, const std::string &prefix)
+{
+    std::vector<double> goal;
+    if (!snapshot.get(prefix + "/goal", goal) || goal.size() != 3) {
+        return false;
+    }
+    goal_ << goal[0], goal[1], goal[2];
+    return scrimmage::Autonomy::restore_state(snapshot, prefix);
+}
+
 bool Straight::step_autonomy(double t, double dt)
 {
     Eigen::Vector3d diff = goal_ - state_->pos();
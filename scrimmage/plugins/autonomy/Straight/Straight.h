@@ -35,7 +35,10 @@ class Straight : public scrimmage::Autonomy{
 public:
      Straight();
      virtual void init(std::map<std::string,std::string> &params);
+     virtual bool reset(std::map<std::string,std::string> &params);
      virtual bool step_autonomy(double t, double dt);     
+     virtual void save_state(scrimmage::Snapshot &snapshot, const std::string &prefix);
+     virtual bool restore_state(const scrimmage::Snapshot &snapshot, const std::string &prefix);
 protected:
      double speed_;
      Eigen::Vector3d goal_;
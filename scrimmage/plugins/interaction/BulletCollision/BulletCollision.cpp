@@ -42,6 +42,7 @@
 #include <scrimmage/msgs/Event.pb.h>
 #include <scrimmage/autonomy/Autonomy.h>
 #include <scrimmage/common/RTree.h>
+#include <scrimmage/simcontrol/EntityIndex.h>
 
 #include <scrimmage/motion/MotionModel.h>
 
@@ -111,21 +112,19 @@ bool BulletCollision::init(std::map<std::string,std::string> &mission_params,
 bool BulletCollision::step_entity_interaction(std::list<sc::EntityPtr> &ents,
                                               double t, double dt)
 {
-    // Maybe we should use a map by default
-    std::map<int, sc::EntityPtr> int_to_ent_map;
-    for (sc::EntityPtr &ent : ents) {
-        int_to_ent_map[ent->id().id()] = ent;
-    }
-
     // Get newly created objects
     for (auto msg : sub_ent_gen_->pop_msgs<sc::Message<sm::EntityGenerated>>()) {
         int id = msg->data.entity_id();       
+        const sc::EntityPtr &ent = entity_index_->at(id);
+        if (ent == nullptr) {
+            continue;
+        }
         
         btCollisionObject* coll_object = new btCollisionObject();
         coll_object->setUserIndex(id);
-        coll_object->getWorldTransform().setOrigin(btVector3((btScalar) int_to_ent_map[id]->state()->pos()(0),
-                                                             (btScalar) int_to_ent_map[id]->state()->pos()(1),
-                                                             (btScalar) int_to_ent_map[id]->state()->pos()(2)));
+        coll_object->getWorldTransform().setOrigin(btVector3((btScalar) ent->state()->pos()(0),
+                                                             (btScalar) ent->state()->pos()(1),
+                                                             (btScalar) ent->state()->pos()(2)));
         coll_object->setCollisionShape(sphere_shape_);
         bt_collision_world->addCollisionObject(coll_object);
 
@@ -134,9 +133,13 @@ bool BulletCollision::step_entity_interaction(std::list<sc::EntityPtr> &ents,
 
     // Update positions of all objects
     for (auto &kv : objects_) {        
-        kv.second->getWorldTransform().setOrigin(btVector3((btScalar) int_to_ent_map[kv.first]->state()->pos()(0),
-                                                           (btScalar) int_to_ent_map[kv.first]->state()->pos()(1),
-                                                           (btScalar) int_to_ent_map[kv.first]->state()->pos()(2)));
+        const sc::EntityPtr &ent = entity_index_->at(kv.first);
+        if (ent == nullptr) {
+            continue;
+        }
+        kv.second->getWorldTransform().setOrigin(btVector3((btScalar) ent->state()->pos()(0),
+                                                           (btScalar) ent->state()->pos()(1),
+                                                           (btScalar) ent->state()->pos()(2)));
     }
 
     bt_collision_world->performDiscreteCollisionDetection();
@@ -185,11 +188,11 @@ bool BulletCollision::step_entity_interaction(std::list<sc::EntityPtr> &ents,
             //cout << "Force on " << obA->getUserIndex() << ", " << -force_B_dir << endl;
             //cout << "Force on " << obB->getUserIndex() << ", " << force_B_dir << endl;           
 
-            if (int_to_ent_map.count(obB->getUserIndex()) > 0) {
-                int_to_ent_map[obB->getUserIndex()]->motion()->set_external_force(-normal_B);
+            if (entity_index_->count(obB->getUserIndex())) {
+                entity_index_->at(obB->getUserIndex())->motion()->set_external_force(-normal_B);
             }
-            if (int_to_ent_map.count(obA->getUserIndex()) > 0) {
-                int_to_ent_map[obA->getUserIndex()]->motion()->set_external_force(normal_B);
+            if (entity_index_->count(obA->getUserIndex())) {
+                entity_index_->at(obA->getUserIndex())->motion()->set_external_force(normal_B);
             }
         }
     }
@@ -36,7 +36,9 @@
 #include <scrimmage/entity/Entity.h>
 #include <scrimmage/math/State.h>
 
+#include <scrimmage/common/Arena.h>
 #include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
 #include <scrimmage/msgs/Collision.pb.h>
 
 #include <GeographicLib/LocalCartesian.hpp>
@@ -55,6 +57,14 @@ GroundCollision::GroundCollision()
 
 bool GroundCollision::init(std::map<std::string,std::string> &mission_params,
                            std::map<std::string,std::string> &plugin_params)
+{
+    collision_pub_ = create_publisher("GroundCollision");
+
+    return reset(mission_params, plugin_params);
+}
+
+bool GroundCollision::reset(std::map<std::string,std::string> &mission_params,
+                            std::map<std::string,std::string> &plugin_params)
 {
     // Determine ground collision z-value. If ground_collision_altitude is
     // defined, it has priority.
@@ -66,8 +76,6 @@ bool GroundCollision::init(std::map<std::string,std::string> &mission_params,
         ground_collision_z_ = z;
     }
 
-    collision_pub_ = create_publisher("GroundCollision");
-
     return true;
 }
 
@@ -80,7 +88,7 @@ bool GroundCollision::step_entity_interaction(std::list<sc::EntityPtr> &ents,
         if (ent->state()->pos()(2) < ground_collision_z_) {
             ent->collision();
 
-            auto msg = std::make_shared<sc::Message<sm::GroundCollision>>();
+            auto msg = network_->arena()->make_shared<sc::Message<sm::GroundCollision>>();
             msg->data.set_entity_id(ent->id().id());
             publish_immediate(t, collision_pub_, msg);
         }
@@ -36,7 +36,9 @@
 #include <scrimmage/entity/Entity.h>
 #include <scrimmage/math/State.h>
 
+#include <scrimmage/common/Arena.h>
 #include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
 #include <scrimmage/msgs/Collision.pb.h>
 #include <scrimmage/autonomy/Autonomy.h>
 #include <scrimmage/common/RTree.h>
@@ -55,6 +57,16 @@ SimpleCollision::SimpleCollision()
 
 bool SimpleCollision::init(std::map<std::string,std::string> &mission_params,
                            std::map<std::string,std::string> &plugin_params)
+{
+    // Setup publishers
+    team_collision_pub_ = create_publisher("TeamCollision");
+    non_team_collision_pub_ = create_publisher("NonTeamCollision");
+
+    return reset(mission_params, plugin_params);
+}
+
+bool SimpleCollision::reset(std::map<std::string,std::string> &mission_params,
+                            std::map<std::string,std::string> &plugin_params)
 {
     collision_range_ = sc::get("collision_range", plugin_params, 0.0);
     startup_collisions_only_ = sc::get("startup_collisions_only", plugin_params, false);
@@ -63,10 +75,6 @@ bool SimpleCollision::init(std::map<std::string,std::string> &mission_params,
     enable_non_team_collisions_ = sc::get<bool>("enable_enemy_collisions", plugin_params, true);
 
     init_alt_deconflict_ = sc::get<bool>("init_alt_deconflict", plugin_params, false);
-    
-    // Setup publishers
-    team_collision_pub_ = create_publisher("TeamCollision");
-    non_team_collision_pub_ = create_publisher("NonTeamCollision");
 
     return true;
 }
@@ -99,7 +107,7 @@ bool SimpleCollision::step_entity_interaction(std::list<sc::EntityPtr> &ents,
                     ent1->collision();
                     ent2->collision();
 
-                    auto msg = std::make_shared<sc::Message<sm::TeamCollision>>();
+                    auto msg = network_->arena()->make_shared<sc::Message<sm::TeamCollision>>();
                     msg->data.set_entity_id_1(ent1->id().id());
                     msg->data.set_entity_id_2(ent2->id().id());
                     publish_immediate(t, team_collision_pub_, msg);
@@ -108,7 +116,7 @@ bool SimpleCollision::step_entity_interaction(std::list<sc::EntityPtr> &ents,
                     ent1->collision();
                     ent2->collision();
 
-                    auto msg = std::make_shared<sc::Message<sm::NonTeamCollision>>();
+                    auto msg = network_->arena()->make_shared<sc::Message<sm::NonTeamCollision>>();
                     msg->data.set_entity_id_1(ent1->id().id());
                     msg->data.set_entity_id_2(ent2->id().id());
                     publish_immediate(t, non_team_collision_pub_, msg);
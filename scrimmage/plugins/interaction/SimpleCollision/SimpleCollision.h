@@ -42,6 +42,8 @@ public:
     
     virtual bool init(std::map<std::string,std::string> &mission_params,
                       std::map<std::string,std::string> &plugin_params);
+    virtual bool reset(std::map<std::string,std::string> &mission_params,
+                       std::map<std::string,std::string> &plugin_params);
     
     virtual bool step_entity_interaction(std::list<sc::EntityPtr> &ents, 
                                          double t, double dt);
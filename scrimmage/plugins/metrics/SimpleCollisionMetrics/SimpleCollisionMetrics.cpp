@@ -36,6 +36,7 @@
 #include <scrimmage/plugin_manager/RegisterPlugin.h>
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/parse/ParseUtils.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 
 #include <scrimmage/pubsub/Message.h>
 #include <scrimmage/pubsub/Subscriber.h>
@@ -67,6 +68,18 @@ void SimpleCollisionMetrics::init(std::map<std::string,std::string> &params)
     sub_ent_pres_end_ = create_subscriber("EntityPresentAtEnd");        
 }
 
+bool SimpleCollisionMetrics::reset(std::map<std::string,std::string> &params)
+{
+    params_ = params;
+    scores_.clear();
+    team_coll_scores_.clear();
+    surviving_teams_.clear();
+    team_metrics_.clear();
+    team_scores_.clear();
+    headers_.clear();
+    return true;
+}
+
 bool SimpleCollisionMetrics::step_metrics(double t, double dt)
 {
     for (auto msg : sub_team_collision_->pop_msgs<sc::Message<sm::TeamCollision>>()) {
@@ -185,3 +198,15 @@ void SimpleCollisionMetrics::print_team_summaries()
         cout << sc::generate_chars("-",70) << endl;
     }
 }
+
+void SimpleCollisionMetrics::save_state(sc::Snapshot &snapshot, const std::string &prefix)
+{
+    sc::Metrics::save_state(snapshot, prefix);
+    snapshot.set(prefix + "/scores", scores_);
+}
+
+bool SimpleCollisionMetrics::restore_state(const sc::Snapshot &snapshot, const std::string &prefix)
+{
+    if (!snapshot.get(prefix + "/scores", scores_)) return false;
+    return sc::Metrics::restore_state(snapshot, prefix);
+}
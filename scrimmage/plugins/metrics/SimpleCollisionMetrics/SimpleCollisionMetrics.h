@@ -39,9 +39,12 @@ public:
 
     virtual std::string name() { return std::string("SimpleCollisionMetrics"); }
     virtual void init(std::map<std::string,std::string> &params);
+    virtual bool reset(std::map<std::string,std::string> &params);
     virtual bool step_metrics(double t, double dt);
     virtual void calc_team_scores();
     virtual void print_team_summaries();    
+    virtual void save_state(sc::Snapshot &snapshot, const std::string &prefix);
+    virtual bool restore_state(const sc::Snapshot &snapshot, const std::string &prefix);
     
 protected:
     sc::SubscriberPtr sub_team_collision_;
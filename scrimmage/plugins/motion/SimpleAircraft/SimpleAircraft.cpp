@@ -31,6 +31,7 @@
 #include <scrimmage/parse/ParseUtils.h>
 #include <scrimmage/plugin_manager/RegisterPlugin.h>
 #include <scrimmage/math/Angles.h>
+#include <scrimmage/math/FastMath.h>
 #include <boost/algorithm/clamp.hpp>
 #include <scrimmage/entity/Entity.h>
 
@@ -61,7 +62,7 @@ enum ControlParams
     CONTROL_NUM_ITEMS
 };
 
-SimpleAircraft::SimpleAircraft()
+SimpleAircraft::SimpleAircraft() : fast_math_(false)
 {
     x_.resize(MODEL_NUM_ITEMS);
 }
@@ -92,6 +93,7 @@ bool SimpleAircraft::init(std::map<std::string, std::string> &info,
     max_roll_ = sc::Angles::deg2rad(sc::get("max_roll", params, 30.0));
     max_pitch_ = sc::Angles::deg2rad(sc::get("max_pitch", params, 30.0));
     noise_stdev_ = sc::get("noise_stdev", params, 0.01);
+    fast_math_ = sc::get("fast_math", params, false);
 
 
     state_->pos() << x_[X], x_[Y], x_[Z];
@@ -101,6 +103,13 @@ bool SimpleAircraft::init(std::map<std::string, std::string> &info,
     return true;
 }
 
+bool SimpleAircraft::reset(std::map<std::string, std::string> &info,
+                           std::map<std::string, std::string> &params)
+{
+    // the controller's u_ is kept
+    return init(info, params);
+}
+
 bool SimpleAircraft::step(double time, double dt)
 {
     // Need to saturate state variables before model runs    
@@ -124,7 +133,13 @@ bool SimpleAircraft::step(double time, double dt)
 
     state_->pos() << x_[X], x_[Y], x_[Z];
     state_->quat().set(-x_[ROLL], x_[PITCH], x_[YAW]);
-    state_->vel() << x_[SPEED] * cos(x_[YAW]), x_[SPEED] * sin(x_[YAW]), 0;
+    if (fast_math_) {
+        double sin_yaw, cos_yaw;
+        sc::fast_math::sincos(x_[YAW], sin_yaw, cos_yaw);
+        state_->vel() << x_[SPEED] * cos_yaw, x_[SPEED] * sin_yaw, 0;
+    } else {
+        state_->vel() << x_[SPEED] * cos(x_[YAW]), x_[SPEED] * sin(x_[YAW]), 0;
+    }
 
     return true;
 }
@@ -147,14 +162,27 @@ void SimpleAircraft::model(const vector_t &x , vector_t &dxdt , double t)
     roll_rate = clamp(roll_rate, -1, 1.0);
     pitch_rate = clamp(pitch_rate, -1.0, 1.0);
 
-    double xy_speed = x[SPEED] * cos(x[PITCH]);
+    double sin_pitch, cos_pitch, sin_yaw, cos_yaw, tan_roll;
+    if (fast_math_) {
+        sc::fast_math::sincos(x[PITCH], sin_pitch, cos_pitch);
+        sc::fast_math::sincos(x[YAW], sin_yaw, cos_yaw);
+        tan_roll = sc::fast_math::tan(x[ROLL]);
+    } else {
+        sin_pitch = sin(x[PITCH]);
+        cos_pitch = cos(x[PITCH]);
+        sin_yaw = sin(x[YAW]);
+        cos_yaw = cos(x[YAW]);
+        tan_roll = tan(x[ROLL]);
+    }
+
+    double xy_speed = x[SPEED] * cos_pitch;
     sc::RandomPtr randomptr = parent_.lock()->random();
-    dxdt[X] = xy_speed*cos(x[YAW])+randomptr->rng_normal()*noise_stdev_;
-    dxdt[Y] = xy_speed*sin(x[YAW])+randomptr->rng_normal()*noise_stdev_;
-    dxdt[Z] = -sin(x[PITCH])*x[SPEED]+randomptr->rng_normal()*noise_stdev_;
+    dxdt[X] = xy_speed*cos_yaw+randomptr->rng_normal()*noise_stdev_;
+    dxdt[Y] = xy_speed*sin_yaw+randomptr->rng_normal()*noise_stdev_;
+    dxdt[Z] = -sin_pitch*x[SPEED]+randomptr->rng_normal()*noise_stdev_;
     dxdt[ROLL] = roll_rate/2+randomptr->rng_normal()*noise_stdev_;
     dxdt[PITCH] = pitch_rate/2+randomptr->rng_normal()*noise_stdev_;
-    dxdt[YAW] = x[SPEED]/length_*tan(x[ROLL])+randomptr->rng_normal()*noise_stdev_;
+    dxdt[YAW] = x[SPEED]/length_*tan_roll+randomptr->rng_normal()*noise_stdev_;
 
     dxdt[SPEED] = thrust/5+randomptr->rng_normal()*noise_stdev_;
 }
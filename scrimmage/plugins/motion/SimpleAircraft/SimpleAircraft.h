@@ -40,6 +40,8 @@ class SimpleAircraft : public scrimmage::MotionModel{
      
     virtual bool init(std::map<std::string, std::string> &info,
                       std::map<std::string, std::string> &params);          
+    virtual bool reset(std::map<std::string, std::string> &info,
+                       std::map<std::string, std::string> &params);
     virtual bool step(double time, double dt);     
 
     void model(const vector_t &x , vector_t &dxdt , double t);
@@ -66,7 +68,8 @@ class SimpleAircraft : public scrimmage::MotionModel{
     double max_roll_;
     double max_pitch_;
     double noise_stdev_;
-    
+    bool fast_math_;
+
 private:     
 };
 
@@ -26,6 +26,7 @@
 /// A long description.
 /// ---------------------------------------------------------------------------
 #include <scrimmage/plugin_manager/RegisterPlugin.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 #include "SimpleAircraftControllerPID.h"
 #include <boost/algorithm/string.hpp>
 #include <iostream>
@@ -60,22 +61,33 @@ void set_pid(sc::PID &pid, std::string str, bool is_angle) {
 }
 
 void SimpleAircraftControllerPID::init(std::map<std::string, std::string> &params) {
+    u_ = std::make_shared<Eigen::Vector3d>();
+    reset(params);
+}
+
+bool SimpleAircraftControllerPID::reset(std::map<std::string, std::string> &params) {
+    heading_pid_ = sc::PID();
+    alt_pid_ = sc::PID();
+    vel_pid_ = sc::PID();
     set_pid(heading_pid_, params["heading_pid"], true);
     set_pid(alt_pid_, params["alt_pid"], false);
     set_pid(vel_pid_, params["vel_pid"], false);
-    u_ = std::make_shared<Eigen::Vector3d>();
+
+    // the motion model holds on to u_
+    u_->setZero();
+    return true;
 }
 
 bool SimpleAircraftControllerPID::step(double t, double dt) {
-    double desired_yaw = desired_state_->quat().yaw();                    
+    double desired_yaw = desired_state_->yaw();                    
      
     heading_pid_.set_setpoint(desired_yaw);
-    double u_heading = heading_pid_.step(dt, state_->quat().yaw());     
-    double roll_error = u_heading + state_->quat().roll();               
+    double u_heading = heading_pid_.step(dt, state_->yaw());     
+    double roll_error = u_heading + state_->roll();               
      
     alt_pid_.set_setpoint(desired_state_->pos()(2));
     double u_alt = alt_pid_.step(dt, state_->pos()(2));
-    double pitch_error = (-u_alt - state_->quat().pitch());     
+    double pitch_error = (-u_alt - state_->pitch());     
         
     vel_pid_.set_setpoint(desired_state_->vel()(0));
     double u_thrust = vel_pid_.step(dt, state_->vel().norm());     
@@ -83,3 +95,26 @@ bool SimpleAircraftControllerPID::step(double t, double dt) {
     (*u_) << u_thrust, roll_error, pitch_error;
     return true;
 }
+
+void SimpleAircraftControllerPID::save_state(sc::Snapshot &snapshot, const std::string &prefix) {
+    sc::Controller::save_state(snapshot, prefix);
+    std::vector<double> pids = {heading_pid_.integral(), heading_pid_.prev_error(),
+                                alt_pid_.integral(), alt_pid_.prev_error(),
+                                vel_pid_.integral(), vel_pid_.prev_error()};
+    std::vector<double> u(u_->data(), u_->data() + 3);
+    snapshot.set(prefix + "/pids", pids);
+    snapshot.set(prefix + "/u", u);
+}
+
+bool SimpleAircraftControllerPID::restore_state(const sc::Snapshot &snapshot, const std::string &prefix) {
+    std::vector<double> pids, u;
+    if (!snapshot.get(prefix + "/pids", pids) || pids.size() != 6 ||
+        !snapshot.get(prefix + "/u", u) || u.size() != 3) {
+        return false;
+    }
+    *u_ << u[0], u[1], u[2];
+    heading_pid_.set_state(pids[0], pids[1]);
+    alt_pid_.set_state(pids[2], pids[3]);
+    vel_pid_.set_state(pids[4], pids[5]);
+    return sc::Controller::restore_state(snapshot, prefix);
+}
@@ -32,8 +32,11 @@
 class SimpleAircraftControllerPID : public SimpleAircraft::Controller {
  public: 
     virtual void init(std::map<std::string, std::string> &params);
+    virtual bool reset(std::map<std::string, std::string> &params);
     virtual bool step(double t, double dt);
     virtual std::shared_ptr<Eigen::Vector3d> u() {return u_;};
+    virtual void save_state(scrimmage::Snapshot &snapshot, const std::string &prefix);
+    virtual bool restore_state(const scrimmage::Snapshot &snapshot, const std::string &prefix);
  protected:
     std::shared_ptr<Eigen::Vector3d> u_;
     scrimmage::PID heading_pid_;
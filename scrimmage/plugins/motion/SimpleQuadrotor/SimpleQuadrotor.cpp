@@ -88,6 +88,12 @@ bool SimpleQuadrotor::init(std::map<std::string, std::string> &info,
     return true;
 }
 
+bool SimpleQuadrotor::reset(std::map<std::string, std::string> &info,
+                            std::map<std::string, std::string> &params)
+{
+    return init(info, params);
+}
+
 bool SimpleQuadrotor::step(double time, double dt)
 {    
     ode_step(dt);
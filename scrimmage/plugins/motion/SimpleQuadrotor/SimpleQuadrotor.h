@@ -38,6 +38,8 @@ class SimpleQuadrotor : public scrimmage::MotionModel{
 
     virtual bool init(std::map<std::string, std::string> &info,
                       std::map<std::string, std::string> &params);          
+    virtual bool reset(std::map<std::string, std::string> &info,
+                       std::map<std::string, std::string> &params);
     virtual bool step(double time, double dt);     
 
     virtual void model(const vector_t &x , vector_t &dxdt , double t);
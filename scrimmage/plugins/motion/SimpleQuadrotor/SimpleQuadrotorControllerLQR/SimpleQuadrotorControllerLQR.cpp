@@ -48,6 +48,13 @@ void SimpleQuadrotorControllerLQR::init(std::map<std::string, std::string> &para
     max_vel_ = std::stod(params["max_vel"]);
 }
 
+bool SimpleQuadrotorControllerLQR::reset(std::map<std::string, std::string> &params) {
+    vel_pid_ = sc::PID();
+    prev_yaw_ = NAN;
+    init(params);
+    return true;
+}
+
 bool SimpleQuadrotorControllerLQR::step(double t, double dt) {
     Eigen::Vector3d &des_pos = desired_state_->pos();
     double des_yaw = desired_state_->quat().yaw();
@@ -32,6 +32,7 @@
 class SimpleQuadrotorControllerLQR : public SimpleQuadrotor::Controller {
  public: 
     virtual void init(std::map<std::string, std::string> &params);
+    virtual bool reset(std::map<std::string, std::string> &params);
     virtual bool step(double t, double dt);
     virtual Eigen::Vector4d &u() {return u_;};
  protected:
@@ -30,6 +30,7 @@
 #include <scrimmage/common/ID.h>
 #include <vector>
 #include <scrimmage/common/RTree.h>
+#include <scrimmage/common/EngagementGeometry.h>
 #include <scrimmage/math/State.h>
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/math/Angles.h>
@@ -60,10 +61,17 @@ bool SimpleCamera::sense(double t, double dt) {
 
     rtree_->neighbors_in_range(state->pos(), neigh, range_, my_id);
 
+    // Bearings from this tick's engagement geometry where it has them
+    sc::EngagementGeometryPtr geometry = parent_.lock()->engagement_geometry();
+    const sc::EngagementRow *row = geometry ? geometry->row(my_id) : nullptr;
+
     sensed_contacts_.clear();
     for (sc::ID &id : neigh) {
-        sc::State &other_state = *contacts_->at(id.id()).state();
-        if (state->InFieldOfView(other_state, fov_azimuth_, fov_elevation_)) {
+        const sc::Engagement *e = row ? row->find(id.id()) : nullptr;
+        bool in_fov = e ? e->in_field_of_view(fov_azimuth_, fov_elevation_) :
+            state->InFieldOfView(*contacts_->at(id.id()).state(),
+                                 fov_azimuth_, fov_elevation_);
+        if (in_fov) {
             sensed_contacts_[id.id()] = contacts_->at(id.id());
         }
     }
@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+#
+# Compares two directories of benchmark results written by
+# run-benchmarks.sh, e.g. of two commits:
+#
+#   ./compare-benchmarks.py benchmark-results/1a2b3c4 benchmark-results/5d6e7f8
+#
+# For every benchmark in both, prints the real time per iteration and the
+# rate counters (items_per_second, ticks_per_second, ...) with their change.
+
+from __future__ import print_function
+
+import glob
+import json
+import os
+import sys
+
+
+def load(results_dir):
+    results = {}
+    for filename in sorted(glob.glob(os.path.join(results_dir, '*.json'))):
+        with open(filename) as f:
+            data = json.load(f)
+        for bench in data['benchmarks']:
+            # only the mean of repeated runs
+            if bench.get('run_type') == 'aggregate' and \
+               bench.get('aggregate_name') != 'mean':
+                continue
+            if 'error_occurred' in bench:
+                continue
+            name = bench.get('run_name', bench['name'])
+            values = {'real_time (%s)' % bench['time_unit']: bench['real_time']}
+            for key, value in bench.items():
+                if key.endswith('_per_second'):
+                    values[key] = value
+            results[name] = values
+    return results
+
+
+def main():
+    if len(sys.argv) != 3:
+        print('usage: %s <old results dir> <new results dir>' % sys.argv[0])
+        return 1
+
+    old = load(sys.argv[1])
+    new = load(sys.argv[2])
+
+    print('%-50s %-20s %12s %12s %8s' % ('benchmark', 'value', 'old', 'new', 'change'))
+    for name in sorted(set(old) & set(new)):
+        for key in sorted(set(old[name]) & set(new[name])):
+            a = old[name][key]
+            b = new[name][key]
+            change = (b - a) / a * 100 if a != 0 else float('nan')
+            print('%-50s %-20s %12.4g %12.4g %+7.1f%%' % (name, key, a, b, change))
+
+    for name in sorted(set(old) ^ set(new)):
+        print('%-50s only in %s' % (name, sys.argv[1] if name in old else sys.argv[2]))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
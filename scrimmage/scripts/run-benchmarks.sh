@@ -0,0 +1,112 @@
+#!/bin/bash
+# ---------------------------------------------------------------------------
+# @section LICENSE
+#
+# Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+#               All Rights Reserved
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+# ---------------------------------------------------------------------------
+# @file filename.ext
+# @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+# @author Eric Squires <eric.squires@gtri.gatech.edu>
+# @version 1.0
+# ---------------------------------------------------------------------------
+# @brief A brief description.
+#
+# @section DESCRIPTION
+# A long description.
+# ---------------------------------------------------------------------------
+
+usage()
+{
+    cat << EOF
+
+USAGE:
+          $0 [OPTIONS]
+
+          Runs the benchmarks built with -DBUILD_BENCHMARKS=ON and writes
+          their results as JSON to <output dir>/<commit>/<benchmark>.json.
+          Compare the results of two commits with compare-benchmarks.py.
+
+OPTIONS:
+          -h   Display this usage information
+          -b   Directory of the bench_* executables
+          -o   Output directory
+          -f   Only run the benchmarks matching this regex
+
+DEFAULTS:
+          -b=<scrimmage>/bin
+          -o=./benchmark-results
+
+EXAMPLE:
+          Run the mission benchmarks and compare them with an older run:
+              $0 -f BM_mission
+              ./compare-benchmarks.py benchmark-results/<old> benchmark-results/<new>
+EOF
+}
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BIN_DIR="${SCRIPT_DIR}/../bin"
+OUT_DIR="./benchmark-results"
+FILTER="."
+while getopts ":b:o:f:h" opt; do
+    case $opt in
+        h)
+            usage
+            exit 0
+            ;;
+        b)
+            BIN_DIR=$OPTARG
+            ;;
+        o)
+            OUT_DIR=$OPTARG
+            ;;
+        f)
+            FILTER=$OPTARG
+            ;;
+        \?)
+            echo "Invalid option: -$OPTARG" >&2
+            usage
+            exit 1
+            ;;
+        :)
+            echo "Option -$OPTARG requires an argument." >&2
+            usage
+            exit 1
+            ;;
+    esac
+done
+
+COMMIT=$(git -C "${SCRIPT_DIR}" rev-parse --short HEAD)
+if ! git -C "${SCRIPT_DIR}" diff --quiet HEAD; then
+    COMMIT="${COMMIT}-dirty"
+fi
+RESULTS_DIR="${OUT_DIR}/${COMMIT}"
+mkdir -p "${RESULTS_DIR}"
+
+FOUND=false
+for BENCH in "${BIN_DIR}"/bench_*; do
+    [ -x "${BENCH}" ] || continue
+    FOUND=true
+    NAME=$(basename "${BENCH}")
+    echo "Running ${NAME}"
+    "${BENCH}" --benchmark_filter="${FILTER}" \
+               --benchmark_out="${RESULTS_DIR}/${NAME}.json" \
+               --benchmark_out_format=json || exit 1
+done
+
+if [ "${FOUND}" = false ]; then
+    echo "No benchmarks in ${BIN_DIR}, build with -DBUILD_BENCHMARKS=ON" >&2
+    exit 1
+fi
+echo "Results in ${RESULTS_DIR}"
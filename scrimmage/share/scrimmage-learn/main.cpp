@@ -29,8 +29,11 @@
 #include <chrono>
 #include <ctime>
 #include <signal.h>
+#include <getopt.h>
 #include <string>
 
+#include <deque>
+#include <thread>
 #include <unordered_set>
 #include <cstdlib>
 #include <string>
@@ -38,6 +41,11 @@
 #include <cstdlib>
 #include <memory>
 #include <scrimmage/common/Random.h>
+#include <scrimmage/common/Checkpoint.h>
+#include <scrimmage/common/FitnessShaping.h>
+#include <scrimmage/common/OpponentPool.h>
+#include <scrimmage/math/LowRankCMAES.h>
+#include <scrimmage/network/SocketChannel.h>
 
 #include <scrimmage/parse/MissionParse.h>
 #include <scrimmage/common/Utilities.h>
@@ -48,6 +56,7 @@
 #include <scrimmage/autonomy/Autonomy.h>
 #include <scrimmage/entity/Contact.h>
 
+#include <scrimmage/simcontrol/BatchSimControl.h>
 #include <scrimmage/simcontrol/SimControl.h>
 
 #include <scrimmage/network/Interface.h>
@@ -107,15 +116,860 @@ std::vector<double> str2vec(std::string str)
     return vec;
 }
 
+// One generation of rollouts, all sampled around the same policy (nn_path).
+// Rollout i is job jobs[i], perturbed by signs[i] times the noise of seeds[i]
+// on team teams[i], in the scenario (spawn layout and other mission
+// randomness) of scenarios[i]. In league training the other team plays the
+// past policy opponents[i] from the league. With learning_algorithm cmaes
+// the samples are drawn from dist instead of an isotropic Gaussian. With
+// envs_per_thread > 1 several rollouts share a thread and the forward passes
+// of the league opponents they play, see BatchSimControl.
+struct Generation {
+    Generation(size_t num_threads) : n(0), testing(false), group_size(1),
+                                     simcontrol(num_threads), mp(num_threads),
+                                     jobs(num_threads), seeds(num_threads),
+                                     scenarios(num_threads),
+                                     signs(num_threads, 1),
+                                     teams(num_threads, 1),
+                                     opponents(num_threads, 0),
+                                     scores(num_threads, 0),
+                                     opponent_scores(num_threads, 0),
+                                     accepted(num_threads, true) {
+        for (size_t i = 0; i < num_threads; i++) jobs[i] = i;
+    }
+    size_t n;
+    bool testing;
+    // Rollouts are accepted or stopped in whole groups of this many, see
+    // Sampling::rollouts_per_group()
+    size_t group_size;
+    std::string nn_path;
+    std::shared_ptr<const sc::LowRankCMAES> dist;
+    std::string log_dir;
+    std::vector<sc::SimControlPtr> simcontrol;
+    std::vector<sc::BatchSimControlPtr> batches;
+    std::vector<sc::MissionParsePtr> mp;
+    std::vector<int32_t> jobs;
+    std::vector<int32_t> seeds;
+    std::vector<int32_t> scenarios;
+    std::vector<int32_t> signs;
+    std::vector<int32_t> teams;
+    std::vector<int32_t> opponents;
+    std::vector<double> scores;
+    std::vector<double> opponent_scores;
+    std::vector<bool> accepted;
+};
+typedef std::shared_ptr<Generation> GenerationPtr;
+
+// SimControls of finished generations, kept when the mission sets
+// recycle_entities so the next rollouts reset() them instead of building
+// the entities and plugins again
+typedef std::vector<sc::SimControlPtr> SimControlPool;
+
+// How the rollouts of a generation are grouped into samples.
+//
+// With num_scenarios > 0 (common random numbers) every sample is run on the
+// same num_scenarios scenario seeds and its score is the average over them,
+// so differences in score come from the perturbation rather than from the
+// spawn layout. With mirrored, samples come in pairs +eps, -eps that share
+// the scenarios (or, without common random numbers, one scenario per pair).
+struct Sampling {
+    Sampling() : num_scenarios(0), mirrored(false) {}
+    size_t num_scenarios;
+    bool mirrored;
+
+    size_t rollouts_per_sample() const { return std::max<size_t>(1, num_scenarios); }
+
+    // A sample with all its scenarios, and its mirror. Partly finished
+    // groups aren't scored, otherwise samples would be compared on
+    // different scenarios or without their mirror.
+    size_t rollouts_per_group() const { return rollouts_per_sample() * (mirrored ? 2 : 1); }
+};
+
+// Rollout i belongs to sample i / rollouts_per_sample()
+void draw_samples(Generation &gen, size_t seed, size_t play_against_self,
+                  sc::OpponentPoolPtr league, sc::Random &random,
+                  const Sampling &sampling = Sampling())
+{
+    random.seed(seed+gen.n+1);
+    std::vector<int32_t> scenario_seeds(sampling.num_scenarios);
+    for (int32_t &scenario_seed : scenario_seeds) {
+        scenario_seed = random.rng_uniform_int(100,99999999);
+    }
+
+    gen.group_size = sampling.rollouts_per_group();
+    size_t k = sampling.rollouts_per_sample();
+    for(size_t s=0;s*k<gen.seeds.size();s++){
+        size_t i = s*k;
+        if (sampling.mirrored && s % 2 == 1) {
+            // the mirror of the previous sample
+            gen.seeds[i] = gen.seeds[i-k];
+            gen.signs[i] = -1;
+            gen.teams[i] = gen.teams[i-k];
+            gen.opponents[i] = gen.opponents[i-k];
+            gen.scenarios[i] = gen.scenarios[i-k];
+        } else {
+            //set unique seed for each thread
+            gen.seeds[i] = random.rng_uniform_int(100,99999999);
+            gen.signs[i] = 1;
+
+            if(play_against_self){
+                //randomly pick a team to be peturbed
+                gen.teams[i]=random.rng_uniform_int(1,2);
+            }else{
+                //peturb team 1
+                gen.teams[i]=1;
+            }
+
+            if(league){
+                gen.opponents[i] = league->sample(random)->id();
+            }
+            gen.scenarios[i] = gen.seeds[i];
+        }
+
+        for (size_t j = 0; j < k && i+j < gen.seeds.size(); j++) {
+            gen.seeds[i+j] = gen.seeds[i];
+            gen.signs[i+j] = gen.signs[i];
+            gen.teams[i+j] = gen.teams[i];
+            gen.opponents[i+j] = gen.opponents[i];
+            gen.scenarios[i+j] = scenario_seeds.empty() ? gen.scenarios[i] : scenario_seeds[j];
+        }
+    }
+}
+
+// mission is parsed once and copied for every rollout. The rollouts reuse
+// the SimControls in pool, falling back to a new one if reset() fails.
+bool launch_generation(Generation &gen, sc::MissionParsePtr mission,
+                       std::vector<double> param_vec, double sigma,
+                       sc::OpponentPoolPtr league, SimControlPool &pool)
+{
+    // one thread per rollout, or per batch of envs_per_thread rollouts
+    size_t envs_per_thread = std::max(1, sc::get<int>("envs_per_thread", mission->params(), 1));
+    gen.batches.clear();
+
+    for(size_t i=0;i<gen.simcontrol.size();i++)
+    {
+        gen.mp[i]=mission->clone();
+        gen.mp[i]->set_task_number(gen.jobs[i]);
+        gen.mp[i]->set_job_number(gen.n);
+
+        //use our custom log directory structure
+        gen.mp[i]->set_log_dir(gen.log_dir + "/job" + std::to_string(gen.jobs[i]));
+        gen.mp[i]->create_log_dir(false);
+
+        // the scenario seeds the mission, the perturbation seed the policy
+        gen.mp[i]->params()["seed"] = std::to_string(gen.scenarios[i]);
+        gen.mp[i]->params()["perturbation_seed"] = std::to_string(gen.seeds[i]);
+
+        param_vec[0] = gen.testing ? 0.0 : sigma*gen.signs[i];
+        param_vec[7]=gen.teams[i];
+
+        sc::OpponentPtr opponent;
+        if (league) {
+            opponent = league->find(gen.opponents[i]);
+            if (!opponent) {
+                cout << "Opponent " << gen.opponents[i] << " isn't in the league" << endl;
+                return false;
+            }
+        }
+
+        auto setup = [&](sc::SimControlPtr &simcontrol) {
+            // Setup Logger
+            std::shared_ptr<sc::Log> log(new sc::Log());
+            log->set_enable_log(false);
+            log->init(gen.mp[i]->log_dir(), sc::Log::NONE);
+            simcontrol->set_log(log);
+
+            //dunno what this does, remove it?
+            sc::InterfacePtr to_gui_interface = std::make_shared<sc::Interface>();
+            sc::InterfacePtr from_gui_interface = std::make_shared<sc::Interface>();
+            to_gui_interface->set_log(log);
+            from_gui_interface->set_log(log);
+
+            simcontrol->set_incoming_interface(from_gui_interface);
+            simcontrol->set_outgoing_interface(to_gui_interface);
+
+            simcontrol->set_mission_parse(gen.mp[i]);
+            simcontrol->set_parameter_vector(param_vec);
+            simcontrol->set_nn_path(gen.nn_path);
+            // set even when unused, a recycled SimControl keeps them
+            simcontrol->set_search_distribution(gen.testing ? nullptr : gen.dist);
+            simcontrol->set_opponent(opponent);
+        };
+
+        gen.simcontrol[i] = nullptr;
+        if (!pool.empty()) {
+            gen.simcontrol[i] = pool.back();
+            pool.pop_back();
+            setup(gen.simcontrol[i]);
+            if (!gen.simcontrol[i]->reset()) gen.simcontrol[i] = nullptr;
+        }
+
+        if (!gen.simcontrol[i]) {
+            gen.simcontrol[i] = std::make_shared<sc::SimControl>();
+            setup(gen.simcontrol[i]);
+
+            // Split off SimControl in it's own thread
+            if (!gen.simcontrol[i]->init()) {
+                cout << "SimControl init() failed." << endl;
+                return false;
+            }
+        }
+        gen.simcontrol[i]->display_progress(false);
+        if (envs_per_thread > 1) {
+            if (i % envs_per_thread == 0) {
+                gen.batches.push_back(std::make_shared<sc::BatchSimControl>());
+            }
+            gen.batches.back()->add(gen.simcontrol[i].get());
+        } else {
+            gen.simcontrol[i]->start();
+        }
+    }
+    for (sc::BatchSimControlPtr &batch : gen.batches) {
+        batch->start();
+    }
+    return true;
+}
+
+bool generation_finished(Generation &gen)
+{
+    for (sc::SimControlPtr &simcontrol : gen.simcontrol) {
+        if (!simcontrol->finished()) return false;
+    }
+    return true;
+}
+
+// Writes info.txt and returns the average accepted score, leaving out the
+// rollouts whose score was nan.
+double write_generation_info(Generation &gen)
+{
+    double totalscore=0.0;
+    int num_notnan_scores=0;
+    for(size_t i=0;i<gen.scores.size();i++){
+        if(gen.accepted[i] && gen.scores[i] != -1e100){
+            totalscore+=gen.scores[i];
+            num_notnan_scores++;
+        }
+    }
+    double avg_score = totalscore/(double)num_notnan_scores;
+
+    //log time spent and scores
+    std::ofstream runtime_file(gen.log_dir + "/info.txt");
+    runtime_file << "Avg score: "<<avg_score<<std::endl;
+    runtime_file << "scores: " << std::endl;
+    for (size_t i=0;i<gen.scores.size();i++)
+        if (gen.accepted[i]) runtime_file << gen.scores[i] << " ";
+    runtime_file.close();
+    return avg_score;
+}
+
+// Joins the rollouts, writes each summary.csv and fills gen.scores.
+// avg_score is the average of the scores that aren't nan.
+//
+// Once the groups (gen.group_size rollouts each) holding num_accept rollouts
+// have finished completely, the other rollouts are stopped and marked as not
+// accepted, so a few slow rollouts don't hold up the generation. A group is
+// only accepted if all its rollouts finished.
+// The joined SimControls go back to pool if the mission recycles entities.
+bool finish_generation(Generation &gen, size_t play_against_self,
+                       size_t num_accept, double &avg_score,
+                       SimControlPool &pool)
+{
+    size_t n = gen.simcontrol.size();
+    size_t group = std::max<size_t>(1, gen.group_size);
+    if (num_accept < n) {
+        size_t num_groups = (n + group - 1) / group;
+        size_t groups_needed = std::min(num_groups, (num_accept + group - 1) / group);
+        std::vector<bool> group_finished(num_groups);
+        size_t num_finished;
+        do {
+            num_finished = 0;
+            for (size_t g = 0; g < num_groups; g++) {
+                group_finished[g] = true;
+                for (size_t i = g*group; i < std::min(n, (g+1)*group); i++) {
+                    if (!gen.simcontrol[i]->finished()) {
+                        group_finished[g] = false;
+                        break;
+                    }
+                }
+                if (group_finished[g]) num_finished++;
+            }
+            if (num_finished < groups_needed) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        } while (num_finished < groups_needed);
+
+        for(size_t i=0;i<n;i++){
+            gen.accepted[i] = group_finished[i / group];
+            if (!gen.simcontrol[i]->finished()) gen.simcontrol[i]->force_exit();
+        }
+    }
+
+    // Make sure SimControl joins properly before program ends
+    for (sc::BatchSimControlPtr &batch : gen.batches) {
+        batch->join();
+    }
+    for(size_t i=0;i<gen.simcontrol.size();i++){
+        gen.simcontrol[i]->join();
+    }
+
+    // collect scores, do logging
+    for(size_t i=0;i<gen.simcontrol.size();i++)
+    {
+        if (!gen.accepted[i]) continue;
+
+        // calculate scores
+        std::map<int, double> team_scores;
+        std::map<int, std::map<std::string, double>> team_metrics;
+        std::list<std::string> headers;
+
+        // Loop through each of the metrics plugins.
+        for (sc::MetricsPtr metrics : gen.simcontrol[i]->metrics()) {
+//                cout << sc::generate_chars("=", 80) << endl;
+//                cout << metrics->name() << endl;
+//                cout << sc::generate_chars("=", 80) << endl;
+            metrics->calc_team_scores();
+//                metrics->print_team_summaries();
+
+            // Add all elements from individual metrics plugin to overall
+            // metrics data structure
+            for (auto const &team_str_double : metrics->team_metrics()) {
+                team_metrics[team_str_double.first].insert(team_str_double.second.begin(),
+                                                           team_str_double.second.end());
+            }
+
+            // Calculate aggregated team scores:
+            for (auto const &team_score : metrics->team_scores()) {
+                if (team_scores.count(team_score.first) == 0) {
+                    team_scores[team_score.first] = 0;
+                }
+                team_scores[team_score.first] += team_score.second;
+            }
+
+            // Create list of all csv headers
+            headers.insert(headers.end(), metrics->headers().begin(),
+                           metrics->headers().end());
+        }
+
+        // Create headers string
+        std::string csv_str = "team_id,score";
+        for (std::string header : headers) {
+            csv_str += "," + header;
+        }
+        csv_str += "\n";
+
+        // Loop over each team and generate csv output
+        for (auto const &team_str_double : team_metrics) {
+
+            // Each line starts with team_id,score
+            csv_str += std::to_string(team_str_double.first);
+            csv_str += "," + std::to_string(team_scores[team_str_double.first]);
+
+            // Loop over all possible headers, if the header doesn't exist for
+            // a specific team, default the value for that header to zero.
+            for (std::string header : headers) {
+                csv_str += ",";
+
+                auto it = team_str_double.second.find(header);
+                if (it != team_str_double.second.end()) {
+                    csv_str += std::to_string(it->second);
+                } else {
+                    csv_str += std::to_string((double)0);
+                }
+            }
+            csv_str += "\n";
+        }
+
+
+//            // Print Overall Scores
+//            cout << sc::generate_chars("=", 80) << endl;
+//            cout << "Overall Scores" << endl;
+//            cout << sc::generate_chars("=", 80) << endl;
+//            for (auto const &team_score : team_scores) {
+//                cout << "Team ID: " << team_score.first << endl;
+//                cout << "Score: " << team_score.second << endl;
+//                cout << sc::generate_chars("-", 80) << endl;
+//            }
+
+        // Write CSV string to file
+        std::string out_file = gen.mp[i]->log_dir() + "/summary.csv";
+        std::ofstream summary_file(out_file);
+        if (!summary_file.is_open()) {
+            std::cout << "could not open " << out_file
+                      << " for writing metrics" << std::endl;
+            return false;
+        }
+        summary_file << csv_str << std::flush;
+        summary_file.close();
+
+
+        //collect scores
+        int team = play_against_self ? gen.simcontrol[i]->parameter_vector()[7] : 1;
+        gen.scores[i]=team_scores[team];
+        gen.opponent_scores[i]=team_scores[team == 1 ? 2 : 1];
+
+        if (std::isnan(gen.scores[i])){
+            gen.scores[i]=-1e100;
+        }
+    }
+    avg_score = write_generation_info(gen);
+
+    if (sc::get("recycle_entities", gen.mp[0]->params(), false)) {
+        pool.insert(pool.end(), gen.simcontrol.begin(), gen.simcontrol.end());
+    }
+    return true;
+}
+
+// Sends the rollouts of gen to the workers, in contiguous blocks of whole
+// groups so that each worker can accept or stop complete groups
+bool send_generation(Generation &gen, std::vector<sc::SocketChannelPtr> &workers,
+                     size_t num_accept)
+{
+    size_t num_rollouts = gen.seeds.size();
+    size_t group = std::max<size_t>(1, gen.group_size);
+    size_t num_groups = (num_rollouts + group - 1) / group;
+    for(size_t w=0;w<workers.size();w++){
+        size_t begin = std::min(num_rollouts, group*(num_groups*w/workers.size()));
+        size_t end = std::min(num_rollouts, group*(num_groups*(w+1)/workers.size()));
+        size_t block_accept = (num_accept*(end-begin) + num_rollouts-1)/num_rollouts;
+
+        sc::Checkpoint msg;
+        msg.set("type", std::string("run"));
+        msg.set("generation", static_cast<uint64_t>(gen.n));
+        msg.set("testing", gen.testing);
+        msg.set("num_accept", static_cast<uint64_t>(block_accept));
+        msg.set("group_size", static_cast<uint64_t>(group));
+        msg.set("jobs", std::vector<int32_t>(gen.jobs.begin()+begin, gen.jobs.begin()+end));
+        msg.set("seeds", std::vector<int32_t>(gen.seeds.begin()+begin, gen.seeds.begin()+end));
+        msg.set("scenarios", std::vector<int32_t>(gen.scenarios.begin()+begin, gen.scenarios.begin()+end));
+        msg.set("signs", std::vector<int32_t>(gen.signs.begin()+begin, gen.signs.begin()+end));
+        msg.set("teams", std::vector<int32_t>(gen.teams.begin()+begin, gen.teams.begin()+end));
+        msg.set("opponents", std::vector<int32_t>(gen.opponents.begin()+begin, gen.opponents.begin()+end));
+        if(!workers[w]->send(msg)){
+            cout << "Lost connection to worker " << w << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool collect_generation(Generation &gen, std::vector<sc::SocketChannelPtr> &workers,
+                        double &avg_score)
+{
+    for(size_t w=0;w<workers.size();w++){
+        sc::Checkpoint msg;
+        std::vector<int32_t> jobs;
+        std::vector<double> scores, opponent_scores;
+        std::vector<uint8_t> accepted;
+        if(!workers[w]->recv(msg) || !msg.get("jobs", jobs) ||
+           !msg.get("scores", scores) || !msg.get("accepted", accepted) ||
+           !msg.get("opponent_scores", opponent_scores) ||
+           jobs.size() != scores.size() || jobs.size() != accepted.size() ||
+           jobs.size() != opponent_scores.size()){
+            cout << "Lost connection to worker " << w << endl;
+            return false;
+        }
+        for(size_t i=0;i<jobs.size();i++){
+            if(jobs[i] < 0 || static_cast<size_t>(jobs[i]) >= gen.scores.size()){
+                cout << "Worker " << w << " sent an unknown job " << jobs[i] << endl;
+                return false;
+            }
+            gen.scores[jobs[i]] = scores[i];
+            gen.opponent_scores[jobs[i]] = opponent_scores[i];
+            gen.accepted[jobs[i]] = accepted[i] != 0;
+        }
+    }
+    boost::filesystem::create_directories(gen.log_dir);
+    avg_score = write_generation_info(gen);
+    return true;
+}
+
+// Runs the rollouts of a generation either as local SimControl threads or,
+// as a master, on the connected workers.
+struct RolloutRunner {
+    sc::MissionParsePtr mission;
+    std::vector<double> param_vec;
+    double sigma;
+    size_t play_against_self;
+    sc::OpponentPoolPtr league;
+    std::vector<sc::SocketChannelPtr> workers;
+    SimControlPool pool;
+
+    bool launch(Generation &gen, size_t num_accept) {
+        if (workers.empty()) return launch_generation(gen, mission, param_vec, sigma, league, pool);
+        return send_generation(gen, workers, num_accept);
+    }
+
+    bool finish(Generation &gen, size_t num_accept, double &avg_score) {
+        if (workers.empty()) return finish_generation(gen, play_against_self, num_accept, avg_score, pool);
+        return collect_generation(gen, workers, avg_score);
+    }
+};
+
+bool finish_test_generation(GenerationPtr &test_gen, RolloutRunner &runner,
+                            std::ofstream &test_score_history_file)
+{
+    double avg_score;
+    if (!runner.finish(*test_gen, test_gen->scores.size(), avg_score)) {
+        return false;
+    }
+    for (size_t i=0;i<test_gen->scores.size();i++)
+        test_score_history_file << test_gen->scores[i] << " ";
+    test_score_history_file << std::endl;
+
+    std::cout<<"Testing gen " << test_gen->n << "... Avg score: "<<avg_score<<"\n";
+    test_gen = nullptr;
+    return true;
+}
+
+// CMA-ES learners move the mean themselves, without Adam. The distribution
+// is replaced rather than updated in place, since rollouts of other
+// generations may still be sampling from it.
+vec_t apply_cma_update(tiny_dnn::network<tiny_dnn::sequential> &policy_network,
+                       std::shared_ptr<const sc::LowRankCMAES> &dist,
+                       const std::vector<int32_t> &seeds,
+                       const std::vector<double> &weights)
+{
+    std::shared_ptr<sc::LowRankCMAES> next = std::make_shared<sc::LowRankCMAES>(*dist);
+    vec_t theta = policy_network.get_weights();
+    next->update(theta, seeds, weights);
+    policy_network.set_weights(theta);
+    dist = next;
+    return theta;
+}
+
+// The policy saved after generation id, -1 being the initial policy
+std::string league_nn_path(std::string log_dir, int32_t id)
+{
+    if (id < 0) return log_dir + "/init_nn.dat";
+    return log_dir + "/gen" + std::to_string(id) + "/nn.dat";
+}
+
+// Win / loss / draw of each accepted rollout against its opponent. Results
+// against opponents that have since left the league are dropped.
+void record_league_results(Generation &gen, sc::OpponentPool &league)
+{
+    for(size_t i=0;i<gen.scores.size();i++){
+        if(!gen.accepted[i] || gen.scores[i] == -1e100) continue;
+        sc::OpponentPtr opponent = league.find(gen.opponents[i]);
+        if(opponent) opponent->record(gen.scores[i], gen.opponent_scores[i]);
+    }
+}
+
+bool write_league_stats(sc::OpponentPool &league, std::string filename)
+{
+    std::ofstream league_file(filename);
+    if (!league_file.is_open()) {
+        cout << "could not open " << filename << endl;
+        return false;
+    }
+    league_file << "opponent,games,wins,losses,draws,win_rate,avg_score" << endl;
+    league.write_stats(league_file);
+    return true;
+}
+
+// Adds up the noise of each sample, regenerated from its seed and scaled by
+// its weight, and takes an Adam step. Master and workers call this with the
+// same seeds and scales, so they keep identical copies of the policy.
+vec_t apply_update(tiny_dnn::network<tiny_dnn::sequential> &policy_network,
+                   tiny_dnn::network<tiny_dnn::sequential> &zero_network,
+                   sc::AdamOptimizer<vec_t> &adamoptimizer,
+                   const std::vector<int32_t> &seeds,
+                   const std::vector<double> &scales,
+                   double learning_rate, double weight_decay)
+{
+    //update zero neural network with score-weighted weights, to basically keep track of the total gradient
+    zero_network.weight_init(weight_init::constant(0.0));
+    zero_network.bias_init(weight_init::constant(0.0));
+    zero_network.init_weight();
+    for(size_t i=0;i<seeds.size();i++){
+        zero_network.perturb_weights(seeds[i], scales[i]);
+    }
+
+    //apply optimizer update to policy_network
+    vec_t grad = zero_network.get_weights();
+    vec_t update = adamoptimizer.step(grad);
+    vec_t theta = policy_network.get_weights();
+    for(size_t i=0;i<theta.size();i++)
+        theta[i]=weight_decay*theta[i] + learning_rate*update[i];
+
+    policy_network.set_weights(theta);
+    return theta;
+}
+
+// Workers receive the policy once, then per generation only the seeds of
+// their samples and the seeds and weights of the update.
+int run_worker(std::string address, char *mission_file)
+{
+    sc::MissionParsePtr main_mp = std::make_shared<sc::MissionParse>();
+    if (!main_mp->parse(mission_file)) {
+        cout << "Failed to parse file: " << mission_file << endl;
+        return -1;
+    }
+    main_mp->create_log_dir();
+
+    // template for the rollouts, left as parsed
+    sc::MissionParsePtr mission = std::make_shared<sc::MissionParse>();
+    mission->parse(mission_file);
+
+    sc::SocketChannel master;
+    if (!master.connect(address, 60)) return -1;
+
+    sc::Checkpoint msg;
+    std::string type, nn_data;
+    std::vector<double> param_vec;
+    vec_t m, v;
+    double learning_rate;
+    if (!master.recv(msg) || !msg.get("type", type) || type != "init" ||
+        !msg.get("nn", nn_data) || !msg.get("param_vector", param_vec) ||
+        !msg.get("learning_rate", learning_rate) ||
+        !msg.get("adam_m", m) || !msg.get("adam_v", v) ||
+        param_vec.size() < 8) {
+        cout << "Invalid init message from " << address << endl;
+        return -1;
+    }
+
+    // The master sends the league as it is now. Afterwards both sides add
+    // the same generations, so their leagues stay identical.
+    sc::OpponentPoolPtr league;
+    uint64_t league_size = 0;
+    std::vector<int32_t> league_ids;
+    msg.get("league_size", league_size);
+    msg.get("league_ids", league_ids);
+    if (league_size > 0) {
+        league = std::make_shared<sc::OpponentPool>(league_size);
+        boost::filesystem::create_directories(main_mp->log_dir() + "/league");
+        for (int32_t id : league_ids) {
+            std::string league_data;
+            std::string league_path = main_mp->log_dir() + "/league/opponent" + std::to_string(id) + ".dat";
+            msg.get("league_nn" + std::to_string(id), league_data);
+            std::ofstream(league_path, std::ios::binary) << league_data;
+            if (!league->add(id, league_path)) return -1;
+        }
+    }
+
+    std::string nn_path = main_mp->log_dir() + "/init_nn.dat";
+    std::ofstream(nn_path, std::ios::binary) << nn_data;
+
+    tiny_dnn::network<tiny_dnn::sequential> policy_network, zero_network;
+    policy_network.load(nn_path);
+    zero_network.load(nn_path);
+
+    double sigma = param_vec[0];
+    double weight_decay = param_vec[6];
+    size_t play_against_self = param_vec[7];
+    sc::AdamOptimizer<vec_t> adamoptimizer;
+    adamoptimizer.setparams(param_vec[3], param_vec[4], param_vec[5]);
+    adamoptimizer.set_moments(m, v);
+
+    std::shared_ptr<const sc::LowRankCMAES> dist;
+    if (main_mp->params()["learning_algorithm"] == "cmaes") {
+        std::shared_ptr<sc::LowRankCMAES> cma = std::make_shared<sc::LowRankCMAES>();
+        if (!cma->load(msg)) {
+            cout << "Invalid init message from " << address << endl;
+            return -1;
+        }
+        dist = cma;
+    }
+
+#if ENABLE_PYTHON_BINDINGS==1
+    Py_Initialize();
+#endif
+
+    SimControlPool pool;
+    while (master.recv(msg) && msg.get("type", type)) {
+        uint64_t n = 0;
+        msg.get("generation", n);
+
+        if (type == "run") {
+            std::vector<int32_t> jobs;
+            uint64_t num_accept = 0, group_size = 1;
+            msg.get("jobs", jobs);
+            msg.get("num_accept", num_accept);
+            msg.get("group_size", group_size);
+
+            Generation gen(jobs.size());
+            gen.n = n;
+            msg.get("testing", gen.testing);
+            msg.get("seeds", gen.seeds);
+            msg.get("scenarios", gen.scenarios);
+            msg.get("signs", gen.signs);
+            msg.get("teams", gen.teams);
+            msg.get("opponents", gen.opponents);
+            gen.jobs = jobs;
+            gen.group_size = group_size;
+            gen.nn_path = nn_path;
+            gen.dist = dist;
+            gen.log_dir = main_mp->log_dir() + (gen.testing ? "/test/gen" : "/gen") + std::to_string(n);
+
+            double avg_score;
+            if (!launch_generation(gen, mission, param_vec, sigma, league, pool) ||
+                !finish_generation(gen, play_against_self, num_accept, avg_score, pool)) {
+                return -1;
+            }
+
+            sc::Checkpoint result;
+            result.set("type", std::string("result"));
+            result.set("jobs", gen.jobs);
+            result.set("scores", gen.scores);
+            result.set("opponent_scores", gen.opponent_scores);
+            result.set("accepted", std::vector<uint8_t>(gen.accepted.begin(), gen.accepted.end()));
+            if (!master.send(result)) break;
+
+        } else if (type == "update") {
+            std::vector<int32_t> seeds;
+            std::vector<double> scales;
+            msg.get("seeds", seeds);
+            msg.get("scales", scales);
+            if (dist) {
+                apply_cma_update(policy_network, dist, seeds, scales);
+            } else {
+                apply_update(policy_network, zero_network, adamoptimizer,
+                             seeds, scales, learning_rate, weight_decay);
+            }
+
+            std::string gen_dir = main_mp->log_dir() + "/gen" + std::to_string(n);
+            boost::filesystem::create_directories(gen_dir);
+            nn_path = gen_dir + "/nn.dat";
+            policy_network.save(nn_path);
+
+            bool league_add = false;
+            msg.get("league_add", league_add);
+            if (league && league_add && !league->add(n, nn_path)) return -1;
+
+        } else if (type == "stop") {
+#if ENABLE_PYTHON_BINDINGS==1
+            Py_Finalize();
+#endif
+            return 0;
+        }
+    }
+
+    cout << "Lost connection to " << address << endl;
+    return -1;
+}
+
+// Waits for num_workers workers and sends them the current learner state
+bool connect_workers(std::string address, size_t num_workers,
+                     std::string nn_path, std::vector<double> param_vec,
+                     double learning_rate, sc::AdamOptimizer<vec_t> &adamoptimizer,
+                     sc::OpponentPoolPtr league,
+                     std::shared_ptr<const sc::LowRankCMAES> dist,
+                     std::vector<sc::SocketChannelPtr> &workers)
+{
+    sc::SocketServer server;
+    if (!server.listen(address)) return false;
+    cout << "Waiting for " << num_workers << " workers on " << server.address() << endl;
+
+    std::ifstream nn_file(nn_path, std::ios::binary);
+    std::string nn_data((std::istreambuf_iterator<char>(nn_file)),
+                        std::istreambuf_iterator<char>());
+
+    sc::Checkpoint init;
+    init.set("type", std::string("init"));
+    init.set("nn", nn_data);
+    init.set("param_vector", param_vec);
+    init.set("learning_rate", learning_rate);
+    init.set("adam_m", adamoptimizer.first_moment());
+    init.set("adam_v", adamoptimizer.second_moment());
+    if (dist) dist->save(init);
+
+    if (league) {
+        std::vector<int32_t> league_ids;
+        for (const sc::OpponentPtr &opponent : league->opponents()) {
+            std::ifstream league_file(opponent->nn_path(), std::ios::binary);
+            init.set("league_nn" + std::to_string(opponent->id()),
+                     std::string((std::istreambuf_iterator<char>(league_file)),
+                                 std::istreambuf_iterator<char>()));
+            league_ids.push_back(opponent->id());
+        }
+        init.set("league_size", static_cast<uint64_t>(league->max_size()));
+        init.set("league_ids", league_ids);
+    }
+
+    while (workers.size() < num_workers) {
+        workers.push_back(std::make_shared<sc::SocketChannel>());
+        if (!server.accept(*workers.back()) || !workers.back()->send(init)) {
+            cout << "Failed to connect worker " << workers.size() << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void usage(char *argv[])
+{
+    cout << "usage: " << argv[0] << " [--resume checkpoint.bin]"
+         << " [--master address --workers N | --worker address] scenario.xml" << endl;
+    cout << "  address is tcp:host:port or unix:/path/to/socket" << endl;
+}
+
 int main(int argc, char *argv[])
 {
+    std::string resume_file = "";
+    std::string master_address = "";
+    std::string worker_address = "";
+    size_t num_workers = 1;
+    struct option long_options[] = {
+        {"resume", required_argument, 0, 'r'},
+        {"master", required_argument, 0, 'm'},
+        {"workers", required_argument, 0, 'n'},
+        {"worker", required_argument, 0, 'w'},
+        {0, 0, 0, 0}
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "r:m:n:w:", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'r':
+            resume_file = std::string(optarg);
+            break;
+        case 'm':
+            master_address = std::string(optarg);
+            break;
+        case 'n':
+            num_workers = std::max(1, std::stoi(optarg));
+            break;
+        case 'w':
+            worker_address = std::string(optarg);
+            break;
+        default:
+            usage(argv);
+            return -1;
+        }
+    }
+
+    //ensure correct usage
+    if (optind >= argc) {
+        usage(argv);
+        return -1;
+    }
+
+    if (worker_address != "") {
+        return run_worker(worker_address, argv[optind]);
+    }
+
+    // Learner state saved by a previous run
+    sc::Checkpoint checkpoint;
+    if (resume_file != "" && !checkpoint.load(resume_file)) {
+        cout << "Failed to load checkpoint: " << resume_file << endl;
+        return -1;
+    }
+    bool resume = resume_file != "";
+
     //parse mission file
     sc::MissionParsePtr main_mp = std::make_shared<sc::MissionParse>();
     if (!main_mp->parse(argv[optind])) {
         cout << "Failed to parse file: " << argv[optind] << endl;
         return -1;
     }
-    main_mp->create_log_dir();
+
+    if (resume) {
+        // Continue writing into the log directory of the interrupted run
+        std::string log_dir;
+        checkpoint.get("log_dir", log_dir);
+        main_mp->set_log_dir(log_dir);
+    } else {
+        main_mp->create_log_dir();
+    }
 
     size_t seed = std::stoi(main_mp->params()["seed"]);
     size_t num_threads = std::stoi(main_mp->params()["num_samples_per_generation"]);
@@ -124,6 +978,7 @@ int main(int argc, char *argv[])
     size_t test_every_n_generations = std::stof(main_mp->params()["test_every_n_generations"]);
     std::vector<double> param_vec = str2vec(main_mp->params()["param_vector"]);
     std::string learning_algorithm = main_mp->params()["learning_algorithm"];
+    int checkpoint_every_n_generations = sc::get<int>("checkpoint_every_n_generations", main_mp->params(), 1);
 
     double sigma_ = param_vec[0];
     int n_friends_ = param_vec[1];
@@ -136,9 +991,21 @@ int main(int argc, char *argv[])
 
     // for use in the cross entropy method
     double top_percentile=0.0;
-    if(param_vec.size() >= 8)
+    if(param_vec.size() > 8)
         top_percentile = param_vec[8];
 
+    // crossentropy keeps the top_percentile of samples. Evolution
+    // strategies weight every sample by fitness_shaping, cmaes uses the
+    // CMA-ES recombination weights.
+    sc::FitnessShaping shaping = sc::FitnessShaping::ELITE;
+    if (learning_algorithm != "crossentropy") {
+        std::string shaping_str = sc::get<std::string>("fitness_shaping", main_mp->params(), "centered_ranks");
+        if (!sc::str2fitness_shaping(shaping_str, shaping)) {
+            std::cout << "unknown fitness_shaping: " << shaping_str << std::endl;
+            return -1;
+        }
+    }
+
     sc::Random random;
     random.seed(0);
 
@@ -150,17 +1017,24 @@ int main(int argc, char *argv[])
     sigaction(SIGINT,&sa,NULL);
     sigaction(SIGTERM,&sa,NULL);
 
-    //ensure correct usage
-    if (optind >= argc || argc < 2) {
-        cout << "usage: " << argv[0] << " scenario.xml" << endl;
-        return -1;
-    }
-
     //initialize neural network
     tiny_dnn::network<tiny_dnn::sequential> policy_network;
     size_t num_inputs_ = 9+4+4+10*n_friends_+7*n_enemies_;
     size_t loadnn = std::stoi(main_mp->params()["start_with_loaded_nn"]);
-    if(loadnn){
+    if(resume){
+        // the architecture comes from the initial network, the weights from
+        // the checkpoint
+        vec_t theta;
+        policy_network.load(main_mp->log_dir() + "/init_nn.dat");
+        if (!checkpoint.get("theta", theta) ||
+            theta.size() != policy_network.num_weights()) {
+            std::cout << "Checkpoint theta has " << theta.size()
+                      << " weights, the network has "
+                      << policy_network.num_weights() << std::endl;
+            return -1;
+        }
+        policy_network.set_weights(theta);
+    }else if(loadnn){
         policy_network.load(main_mp->params()["load_nn_path"]);
     }else{
         //number of inputs to nn are: num_self_states(9) + rel_home_base_coords(4) + rel_enemy_base_coords(4)
@@ -174,7 +1048,10 @@ int main(int argc, char *argv[])
         policy_network.init_weight();
     }
     std::string nn_path =main_mp->log_dir() + "/init_nn.dat";
-    policy_network.save(nn_path);
+    if(resume)
+        checkpoint.get("nn_path", nn_path);
+    else
+        policy_network.save(nn_path);
 
     tiny_dnn::network<tiny_dnn::sequential> zero_network;
     zero_network << fc(num_inputs_,200) << tiny_dnn::activation::tanh()
@@ -184,320 +1061,341 @@ int main(int argc, char *argv[])
     sc::AdamOptimizer<vec_t> adamoptimizer;
     adamoptimizer.setparams(beta1,beta2,epsilon);
 
+    size_t n=0;
 
-    //start main loop
-    std::vector<double> scores(num_threads,0);
-    std::ofstream score_history_file(main_mp->log_dir() + "/scores.txt");
-    std::ofstream test_score_history_file(main_mp->log_dir() + "/test_scores.txt");
+    std::string score_history_name = main_mp->log_dir() + "/scores.txt";
+    std::string test_score_history_name = main_mp->log_dir() + "/test_scores.txt";
+    std::ios_base::openmode score_mode = std::ios::out;
+
+    if(resume){
+        vec_t m, v;
+        checkpoint.get("adam_m", m);
+        checkpoint.get("adam_v", v);
+        adamoptimizer.set_moments(m, v);
+
+        checkpoint.get("generation", n);
+
+        std::string random_state;
+        checkpoint.get("random", random_state);
+        random.set_state(random_state);
+
+        // drop the scores of generations that ran after the checkpoint
+        uint64_t score_size = 0, test_score_size = 0;
+        checkpoint.get("scores_size", score_size);
+        checkpoint.get("test_scores_size", test_score_size);
+        if (boost::filesystem::exists(score_history_name))
+            boost::filesystem::resize_file(score_history_name, score_size);
+        if (boost::filesystem::exists(test_score_history_name))
+            boost::filesystem::resize_file(test_score_history_name, test_score_size);
+        score_mode = std::ios::app;
+
+        std::cout << "Resuming at generation " << n << std::endl;
+    }
 
-    bool testing = false;
-    size_t n=0;
-    while(n<num_generations)
-    {
-        if(n % test_every_n_generations == 0){
-            if(!testing)
-                testing=true;
-            else
-                testing=false;
+    // Checkpoints are written in the background while the next generation
+    // runs.
+    sc::CheckpointWriter checkpoint_writer;
+    std::string checkpoint_name = main_mp->log_dir() + "/checkpoint.bin";
+
+    // Generation n+1 is launched before the stragglers of generation n
+    // finish, as long as it samples around a policy at most max_staleness
+    // updates old. Test generations (sigma = 0) run alongside training
+    // against the saved nn.dat when async_testing is set.
+    size_t max_staleness = sc::get<int>("max_staleness", main_mp->params(), 0);
+    bool async_testing = sc::get<bool>("async_testing", main_mp->params(), false);
+
+    // cmaes adapts a diagonal plus rank cma_rank covariance and moves the
+    // mean by recombination, instead of isotropic noise and Adam. See
+    // scrimmage/math/LowRankCMAES.h
+    std::shared_ptr<const sc::LowRankCMAES> dist;
+    if(learning_algorithm == "cmaes"){
+        std::shared_ptr<sc::LowRankCMAES> cma = std::make_shared<sc::LowRankCMAES>();
+        if(resume){
+            if(!cma->load(checkpoint)){
+                cout << "The checkpoint has no cmaes state" << endl;
+                return -1;
+            }
+        }else{
+            cma->init(policy_network.get_weights().size(), num_threads,
+                      sc::get<int>("cma_rank", main_mp->params(), 10), sigma_);
         }
+        dist = cma;
 
-        if(testing){
-            testing=true;
-            param_vec[0]=0.0;
-            std::cout<<"Testing... ";
-        }else{
-            param_vec[0]=sigma_;
-            std::cout<<"Iteration #" << n+1 << ", ";
+        // the update regenerates the samples from the current distribution
+        if(max_staleness > 0)
+            cout << "max_staleness is ignored with cmaes" << endl;
+        max_staleness = 0;
+    }
+
+    // Common random numbers: each sample is scored on the same crn_scenarios
+    // scenario seeds. mirrored_sampling evaluates +eps and -eps in pairs.
+    Sampling sampling;
+    sampling.num_scenarios = sc::get<int>("crn_scenarios", main_mp->params(), 0);
+    sampling.mirrored = sc::get<bool>("mirrored_sampling", main_mp->params(), false);
+    if(sampling.mirrored && dist){
+        cout << "mirrored_sampling is ignored with cmaes" << endl;
+        sampling.mirrored = false;
+    }
+    size_t num_rollouts = num_threads*sampling.rollouts_per_sample();
+
+    // Stop a training generation once this many rollouts have finished,
+    // rounded up to whole samples (and mirrored pairs)
+    size_t accept_first_k_rollouts = sc::get<int>("accept_first_k_rollouts", main_mp->params(), num_rollouts);
+    accept_first_k_rollouts = std::max<size_t>(1, std::min(accept_first_k_rollouts, num_rollouts));
+
+    // League training: the team that isn't trained plays past policies,
+    // sampled per rollout from a pool of at most league_size. The current
+    // policy joins the pool every league_add_every_n_generations.
+    size_t league_size = sc::get<int>("league_size", main_mp->params(), 0);
+    size_t league_add_every = std::max(1, sc::get<int>("league_add_every_n_generations", main_mp->params(), 10));
+    sc::OpponentPoolPtr league;
+    if(league_size > 0){
+        league = std::make_shared<sc::OpponentPool>(
+            league_size, sc::get<double>("league_priority_exponent", main_mp->params(), 0));
+
+        std::vector<int32_t> league_ids = {-1};
+        std::vector<uint64_t> league_wins, league_losses, league_draws;
+        std::vector<double> league_total_scores;
+        if(resume){
+            checkpoint.get("league_ids", league_ids);
+            checkpoint.get("league_wins", league_wins);
+            checkpoint.get("league_losses", league_losses);
+            checkpoint.get("league_draws", league_draws);
+            checkpoint.get("league_total_scores", league_total_scores);
         }
+        for(size_t i=0;i<league_ids.size();i++){
+            sc::OpponentPtr opponent = league->add(league_ids[i], league_nn_path(main_mp->log_dir(), league_ids[i]));
+            if(!opponent)
+                return -1;
+            if(i < league_wins.size() && i < league_losses.size() &&
+               i < league_draws.size() && i < league_total_scores.size())
+                opponent->set_stats(league_wins[i], league_losses[i],
+                                    league_draws[i], league_total_scores[i]);
+        }
+    }
+    std::string league_stats_name = main_mp->log_dir() + "/league.csv";
+
+    // every rollout starts from a copy of the parsed mission
+    RolloutRunner runner;
+    runner.mission = std::make_shared<sc::MissionParse>();
+    runner.mission->parse(argv[optind]);
+    runner.param_vec = param_vec;
+    runner.sigma = sigma_;
+    runner.play_against_self = play_against_self;
+    runner.league = league;
+
+    // Rollouts run on remote workers, which keep their own copy of the
+    // policy. Each generation only sends seeds, scores and update weights.
+    if(master_address != ""){
+        if(!connect_workers(master_address, num_workers, nn_path, param_vec,
+                            learning_rate, adamoptimizer, league, dist, runner.workers))
+            return -1;
+        if(max_staleness > 0 || async_testing)
+            cout << "max_staleness and async_testing are ignored with workers" << endl;
+        max_staleness = 0;
+        async_testing = false;
+    }
 
+    std::deque<GenerationPtr> training;
+    GenerationPtr test_gen;
+    size_t n_launched = n;
 
-        random.seed(seed+n+1);
-        std::vector<sc::SimControl> simcontrol(num_threads);
-        std::vector<sc::MissionParsePtr> mp(num_threads);
+    //start main loop
+    std::ofstream score_history_file(score_history_name, score_mode);
+    std::ofstream test_score_history_file(test_score_history_name, score_mode);
 
 #if ENABLE_PYTHON_BINDINGS==1
     Py_Initialize();
 #endif
 
-        for(size_t i=0;i<num_threads;i++)
-        {
-            // Parse mission config file:
-            mp[i]=std::make_shared<sc::MissionParse>();
-            mp[i]->set_task_number(i);
-            mp[i]->set_job_number(n);
-            if (!mp[i]->parse(argv[optind])) {
-                cout << "Failed to parse file: " << argv[optind] << endl;
-                return -1;
-            }
-
-            //use our custom log directory structure
-            if(testing)
-                mp[i]->set_log_dir(main_mp->log_dir() + "/test/gen" + std::to_string(n) + "/job" + std::to_string(i));
-            else
-                mp[i]->set_log_dir(main_mp->log_dir() + "/gen" + std::to_string(n) + "/job" + std::to_string(i));
-            mp[i]->create_log_dir(false);
-
-            //set unique seed for each thread
-            mp[i]->params()["seed"] = std::to_string(random.rng_uniform_int(100,99999999));
-
-            // Setup Logger
-            std::shared_ptr<sc::Log> log(new sc::Log());
-            log->set_enable_log(false);
-            log->init(mp[i]->log_dir(), sc::Log::NONE);
-            simcontrol[i].set_log(log);
-
-            //dunno what this does, remove it?
-            sc::InterfacePtr to_gui_interface = std::make_shared<sc::Interface>();
-            sc::InterfacePtr from_gui_interface = std::make_shared<sc::Interface>();
-            to_gui_interface->set_log(log);
-            from_gui_interface->set_log(log);
-
-            simcontrol[i].set_incoming_interface(from_gui_interface);
-            simcontrol[i].set_outgoing_interface(to_gui_interface);
-
-            if(play_against_self){
-                //randomly pick a team to be peturbed
-                param_vec[7]=random.rng_uniform_int(1,2);
-            }else{
-                //peturb team 1
-                param_vec[7]=1;
+    while(n<num_generations)
+    {
+        while(n_launched<num_generations && training.size()<=max_staleness){
+            if(n_launched % test_every_n_generations == 0){
+                // only one test generation in flight
+                if(test_gen && !finish_test_generation(test_gen, runner, test_score_history_file))
+                    return -1;
+
+                test_gen = std::make_shared<Generation>(num_threads);
+                test_gen->n = n_launched;
+                test_gen->testing = true;
+                test_gen->nn_path = nn_path;
+                test_gen->log_dir = main_mp->log_dir() + "/test/gen" + std::to_string(n_launched);
+                draw_samples(*test_gen, seed, play_against_self, league, random);
+                if(!runner.launch(*test_gen, num_threads))
+                    return -1;
+                if(!async_testing && !finish_test_generation(test_gen, runner, test_score_history_file))
+                    return -1;
             }
 
-            simcontrol[i].set_mission_parse(mp[i]);
-            simcontrol[i].set_parameter_vector(param_vec);
-            simcontrol[i].set_nn_path(nn_path);
-
-
-            // Split off SimControl in it's own thread
-            if (!simcontrol[i].init()) {
-                cout << "SimControl init() failed." << endl;
+            GenerationPtr gen = std::make_shared<Generation>(num_rollouts);
+            gen->n = n_launched;
+            gen->nn_path = nn_path;
+            gen->dist = dist;
+            gen->log_dir = main_mp->log_dir() + "/gen" + std::to_string(n_launched);
+            draw_samples(*gen, seed, play_against_self, league, random, sampling);
+            if(!runner.launch(*gen, accept_first_k_rollouts))
                 return -1;
-            }
-            simcontrol[i].display_progress(false);
-            simcontrol[i].start();
+            training.push_back(gen);
+            n_launched++;
         }
 
-        // Make sure SimControl joins properly before program ends
-        for(size_t i=0;i<num_threads;i++){
-            simcontrol[i].join();
-        }
+        GenerationPtr gen = training.front();
+        training.pop_front();
 
-#if ENABLE_PYTHON_BINDINGS==1
-    Py_Finalize();
-#endif
-
-        // collect scores, do logging, add up score-weighted nn weights
-        double totalscore=0.0;
-        int num_notnan_scores=0;
-        for(size_t i=0;i<num_threads;i++)
-        {
-            // calculate scores
-            std::map<int, double> team_scores;
-            std::map<int, std::map<std::string, double>> team_metrics;
-            std::list<std::string> headers;
+        double avg_score;
+        if(!runner.finish(*gen, accept_first_k_rollouts, avg_score))
+            return -1;
 
-            // Loop through each of the metrics plugins.
-            for (sc::MetricsPtr metrics : simcontrol[i].metrics()) {
-//                cout << sc::generate_chars("=", 80) << endl;
-//                cout << metrics->name() << endl;
-//                cout << sc::generate_chars("=", 80) << endl;
-                metrics->calc_team_scores();
-//                metrics->print_team_summaries();
-
-                // Add all elements from individual metrics plugin to overall
-                // metrics data structure
-                for (auto const &team_str_double : metrics->team_metrics()) {
-                    team_metrics[team_str_double.first].insert(team_str_double.second.begin(),
-                                                               team_str_double.second.end());
-                }
+        if(league){
+            record_league_results(*gen, *league);
+            if(!write_league_stats(*league, league_stats_name))
+                return -1;
+        }
 
-                // Calculate aggregated team scores:
-                for (auto const &team_score : metrics->team_scores()) {
-                    if (team_scores.count(team_score.first) == 0) {
-                        team_scores[team_score.first] = 0;
-                    }
-                    team_scores[team_score.first] += team_score.second;
+        // only the accepted samples take part in the update. Rollouts are
+        // accepted in whole groups, so every accepted sample ran all its
+        // scenarios and has its mirror. A sample scores the average of its
+        // rollouts that aren't nan.
+        std::vector<double> scores;
+        std::vector<size_t> sample_idx;
+        size_t k = sampling.rollouts_per_sample();
+        for (size_t i=0;i<num_rollouts;i+=k){
+            if (!gen->accepted[i]) continue;
+            double total = 0;
+            size_t num_notnan = 0;
+            for (size_t j=i;j<i+k;j++){
+                if (gen->scores[j] != -1e100){
+                    total += gen->scores[j];
+                    num_notnan++;
                 }
-
-                // Create list of all csv headers
-                headers.insert(headers.end(), metrics->headers().begin(),
-                               metrics->headers().end());
             }
+            scores.push_back(num_notnan > 0 ? total/num_notnan : -1e100);
+            sample_idx.push_back(i);
+        }
+        size_t num_samples = scores.size();
 
-            // Create headers string
-            std::string csv_str = "team_id,score";
-            for (std::string header : headers) {
-                csv_str += "," + header;
-            }
-            csv_str += "\n";
-
-            // Loop over each team and generate csv output
-            for (auto const &team_str_double : team_metrics) {
-
-                // Each line starts with team_id,score
-                csv_str += std::to_string(team_str_double.first);
-                csv_str += "," + std::to_string(team_scores[team_str_double.first]);
-
-                // Loop over all possible headers, if the header doesn't exist for
-                // a specific team, default the value for that header to zero.
-                for (std::string header : headers) {
-                    csv_str += ",";
-
-                    auto it = team_str_double.second.find(header);
-                    if (it != team_str_double.second.end()) {
-                        csv_str += std::to_string(it->second);
-                    } else {
-                        csv_str += std::to_string((double)0);
-                    }
-                }
-                csv_str += "\n";
-            }
+        for (size_t i=0;i<num_samples;i++)
+            score_history_file << scores[i] << " ";
+        score_history_file << std::endl;
 
+        std::cout<<"Iteration #" << gen->n+1 << ", ";
+        std::cout<<"Avg score: "<<avg_score<<"\n";
 
-//            // Print Overall Scores
-//            cout << sc::generate_chars("=", 80) << endl;
-//            cout << "Overall Scores" << endl;
-//            cout << sc::generate_chars("=", 80) << endl;
-//            for (auto const &team_score : team_scores) {
-//                cout << "Team ID: " << team_score.first << endl;
-//                cout << "Score: " << team_score.second << endl;
-//                cout << sc::generate_chars("-", 80) << endl;
-//            }
+        if(test_gen && generation_finished(*test_gen) &&
+           !finish_test_generation(test_gen, runner, test_score_history_file))
+            return -1;
 
-            // Write CSV string to file
-            std::string out_file = mp[i]->log_dir() + "/summary.csv";
-            std::ofstream summary_file(out_file);
-            if (!summary_file.is_open()) {
-                std::cout << "could not open " << out_file
-                          << " for writing metrics" << std::endl;
-                return -1;
-            }
-            summary_file << csv_str << std::flush;
-            summary_file.close();
 
+        //rank based fitness shaping, see scrimmage/common/FitnessShaping.h
+        std::vector<double> rank_scores = dist ?
+            sc::recombination_weights(scores) :
+            sc::shape_fitness(scores, shaping, top_percentile);
 
-            //collect scores
-            if(play_against_self)
-                scores[i]=team_scores[simcontrol[i].parameter_vector()[7]];
-            else
-                scores[i]=team_scores[1];
 
-            if (!std::isnan(scores[i])){
-                totalscore+=scores[i];
-                num_notnan_scores++;
-            }else{
-                scores[i]=-1e100;
+        // the noise of each sample is regenerated from its seed, mirrored
+        // samples flip its sign. With max_staleness > 0 the gradient may
+        // come from an older policy than the one it updates.
+        std::vector<int32_t> update_seeds;
+        std::vector<double> update_scales;
+        for(size_t i=0;i<num_samples;i++){
+            if(rank_scores[i] != 0.0){
+                update_seeds.push_back(gen->seeds[sample_idx[i]]);
+                if(dist)
+                    update_scales.push_back(rank_scores[i]);
+                else
+                    update_scales.push_back(gen->signs[sample_idx[i]]/(double)num_samples/sigma_*rank_scores[i]);
             }
         }
-
-        //log time spent and scores
-        if(testing){
-            std::ofstream runtime_file(main_mp->log_dir() + "/test/gen" + std::to_string(n) + "/info.txt");
-            runtime_file << "Avg score: "<<totalscore/(double)num_notnan_scores<<std::endl;
-            runtime_file << "scores: " << std::endl;
-            for (size_t i=0;i<num_threads;i++)
-                runtime_file << scores[i] << " ";
-            runtime_file.close();
-
-            for (size_t i=0;i<num_threads;i++)
-                test_score_history_file << scores[i] << " ";
-            test_score_history_file << std::endl;
-
-            std::cout<<"Avg score: "<<totalscore/(double)num_notnan_scores<<"\n";
-            continue;
+        vec_t theta;
+        if(dist)
+            theta = apply_cma_update(policy_network, dist, update_seeds, update_scales);
+        else
+            theta = apply_update(policy_network, zero_network, adamoptimizer,
+                                 update_seeds, update_scales,
+                                 learning_rate, weight_decay);
+
+        bool league_add = league && (gen->n+1) % league_add_every == 0;
+
+        for(sc::SocketChannelPtr &worker : runner.workers){
+            sc::Checkpoint msg;
+            msg.set("type", std::string("update"));
+            msg.set("generation", static_cast<uint64_t>(gen->n));
+            msg.set("seeds", update_seeds);
+            msg.set("scales", update_scales);
+            msg.set("league_add", league_add);
+            if(!worker->send(msg)){
+                cout << "Lost connection to a worker" << endl;
+                return -1;
+            }
         }
 
-        //log time spent and scores
-        std::ofstream runtime_file(main_mp->log_dir() + "/gen" + std::to_string(n) + "/info.txt");
-        runtime_file << "Avg score: "<<totalscore/(double)num_notnan_scores<<std::endl;
-        runtime_file << "scores: " << std::endl;
-        for (size_t i=0;i<num_threads;i++)
-            runtime_file << scores[i] << " ";
-        runtime_file.close();
-
-        for (size_t i=0;i<num_threads;i++)
-            score_history_file << scores[i] << " ";
-        score_history_file << std::endl;
-
-        std::cout<<"Avg score: "<<totalscore/(double)num_notnan_scores<<"\n";
-
-
-        //sort by rank
-        std::vector<double> rank(scores.size());
-        std::vector<double> rank_scores(scores.size());
-        std::size_t m(0);
-        std::generate(std::begin(rank), std::end(rank), [&]{ return m++; });
-        std::sort(  std::begin(rank), std::end(rank), [&](double i1, double i2) { return scores[i1] < scores[i2]; } );
-
-        if (learning_algorithm.compare("evolutionstrategies")){
-            //Evolution strategies for computing updates to weights:
-            //via "Evolution Strategies as a Scalable Alternative to Reinforcement Learning" by Salimans et al 2017
-            //https://arxiv.org/pdf/1703.03864.pdf
-
-            if(num_threads>1){
-                //we want identical scores to receive the same rank.
-                size_t num_similar=0;
-                double last_value=0.0;
-                rank_scores[rank[0]]=0.0;
-                last_value=scores[rank[0]];
-                for(size_t i=1;i<num_threads;i++){
-                    if(last_value == scores[rank[i]])
-                        num_similar++;
-                    rank_scores[rank[i]]=(double) (i-num_similar);
-                    last_value=scores[rank[i]];
-                }
-                if(num_similar==m-1)
-                    for(size_t i=0;i<num_threads;i++)
-                        rank_scores[i]=1.0;
+        //save nn
+        nn_path = gen->log_dir + "/nn.dat";
+        policy_network.save(nn_path);
 
-                //do a rank transform
-                for(size_t i=0;i<num_threads;i++)
-                    rank_scores[i]=(double)(rank_scores[i]+1)/(double)(m-num_similar) - 0.5;
+        if(league_add && !league->add(gen->n, nn_path))
+            return -1;
 
-            }else{
-                rank_scores[0]=1.0;
-            }
+        n++;
 
-        }else if (learning_algorithm.compare("crossentropy")){
-            //update weights with cross entropy method.
+        if(n % checkpoint_every_n_generations == 0 || n == num_generations){
+            // the checkpoint covers the test scores up to generation n.
+            // Training generations still in flight are relaunched on resume.
+            if(test_gen && !finish_test_generation(test_gen, runner, test_score_history_file))
+                return -1;
 
-            if(num_threads>1){
-                //select top percentile of scores
-                for(size_t i=0;i<num_threads;i++){
-                    if(rank[i]>(double)num_threads*(1.0-top_percentile))
-                        rank_scores[i]=1.0;
-                    else
-                        rank_scores[i]=0.0;
+            score_history_file.flush();
+            test_score_history_file.flush();
+
+            sc::Checkpoint ckpt;
+            ckpt.set("log_dir", main_mp->log_dir());
+            ckpt.set("nn_path", nn_path);
+            ckpt.set("generation", n);
+            ckpt.set("random", random.state());
+            ckpt.set("theta", policy_network.get_weights());
+            ckpt.set("adam_m", adamoptimizer.first_moment());
+            ckpt.set("adam_v", adamoptimizer.second_moment());
+            ckpt.set("scores_size", static_cast<uint64_t>(score_history_file.tellp()));
+            ckpt.set("test_scores_size", static_cast<uint64_t>(test_score_history_file.tellp()));
+            if(dist)
+                dist->save(ckpt);
+            if(league){
+                std::vector<int32_t> league_ids;
+                std::vector<uint64_t> league_wins, league_losses, league_draws;
+                std::vector<double> league_total_scores;
+                for(const sc::OpponentPtr &opponent : league->opponents()){
+                    league_ids.push_back(opponent->id());
+                    league_wins.push_back(opponent->wins());
+                    league_losses.push_back(opponent->losses());
+                    league_draws.push_back(opponent->draws());
+                    league_total_scores.push_back(opponent->total_score());
                 }
-            }else{
-                rank_scores[0]=1.0;
+                ckpt.set("league_ids", league_ids);
+                ckpt.set("league_wins", league_wins);
+                ckpt.set("league_losses", league_losses);
+                ckpt.set("league_draws", league_draws);
+                ckpt.set("league_total_scores", league_total_scores);
             }
+            checkpoint_writer.save(std::move(ckpt), checkpoint_name);
         }
+    }
 
+    if(test_gen && !finish_test_generation(test_gen, runner, test_score_history_file))
+        return -1;
 
-        //update zero neural network with score-weighted weights, to basically keep track of the total gradient
-        zero_network.weight_init(weight_init::constant(0.0));
-        zero_network.bias_init(weight_init::constant(0.0));
-        zero_network.init_weight();
-        random.seed(seed+n+1);
-        for(size_t i=0;i<num_threads;i++){
-            zero_network.perturb_weights(random.rng_uniform_int(100,99999999), 1.0/(double)num_threads/sigma_*rank_scores[i]);
-        }
-
-        //apply optimizer update to policy_network
-        vec_t grad = zero_network.get_weights();
-        vec_t update = adamoptimizer.step(grad);
-        vec_t theta = policy_network.get_weights();
-        for(size_t i=0;i<theta.size();i++)
-            theta[i]=weight_decay*theta[i] + learning_rate*update[i];
-
-        policy_network.set_weights(&theta);
+    for(sc::SocketChannelPtr &worker : runner.workers){
+        sc::Checkpoint msg;
+        msg.set("type", std::string("stop"));
+        worker->send(msg);
+    }
 
-        //save nn
-        nn_path = main_mp->log_dir() + "/gen" + std::to_string(n) + "/nn.dat";
-        policy_network.save(nn_path);
+#if ENABLE_PYTHON_BINDINGS==1
+    Py_Finalize();
+#endif
 
-        n++;
+    if(!checkpoint_writer.wait()){
+        cout << "Failed to write checkpoint: " << checkpoint_name << endl;
     }
 
     // Close the log file
@@ -38,6 +38,7 @@
 #include <cstdlib>
 #include <memory>
 #include <scrimmage/common/Random.h>
+#include <scrimmage/common/FitnessShaping.h>
 
 #include <scrimmage/parse/MissionParse.h>
 #include <scrimmage/common/Utilities.h>
@@ -131,6 +132,13 @@ int main(int argc, char *argv[])
     double epsilon = param_vec[5];
     double weight_decay = param_vec[6];
 
+    sc::FitnessShaping shaping;
+    std::string shaping_str = sc::get<std::string>("fitness_shaping", main_mp->params(), "centered_ranks");
+    if (!sc::str2fitness_shaping(shaping_str, shaping)) {
+        std::cout << "unknown fitness_shaping: " << shaping_str << std::endl;
+        return -1;
+    }
+
     sc::Random random;
     random.seed(0);
 
@@ -443,33 +451,7 @@ int main(int argc, char *argv[])
         std::cout << "Avg scores team 1: "<<totalscore/(double)num_notnan_scores<<"   Avg scores team 2: "<<totalscore2/(double)num_notnan_scores2<<std::endl;
 
         //normalize scores with rank transformation
-        std::vector<double> rank(scores.size());
-        std::vector<double> rank_scores(scores.size());
-        std::size_t m(0);
-        std::generate(std::begin(rank), std::end(rank), [&]{ return m++; });
-        std::sort(  std::begin(rank), std::end(rank), [&](double i1, double i2) { return scores[i1] < scores[i2]; } );
-
-        //we want identical scores to receive the same rank
-        if(num_threads>1){
-            size_t num_similar=0;
-            double last_value=0.0;
-            rank_scores[rank[0]]=0.0;
-            last_value=scores[rank[0]];
-            for(size_t i=1;i<num_threads;i++){
-                if(last_value == scores[rank[i]])
-                    num_similar++;
-                rank_scores[rank[i]]=(double) (i-num_similar);
-                last_value=scores[rank[i]];
-            }
-            if(num_similar==m-1)
-                for(size_t i=0;i<num_threads;i++)
-                    rank_scores[i]=1.0;
-            for(size_t i=0;i<num_threads;i++)
-                rank_scores[i]=(double)(rank_scores[i]+1)/(double)(m-num_similar) - 0.5;
-
-        }else{
-            rank_scores[0]=1.0;
-        }
+        std::vector<double> rank_scores = sc::shape_fitness(scores, shaping);
 
         //update zero neural network with score-weighted weights, to basically keep track of the total gradient
         zero_network.weight_init(weight_init::constant(0.0));
@@ -487,7 +469,7 @@ int main(int argc, char *argv[])
         for(size_t i=0;i<theta.size();i++)
             theta[i]=weight_decay*theta[i] + learning_rate*update[i];
 
-        policy_network.set_weights(&theta);
+        policy_network.set_weights(theta);
 
         //save nn
         nn_path = main_mp->log_dir() + "/gen" + std::to_string(n) + "/nn.dat";
@@ -496,31 +478,7 @@ int main(int argc, char *argv[])
 
 
         //normalize scores with rank transformation
-        m=0;
-        std::generate(std::begin(rank), std::end(rank), [&]{ return m++; });
-        std::sort(  std::begin(rank), std::end(rank), [&](double i1, double i2) { return scores2[i1] < scores2[i2]; } );
-
-        //we want identical scores to receive the same rank
-        if(num_threads>1){
-            size_t num_similar=0;
-            double last_value=0.0;
-            rank_scores[rank[0]]=0.0;
-            last_value=scores2[rank[0]];
-            for(size_t i=1;i<num_threads;i++){
-                if(last_value == scores2[rank[i]])
-                    num_similar++;
-                rank_scores[rank[i]]=(double) (i-num_similar);
-                last_value=scores2[rank[i]];
-            }
-            if(num_similar==m-1)
-                for(size_t i=0;i<num_threads;i++)
-                    rank_scores[i]=1.0;
-            for(size_t i=0;i<num_threads;i++)
-                rank_scores[i]=(double)(rank_scores[i]+1)/(double)(m-num_similar) - 0.5;
-
-        }else{
-            rank_scores[0]=1.0;
-        }
+        rank_scores = sc::shape_fitness(scores2, shaping);
 
         //update zero neural network with score-weighted weights, to basically keep track of the total gradient
         zero_network.weight_init(weight_init::constant(0.0));
@@ -538,7 +496,7 @@ int main(int argc, char *argv[])
         for(size_t i=0;i<theta.size();i++)
             theta[i]=weight_decay*theta[i] + learning_rate*update[i];
 
-        policy_network2.set_weights(&theta);
+        policy_network2.set_weights(theta);
 
         //save nn
         nn_path2 = main_mp->log_dir() + "/gen" + std::to_string(n) + "/nn2.dat";
@@ -30,7 +30,9 @@
 #include <chrono>
 #include <ctime>
 #include <signal.h>
+#include <unistd.h>
 #include <thread>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -62,16 +64,25 @@ void HandleSignal(int s)
 
 void playback_loop(std::shared_ptr<sc::Log> log, 
                    sc::InterfacePtr in_interface, 
-                   sc::InterfacePtr out_interface)
+                   sc::InterfacePtr out_interface,
+                   double start_time)
 {
+    // Frames are decoded on demand from the memory-mapped frames.bin.
+    // Columnar logs have no lazy reader and are loaded into frames().
+    sc::FrameReaderPtr &reader = log->frame_reader();
+    std::vector<std::shared_ptr<sp::Frame>> loaded;
+    if (reader == nullptr) {
+        loaded.assign(log->frames().begin(), log->frames().end());
+    }
+    size_t num_frames = reader ? reader->size() : loaded.size();
+    auto frame_time = [&](size_t i) {
+        return reader ? reader->time(i) : loaded[i]->time();
+    };
+
     // Get dt from first two frames
     double dt = 0.1;
-    if (log->frames().size() >= 2) {
-        auto it = log->frames().begin();
-        double t0 = (*it)->time();
-        ++it;
-        double t1 = (*it)->time();
-        dt = t1 - t0;
+    if (num_frames >= 2) {
+        dt = frame_time(1) - frame_time(0);
     } else {
         cout << "Fewer than two frames parsed. Using dt: " << dt << endl;
     }
@@ -91,31 +102,47 @@ void playback_loop(std::shared_ptr<sc::Log> log,
     auto it_shapes = log->shapes().begin();
     auto it_utm_terrain = log->utm_terrain().begin();
     auto it_contact_visual = log->contact_visual().begin();
-        
+
+    // Seek directly to the requested start time. Shapes with a time to
+    // live need to be drawn from their creation time, so they are still
+    // replayed from the start of the log below.
+    size_t i_start = 0;
+    if (reader) {
+        i_start = reader->find(start_time);
+    } else {
+        while (i_start < num_frames && frame_time(i_start) < start_time) i_start++;
+    }
+
     timer.start_overall_timer();
-    for (auto it = log->frames().begin(); it != log->frames().end(); it++) {
+    for (size_t i = i_start; i < num_frames; i++) {
         timer.start_loop_timer();
+        std::shared_ptr<sp::Frame> frame = reader ? reader->read(i) : loaded[i];
+        if (frame == nullptr) {
+            cout << "Failed to decode frame " << i << endl;
+            break;
+        }
+
         // Send all other messages up to current frame time before sending
         // current frame
         while (it_shapes != log->shapes().end() && 
-               (*it_shapes)->time() <= (*it)->time()) {
+               (*it_shapes)->time() <= frame->time()) {
             out_interface->send_shapes(**it_shapes);            
             ++it_shapes;
         }
 
         while (it_utm_terrain != log->utm_terrain().end() && 
-               (*it_utm_terrain)->time() <= (*it)->time()) {
+               (*it_utm_terrain)->time() <= frame->time()) {
             out_interface->send_utm_terrain(*it_utm_terrain);
             ++it_utm_terrain;
         }
 
         while (it_contact_visual != log->contact_visual().end() && 
-               (*it_contact_visual)->time() <= (*it)->time()) {
+               (*it_contact_visual)->time() <= frame->time()) {
             out_interface->send_contact_visual(*it_contact_visual);
             ++it_contact_visual;
         }
         
-        out_interface->send_frame(*it);        
+        out_interface->send_frame(frame);        
         
         // Wait loop timer.
         // Stay in loop if currently paused.
@@ -152,7 +179,7 @@ void playback_loop(std::shared_ptr<sc::Log> log,
             }
 
             scrimmage_proto::SimInfo info;
-            info.set_time((*it)->time());
+            info.set_time(frame->time());
             info.set_desired_warp(timer.time_warp());
             info.set_actual_warp(timer.time_warp());
             out_interface->send_sim_info(info);
@@ -176,14 +203,33 @@ int main(int argc, char *argv[])
     sigaction(SIGINT,&sa,NULL);
     sigaction(SIGTERM,&sa,NULL);
 
-    if (optind >= argc || argc < 2) {
-        cout << "usage: " << argv[0] << " /path/to/log-dir" << endl;
+    double start_time = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:")) != -1) {
+        switch (opt) {
+        case 's':
+            start_time = std::stod(optarg);
+            break;
+        default:
+            cout << "usage: " << argv[0] << " [-s start_time] /path/to/log-dir" << endl;
+            return -1;
+        }
+    }
+
+    if (optind >= argc) {
+        cout << "usage: " << argv[0] << " [-s start_time] /path/to/log-dir" << endl;
         return -1;
     }
 
     // Setup Logger
     std::shared_ptr<sc::Log> log(new sc::Log);
-    log->init(std::string(argv[1]), sc::Log::READ);        
+    log->set_lazy_frames(true);
+    log->init(std::string(argv[optind]), sc::Log::READ);        
+
+    if (log->frame_reader() == nullptr && log->frames().empty()) {
+        cout << "No frames to play back." << endl;
+        return -1;
+    }
     
     sc::InterfacePtr to_gui_interface(new sc::Interface);
     sc::InterfacePtr from_gui_interface(new sc::Interface);
@@ -199,10 +245,14 @@ int main(int argc, char *argv[])
     //std::thread server_thread(&Interface::init_network, &(*incoming_interface_), 
     //                          Interface::server, "localhost", 50051);
     
-    cout << "Frames parsed: " << log->frames().size() << endl;
+    if (log->frame_reader()) {
+        cout << "Frames indexed: " << log->frame_reader()->size() << endl;
+    } else {
+        cout << "Frames loaded: " << log->frames().size() << endl;
+    }
     
     std::thread playback(playback_loop, log, from_gui_interface, 
-                         to_gui_interface);    
+                         to_gui_interface, start_time);    
     playback.detach(); // todo
     
     sc::Viewer viewer;
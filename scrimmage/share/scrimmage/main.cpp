@@ -153,10 +153,12 @@ int main(int argc, char *argv[])
     bool output_frames = output_all || output_type.find("frames") != std::string::npos;
     bool output_summary = output_all || output_type.find("summary") != std::string::npos;
     bool output_git = output_all || output_type.find("git_commits");
+    bool output_columnar = output_type.find("columnar") != std::string::npos;
 
     // Setup Logger
     std::shared_ptr<sc::Log> log(new sc::Log());
-    if (output_frames) {
+    if (output_frames || output_columnar) {
+        log->set_columnar_frames(output_columnar);
         log->set_enable_log(true);
         log->init(mp->log_dir(), sc::Log::WRITE);
     } else {
@@ -30,6 +30,7 @@
 #include <scrimmage/autonomy/Autonomy.h>
 //#include <scrimmage/proto/Shape.pb.h>
 #include <scrimmage/math/State.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 #include <GeographicLib/LocalCartesian.hpp>
 
 namespace scrimmage {
@@ -54,6 +55,10 @@ RTreePtr &Autonomy::rtree() {return rtree_;}
 
 void Autonomy::set_rtree(RTreePtr &rtree) {rtree_ = rtree;}
 
+EntityIndexPtr &Autonomy::entity_index() {return entity_index_;}
+
+void Autonomy::set_entity_index(EntityIndexPtr &entity_index) {entity_index_ = entity_index;}
+
 StatePtr &Autonomy::state() {return state_;}
 
 void Autonomy::set_state(StatePtr &state) {state_ = state;}
@@ -76,12 +81,27 @@ bool Autonomy::step_autonomy(double t, double dt) { return false; }
 bool Autonomy::posthumous(double t) { return true; }
 void Autonomy::init() {}
 void Autonomy::init(std::map<std::string, std::string> &params) {}
+bool Autonomy::reset(std::map<std::string, std::string> &params) { return false; }
 bool Autonomy::need_reset() {return need_reset_;}
 
 StatePtr &Autonomy::desired_state() {return desired_state_;}
 
 void Autonomy::set_desired_state(StatePtr desired_state) {desired_state_ = desired_state;}
 
+void Autonomy::save_state(Snapshot &snapshot, const std::string &prefix)
+{
+    Plugin::save_state(snapshot, prefix);
+    snapshot.set(prefix + "/desired_state", *desired_state_);
+}
+
+bool Autonomy::restore_state(const Snapshot &snapshot, const std::string &prefix)
+{
+    if (!snapshot.get(prefix + "/desired_state", *desired_state_)) {
+        return false;
+    }
+    return Plugin::restore_state(snapshot, prefix);
+}
+
 ContactMapPtr &Autonomy::get_contacts() {return contacts_;}
 
 ContactMap &Autonomy::get_contacts_raw() {return *contacts_;}
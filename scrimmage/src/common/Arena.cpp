@@ -0,0 +1,106 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <sys/mman.h>
+
+#include <iostream>
+
+#include <scrimmage/common/Arena.h>
+
+namespace scrimmage {
+
+constexpr size_t Arena::granularity;
+constexpr size_t Arena::max_block_size;
+
+ArenaPtr Arena::create(size_t capacity) {
+    return ArenaPtr(new Arena(capacity), [](Arena *arena) { arena->unref(); });
+}
+
+Arena::Arena(size_t capacity) :
+    begin_(nullptr), next_(nullptr), end_(nullptr), bytes_in_use_(0),
+    owner_(std::this_thread::get_id()), refs_(1) {
+    free_.fill(nullptr);
+    if (capacity == 0) return;
+
+    // address space only, pages are backed as blocks are handed out
+    void *p = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        std::cout << "Failed to reserve arena, using the heap" << std::endl;
+        return;
+    }
+    begin_ = next_ = static_cast<char*>(p);
+    end_ = begin_ + capacity;
+}
+
+Arena::~Arena() {
+    if (begin_) munmap(begin_, end_ - begin_);
+}
+
+void Arena::unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+}
+
+void Arena::set_owner_thread() {
+    owner_ = std::this_thread::get_id();
+}
+
+void *Arena::allocate(size_t bytes, size_t alignment) {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    if (pooled(bytes, alignment) && owner()) {
+        size_t c = size_class(bytes);
+        size_t block_size = (c + 1) * granularity;
+        FreeBlock *block = free_[c];
+        if (block) {
+            free_[c] = block->next;
+            bytes_in_use_ += block_size;
+            return block;
+        }
+        if (static_cast<size_t>(end_ - next_) >= block_size) {
+            void *p = next_;
+            next_ += block_size;
+            bytes_in_use_ += block_size;
+            return p;
+        }
+    }
+    return ::operator new(bytes);
+}
+
+void Arena::deallocate(void *p, size_t bytes, size_t alignment) {
+    if (!contains(p)) {
+        ::operator delete(p);
+    } else if (owner()) {
+        size_t c = size_class(bytes);
+        FreeBlock *block = static_cast<FreeBlock*>(p);
+        block->next = free_[c];
+        free_[c] = block;
+        bytes_in_use_ -= (c + 1) * granularity;
+    }
+    unref();
+}
+
+} // namespace scrimmage
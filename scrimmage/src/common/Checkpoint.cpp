@@ -0,0 +1,222 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <iostream>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <scrimmage/common/Checkpoint.h>
+
+using std::cout;
+using std::endl;
+
+namespace scrimmage {
+
+namespace {
+const char CHECKPOINT_MAGIC[8] = {'S', 'C', 'C', 'K', 'P', 'T', '0', '1'};
+
+// FNV-1a, to detect torn or corrupted files
+uint64_t checksum(const std::string &data)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <class T>
+void append(std::string &buf, const T &value)
+{
+    buf.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T>
+bool extract(const std::string &buf, size_t &pos, T &value)
+{
+    if (pos + sizeof(T) > buf.size()) return false;
+    std::memcpy(&value, buf.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+} // namespace
+
+bool Checkpoint::get(std::string key, std::string &value) const
+{
+    auto it = fields_.find(key);
+    if (it == fields_.end()) return false;
+    value = it->second;
+    return true;
+}
+
+bool Checkpoint::has(std::string key) const { return fields_.count(key) > 0; }
+
+void Checkpoint::clear() { fields_.clear(); }
+
+std::string Checkpoint::serialize() const
+{
+    std::string body;
+    append(body, static_cast<uint64_t>(fields_.size()));
+    for (auto &kv : fields_) {
+        append(body, static_cast<uint64_t>(kv.first.size()));
+        body += kv.first;
+        append(body, static_cast<uint64_t>(kv.second.size()));
+        body += kv.second;
+    }
+    return body;
+}
+
+bool Checkpoint::deserialize(const std::string &body)
+{
+    fields_.clear();
+
+    size_t pos = 0;
+    uint64_t count;
+    if (!extract(body, pos, count)) return false;
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t key_size, value_size;
+        if (!extract(body, pos, key_size) || key_size > body.size() - pos) break;
+        std::string key = body.substr(pos, key_size);
+        pos += key_size;
+        if (!extract(body, pos, value_size) || value_size > body.size() - pos) break;
+        fields_[key] = body.substr(pos, value_size);
+        pos += value_size;
+    }
+
+    if (fields_.size() != count) {
+        fields_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Checkpoint::save(std::string filename)
+{
+    std::string body = serialize();
+
+    std::string data(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    append(data, checksum(body));
+    data += body;
+
+    std::string tmp = filename + ".tmp";
+    int fd = ::open(tmp.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    if (fd == -1) {
+        cout << "Failed to open file for writing: " << tmp << endl;
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n <= 0) {
+            cout << "Failed to write checkpoint: " << tmp << endl;
+            ::close(fd);
+            return false;
+        }
+        written += n;
+    }
+
+    if (::fsync(fd) != 0 || ::close(fd) != 0) {
+        cout << "Failed to sync checkpoint: " << tmp << endl;
+        return false;
+    }
+
+    if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+        cout << "Failed to rename " << tmp << " to " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+bool Checkpoint::load(std::string filename)
+{
+    fields_.clear();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        cout << "Failed to open file: " << filename << endl;
+        return false;
+    }
+
+    std::string data;
+    char buf[1 << 16];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+        data.append(buf, n);
+    }
+    ::close(fd);
+
+    size_t header_size = sizeof(CHECKPOINT_MAGIC) + sizeof(uint64_t);
+    if (n < 0 || data.size() < header_size ||
+        data.compare(0, sizeof(CHECKPOINT_MAGIC), CHECKPOINT_MAGIC,
+                     sizeof(CHECKPOINT_MAGIC)) != 0) {
+        cout << "Not a checkpoint file: " << filename << endl;
+        return false;
+    }
+
+    size_t pos = sizeof(CHECKPOINT_MAGIC);
+    uint64_t expected;
+    extract(data, pos, expected);
+    std::string body = data.substr(pos);
+    if (checksum(body) != expected) {
+        cout << "Checkpoint is corrupt: " << filename << endl;
+        return false;
+    }
+
+    if (!deserialize(body)) {
+        cout << "Checkpoint is corrupt: " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+CheckpointWriter::CheckpointWriter() : success_(true) {}
+
+CheckpointWriter::~CheckpointWriter() { wait(); }
+
+void CheckpointWriter::save(Checkpoint &&checkpoint, std::string filename)
+{
+    wait();
+    auto ckpt = std::make_shared<Checkpoint>(std::move(checkpoint));
+    thread_ = std::thread([this, ckpt, filename]() {
+            success_ = ckpt->save(filename);
+        });
+}
+
+bool CheckpointWriter::wait()
+{
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return success_;
+}
+
+} // namespace scrimmage
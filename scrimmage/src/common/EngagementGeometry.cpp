@@ -0,0 +1,179 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <algorithm>
+#include <limits>
+
+#include <scrimmage/common/EngagementGeometry.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+
+namespace scrimmage {
+
+const Engagement *EngagementRow::find(int target_id) const
+{
+    auto it = std::lower_bound(engagements_.begin(), engagements_.end(),
+                               target_id,
+                               [](const Engagement &e, int id) {
+                                   return e.target_id < id;
+                               });
+    if (it == engagements_.end() || it->target_id != target_id) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+EngagementGeometry::EngagementGeometry() :
+    max_range_(std::numeric_limits<double>::infinity()), stamp_(0),
+    row_stamps_size_(0)
+{
+}
+
+void EngagementGeometry::set_max_range(double max_range)
+{
+    max_range_ = max_range < 0 ?
+        std::numeric_limits<double>::infinity() : max_range;
+}
+
+void EngagementGeometry::update(const std::list<EntityPtr> &ents)
+{
+    std::vector<Entity *> sorted;
+    sorted.reserve(ents.size());
+    for (const EntityPtr &ent : ents) sorted.push_back(ent.get());
+    std::sort(sorted.begin(), sorted.end(), [](Entity *a, Entity *b) {
+            return a->id().id() < b->id().id();
+        });
+
+    size_t n = sorted.size();
+    ids_.resize(n);
+    x_.resize(n);
+    y_.resize(n);
+    z_.resize(n);
+    world_to_body_.resize(n);
+    rows_.resize(n);
+
+    int max_id = n == 0 ? -1 : sorted.back()->id().id();
+    index_.assign(max_id + 1, -1);
+
+    for (size_t i = 0; i < n; i++) {
+        StatePtr &state = sorted[i]->state();
+        ids_[i] = sorted[i]->id().id();
+        index_[ids_[i]] = i;
+        x_[i] = state->pos()(0);
+        y_[i] = state->pos()(1);
+        z_[i] = state->pos()(2);
+        world_to_body_[i] = state->rotation().transpose();
+    }
+
+    if (n > row_stamps_size_) {
+        row_stamps_.reset(new std::atomic<uint64_t>[n]);
+        for (size_t i = 0; i < n; i++) row_stamps_[i] = 0;
+        row_stamps_size_ = n;
+    }
+    stamp_++;
+}
+
+int EngagementGeometry::index(int id) const
+{
+    if (id < 0 || id >= static_cast<int>(index_.size())) return -1;
+    return index_[id];
+}
+
+bool EngagementGeometry::contains(int id) const
+{
+    return index(id) != -1;
+}
+
+const EngagementRow *EngagementGeometry::row(int src_id)
+{
+    int i = index(src_id);
+    if (i == -1) return nullptr;
+
+    if (row_stamps_[i].load(std::memory_order_acquire) != stamp_) {
+        // Fill outside the lock so sources in different threads don't wait
+        // on each other. Two threads asking for the same row both fill it
+        // and the first one to finish wins.
+        thread_local std::vector<Engagement> engagements;
+        fill(i, engagements);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (row_stamps_[i].load(std::memory_order_relaxed) != stamp_) {
+            rows_[i].engagements_.assign(engagements.begin(), engagements.end());
+            row_stamps_[i].store(stamp_, std::memory_order_release);
+        }
+    }
+    return &rows_[i];
+}
+
+bool EngagementGeometry::get(int src_id, int target_id, Engagement &engagement)
+{
+    const EngagementRow *src_row = row(src_id);
+    if (src_row == nullptr) return false;
+
+    const Engagement *e = src_row->find(target_id);
+    if (e == nullptr) return false;
+
+    engagement = *e;
+    return true;
+}
+
+void EngagementGeometry::fill(size_t src, std::vector<Engagement> &engagements) const
+{
+    engagements.clear();
+    size_t n = ids_.size();
+    double px = x_[src], py = y_[src], pz = z_[src];
+    double max_dist_sq = max_range_ * max_range_;
+
+    // Squared ranges to every entity in one pass over the coordinates, so
+    // the compiler can vectorize it, before the rotations and arctangents
+    // of the entities that are close enough
+    thread_local std::vector<double> dist_sq;
+    dist_sq.resize(n);
+    for (size_t j = 0; j < n; j++) {
+        double dx = x_[j] - px;
+        double dy = y_[j] - py;
+        double dz = z_[j] - pz;
+        dist_sq[j] = dx * dx + dy * dy + dz * dz;
+    }
+
+    const Eigen::Matrix3d &world_to_body = world_to_body_[src];
+    for (size_t j = 0; j < n; j++) {
+        if (j == src || dist_sq[j] > max_dist_sq) continue;
+
+        Eigen::Vector3d diff(x_[j] - px, y_[j] - py, z_[j] - pz);
+
+        Engagement e;
+        e.target_id = ids_[j];
+        e.rel_pos = world_to_body * diff;
+        e.range = std::sqrt(dist_sq[j]);
+        e.az = atan2(e.rel_pos(1), e.rel_pos(0));
+        e.el = atan2(e.rel_pos(2), e.rel_pos.head<2>().norm());
+        engagements.push_back(e);
+    }
+}
+
+}  // namespace scrimmage
@@ -0,0 +1,241 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include <scrimmage/common/FitnessShaping.h>
+
+namespace scrimmage {
+
+namespace {
+typedef std::pair<double, uint32_t> Key;
+
+// (score, index) pairs sorted by score, with nan as -infinity. Sorting the
+// pairs avoids an indirect load in every comparison.
+std::vector<Key> sorted_keys(const std::vector<double> &scores)
+{
+    std::vector<Key> keys(scores.size());
+    for (uint32_t i = 0; i < scores.size(); i++) {
+        double s = scores[i];
+        keys[i] = Key(std::isnan(s) ? -std::numeric_limits<double>::infinity() : s, i);
+    }
+    std::sort(keys.begin(), keys.end(),
+              [](const Key &a, const Key &b) { return a.first < b.first; });
+    return keys;
+}
+
+// Calls f(begin, end) for each run of tied scores in keys
+template <class F>
+void for_each_tie(const std::vector<Key> &keys, F f)
+{
+    size_t begin = 0;
+    while (begin < keys.size()) {
+        size_t end = begin + 1;
+        while (end < keys.size() && keys[end].first == keys[begin].first) end++;
+        f(begin, end);
+        begin = end;
+    }
+}
+} // namespace
+
+bool str2fitness_shaping(std::string str, FitnessShaping &shaping)
+{
+    if (str == "centered_ranks") {
+        shaping = FitnessShaping::CENTERED_RANKS;
+    } else if (str == "utility") {
+        shaping = FitnessShaping::UTILITY;
+    } else if (str == "dense_ranks") {
+        shaping = FitnessShaping::DENSE_RANKS;
+    } else if (str == "elite") {
+        shaping = FitnessShaping::ELITE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint32_t> argsort(const std::vector<double> &scores)
+{
+    std::vector<Key> keys = sorted_keys(scores);
+
+    // put each tie back in index order
+    for_each_tie(keys, [&](size_t begin, size_t end) {
+        if (end - begin > 1) {
+            std::sort(keys.begin() + begin, keys.begin() + end,
+                      [](const Key &a, const Key &b) { return a.second < b.second; });
+        }
+    });
+
+    std::vector<uint32_t> order(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) order[i] = keys[i].second;
+    return order;
+}
+
+std::vector<double> fractional_ranks(const std::vector<double> &scores)
+{
+    std::vector<Key> keys = sorted_keys(scores);
+    std::vector<double> ranks(scores.size());
+    for_each_tie(keys, [&](size_t begin, size_t end) {
+        double rank = 0.5 * (begin + end - 1);
+        for (size_t i = begin; i < end; i++) ranks[keys[i].second] = rank;
+    });
+    return ranks;
+}
+
+std::vector<double> centered_ranks(const std::vector<double> &scores)
+{
+    size_t n = scores.size();
+    if (n < 2) return std::vector<double>(n, 0.0);
+
+    std::vector<Key> keys = sorted_keys(scores);
+    std::vector<double> weights(n);
+    double scale = 1.0 / (n - 1);
+    for_each_tie(keys, [&](size_t begin, size_t end) {
+        double w = 0.5 * (begin + end - 1) * scale - 0.5;
+        for (size_t i = begin; i < end; i++) weights[keys[i].second] = w;
+    });
+    return weights;
+}
+
+std::vector<double> utility_weights(const std::vector<double> &scores)
+{
+    size_t n = scores.size();
+    if (n < 2) return std::vector<double>(n, 0.0);
+
+    // utility by position in ascending order, the best sample is last
+    std::vector<double> utility(n);
+    double log_half = std::log(n / 2.0 + 1.0);
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        utility[i] = std::max(0.0, log_half - std::log(static_cast<double>(n - i)));
+        sum += utility[i];
+    }
+
+    std::vector<Key> keys = sorted_keys(scores);
+    std::vector<double> weights(n);
+    for_each_tie(keys, [&](size_t begin, size_t end) {
+        double u = 0;
+        for (size_t i = begin; i < end; i++) u += utility[i];
+        double w = u / (end - begin) / sum - 1.0 / n;
+        for (size_t i = begin; i < end; i++) weights[keys[i].second] = w;
+    });
+    return weights;
+}
+
+std::vector<double> dense_rank_weights(const std::vector<double> &scores)
+{
+    size_t n = scores.size();
+    if (n < 2) return std::vector<double>(n, 1.0);
+
+    std::vector<Key> keys = sorted_keys(scores);
+    std::vector<double> weights(n);
+    size_t num_distinct = 0;
+    for_each_tie(keys, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) weights[keys[i].second] = num_distinct;
+        num_distinct++;
+    });
+
+    // the original code gave every sample 1.5 when all scores were equal
+    if (num_distinct == 1) std::fill(weights.begin(), weights.end(), 1.0);
+
+    for (double &w : weights) w = (w + 1) / num_distinct - 0.5;
+    return weights;
+}
+
+std::vector<double> elite_weights(const std::vector<double> &scores,
+                                  double fraction)
+{
+    size_t n = scores.size();
+    std::vector<double> weights(n, 0.0);
+    if (n == 0) return weights;
+
+    size_t num_elite = static_cast<size_t>(std::ceil(fraction * n));
+    num_elite = std::max<size_t>(1, std::min(num_elite, n));
+
+    // only the top num_elite need to be in order
+    std::vector<Key> keys(n);
+    for (uint32_t i = 0; i < n; i++) {
+        double s = scores[i];
+        keys[i] = Key(std::isnan(s) ? -std::numeric_limits<double>::infinity() : s, i);
+    }
+    auto by_score = [](const Key &a, const Key &b) { return a.first < b.first; };
+    std::nth_element(keys.begin(), keys.begin() + (n - num_elite), keys.end(), by_score);
+
+    double threshold = keys[n - num_elite].first;
+    for (const Key &k : keys) {
+        if (k.first >= threshold) weights[k.second] = 1.0;
+    }
+    return weights;
+}
+
+std::vector<double> recombination_weights(const std::vector<double> &scores)
+{
+    size_t n = scores.size();
+    if (n < 2) return std::vector<double>(n, 1.0);
+
+    // weight by position in ascending order, the best sample is last
+    size_t mu = n / 2;
+    std::vector<double> position_weight(n, 0.0);
+    double sum = 0;
+    for (size_t k = 1; k <= mu; k++) {
+        position_weight[n - k] = std::log(mu + 0.5) - std::log(static_cast<double>(k));
+        sum += position_weight[n - k];
+    }
+
+    std::vector<Key> keys = sorted_keys(scores);
+    std::vector<double> weights(n);
+    for_each_tie(keys, [&](size_t begin, size_t end) {
+        double w = 0;
+        for (size_t i = begin; i < end; i++) w += position_weight[i];
+        w /= (end - begin) * sum;
+        for (size_t i = begin; i < end; i++) weights[keys[i].second] = w;
+    });
+    return weights;
+}
+
+std::vector<double> shape_fitness(const std::vector<double> &scores,
+                                  FitnessShaping shaping,
+                                  double elite_fraction)
+{
+    switch (shaping) {
+    case FitnessShaping::UTILITY:
+        return utility_weights(scores);
+    case FitnessShaping::DENSE_RANKS:
+        return dense_rank_weights(scores);
+    case FitnessShaping::ELITE:
+        return elite_weights(scores, elite_fraction);
+    case FitnessShaping::CENTERED_RANKS:
+    default:
+        return centered_ranks(scores);
+    }
+}
+
+} // namespace scrimmage
@@ -13,11 +13,11 @@ void ID::set_sub_swarm_id(int sub_swarm_id) {sub_swarm_id_ = sub_swarm_id; }
 
 void ID::set_team_id(int team_id) { team_id_ = team_id; }
 
-int ID::id() { return id_; }
+int ID::id() const { return id_; }
 
-int ID::sub_swarm_id() { return sub_swarm_id_; }
+int ID::sub_swarm_id() const { return sub_swarm_id_; }
 
-int ID::team_id() { return team_id_; }
+int ID::team_id() const { return team_id_; }
 
 bool ID::operator==(const ID &other) const {
     return id_ == other.id_ &&
@@ -0,0 +1,136 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <scrimmage/common/OpponentPool.h>
+#include <scrimmage/common/Random.h>
+
+namespace scrimmage {
+
+Opponent::Opponent(int32_t id, std::string nn_path) :
+    id_(id), nn_path_(nn_path), wins_(0), losses_(0), draws_(0),
+    total_score_(0)
+{
+}
+
+bool Opponent::load()
+{
+    std::shared_ptr<Network> network = std::make_shared<Network>();
+    try {
+        network->load(nn_path_);
+    } catch (tiny_dnn::nn_error &e) {
+        std::cout << "Opponent: failed to load " << nn_path_ << ": "
+                  << e.what() << std::endl;
+        return false;
+    }
+    network_ = network;
+    return true;
+}
+
+void Opponent::record(double score, double opponent_score)
+{
+    if (score > opponent_score) {
+        wins_++;
+    } else if (score < opponent_score) {
+        losses_++;
+    } else {
+        draws_++;
+    }
+    total_score_ += score;
+}
+
+double Opponent::win_rate() const
+{
+    if (games() == 0) return 0.5;
+    return (wins_ + 0.5 * draws_) / games();
+}
+
+double Opponent::avg_score() const
+{
+    return games() == 0 ? 0 : total_score_ / games();
+}
+
+void Opponent::set_stats(uint64_t wins, uint64_t losses, uint64_t draws,
+                         double total_score)
+{
+    wins_ = wins;
+    losses_ = losses;
+    draws_ = draws;
+    total_score_ = total_score;
+}
+
+OpponentPool::OpponentPool(size_t max_size, double priority_exponent) :
+    max_size_(std::max<size_t>(1, max_size)),
+    priority_exponent_(priority_exponent)
+{
+}
+
+OpponentPtr OpponentPool::add(int32_t id, std::string nn_path)
+{
+    OpponentPtr opponent = std::make_shared<Opponent>(id, nn_path);
+    if (!opponent->load()) return nullptr;
+
+    opponents_.push_back(opponent);
+    while (opponents_.size() > max_size_) opponents_.pop_front();
+    return opponent;
+}
+
+OpponentPtr OpponentPool::find(int32_t id) const
+{
+    for (const OpponentPtr &opponent : opponents_) {
+        if (opponent->id() == id) return opponent;
+    }
+    return nullptr;
+}
+
+OpponentPtr OpponentPool::sample(Random &random) const
+{
+    if (opponents_.empty()) return nullptr;
+
+    std::vector<double> weights(opponents_.size());
+    for (size_t i = 0; i < opponents_.size(); i++) {
+        // opponents that are always beaten still get picked now and then
+        double loss_rate = std::max(1.0 - opponents_[i]->win_rate(), 1e-3);
+        weights[i] = std::pow(loss_rate, priority_exponent_);
+    }
+    return opponents_[random.rng_discrete_int(weights)];
+}
+
+void OpponentPool::write_stats(std::ostream &out) const
+{
+    for (const OpponentPtr &opponent : opponents_) {
+        out << opponent->id() << "," << opponent->games() << ","
+            << opponent->wins() << "," << opponent->losses() << ","
+            << opponent->draws() << "," << opponent->win_rate() << ","
+            << opponent->avg_score() << std::endl;
+    }
+}
+
+} // namespace scrimmage
@@ -55,6 +55,16 @@ namespace scrimmage {
 
     void PID::set_is_angle(bool is_angle) { is_angle_ = is_angle; }
 
+    double PID::integral() { return integral_; }
+
+    double PID::prev_error() { return prev_error_; }
+
+    void PID::set_state(double integral, double prev_error)
+    {
+        integral_ = integral;
+        prev_error_ = prev_error;
+    }
+
     double PID::step(double dt, double measurement)
     {
         double error = setpoint_ - measurement;
@@ -29,12 +29,26 @@
 #include <boost/geometry.hpp>
 #include <boost/geometry/index/rtree.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace bg = boost::geometry;
 namespace bgi = boost::geometry::index;
 
 namespace scrimmage {
 
-RTree::RTree() {}
+// Members per grid cell the neighbor groups aim for
+static const size_t MEMBERS_PER_CELL = 4;
+
+// Limit on the grid cells per axis
+static const int MAX_CELLS_PER_AXIS = 1024;
+
+// Rows per thread below which compute_neighbors() stays single threaded
+static const size_t MIN_ROWS_PER_THREAD = 64;
+
+RTree::RTree() : size_(0), neighbors_k_(0), neighbors_by_team_(false),
+                 neighbors_all_teams_(false), num_threads_(1),
+                 neighbors_valid_(false) {}
 
 void RTree::init(int size)
 {
@@ -47,12 +61,17 @@ void RTree::init(int size)
 void RTree::clear() {
     rtree_->clear(); 
     rtree_team_.clear();
+    positions_.clear();
+    ids_.clear();
+    neighbors_valid_ = false;
 }
 
 void RTree::add(Eigen::Vector3d &pos, ID &id) {
     point p(pos(0), pos(1), pos(2));
     std::pair<point, ID> pair(p, id);
     rtree_->insert(pair);
+    positions_.push_back(pos);
+    ids_.push_back(id);
 
     int team_id = id.team_id();
     auto it = rtree_team_.find(team_id);
@@ -83,7 +102,7 @@ void results_to_neighbors(std::list<point_id_t> &results,
 
 void RTree::nearest_n_neighbors(const Eigen::Vector3d &pos,
                                 std::vector<ID> &neighbors, unsigned int n,
-                                int self_id, int team_id)
+                                int self_id, int team_id) const
 {
     std::list<point_id_t> results;
     point sought(pos(0), pos(1), pos(2));
@@ -111,7 +130,7 @@ void RTree::nearest_n_neighbors(const Eigen::Vector3d &pos,
 void RTree::neighbors_in_range(const Eigen::Vector3d &pos,
                                std::vector<ID> &neighbors,
                                double dist,
-                               int self_id, int team_id) {
+                               int self_id, int team_id) const {
     // see here: http://stackoverflow.com/a/22910447
     std::list<point_id_t> results;
     double x = pos(0);
@@ -146,4 +165,249 @@ void RTree::neighbors_in_range(const Eigen::Vector3d &pos,
     results_to_neighbors(results, neighbors, self_id);
 }
 
+void RTree::request_neighbors(unsigned int k, bool by_team) {
+    neighbors_k_ = std::max(neighbors_k_, k);
+    if (by_team) {
+        neighbors_by_team_ = true;
+    } else {
+        neighbors_all_teams_ = true;
+    }
+}
+
+unsigned int RTree::neighbors_k() const { return neighbors_k_; }
+
+void RTree::set_job_runner(JobRunner runner, int num_threads) {
+    job_runner_ = runner;
+    num_threads_ = std::max(1, num_threads);
+}
+
+void RTree::compute_neighbors() {
+    neighbors_valid_ = false;
+    if (neighbors_k_ == 0) return;
+
+    // a group for all entities (team -1) and one per team, as requested
+    group_teams_.clear();
+    if (neighbors_all_teams_) group_teams_.push_back(-1);
+    if (neighbors_by_team_) {
+        for (const ID &id : ids_) {
+            if (std::find(group_teams_.begin(), group_teams_.end(), id.team_id()) ==
+                group_teams_.end()) {
+                group_teams_.push_back(id.team_id());
+            }
+        }
+    }
+    std::sort(group_teams_.begin(), group_teams_.end());
+
+    // entity ids are small, so rows are looked up by indexing
+    int max_id = -1;
+    for (const ID &id : ids_) max_id = std::max(max_id, id.id());
+    rows_.assign(max_id + 1, -1);
+    for (size_t r = 0; r < ids_.size(); r++) {
+        if (ids_[r].id() >= 0) rows_[ids_[r].id()] = r;
+    }
+
+    // Bin the members of each group on a uniform x-y grid of about
+    // MEMBERS_PER_CELL per cell and store them cell by cell. Small groups
+    // get a single cell, which makes their queries a brute force scan.
+    size_t num_groups = group_teams_.size();
+    groups_.resize(num_groups);
+    std::vector<size_t> members, cells, next;
+    for (size_t g = 0; g < num_groups; g++) {
+        NeighborGroup &group = groups_[g];
+        members.clear();
+        for (size_t r = 0; r < ids_.size(); r++) {
+            if (group_teams_[g] == -1 || group_teams_[g] == ids_[r].team_id()) {
+                members.push_back(r);
+            }
+        }
+
+        double x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+        if (!members.empty()) {
+            x0 = x1 = positions_[members[0]](0);
+            y0 = y1 = positions_[members[0]](1);
+        }
+        for (size_t r : members) {
+            x0 = std::min(x0, positions_[r](0));
+            x1 = std::max(x1, positions_[r](0));
+            y0 = std::min(y0, positions_[r](1));
+            y1 = std::max(y1, positions_[r](1));
+        }
+        double target_cells = std::max<size_t>(1, members.size() / MEMBERS_PER_CELL);
+        double extent = std::max(x1 - x0, y1 - y0);
+        group.x0 = x0;
+        group.y0 = y0;
+        group.cell_size = std::max({std::sqrt((x1 - x0) * (y1 - y0) / target_cells),
+                                    extent / target_cells,
+                                    extent / (MAX_CELLS_PER_AXIS - 1), 1e-9});
+        group.nx = std::min<int>(MAX_CELLS_PER_AXIS, (x1 - x0) / group.cell_size + 1);
+        group.ny = std::min<int>(MAX_CELLS_PER_AXIS, (y1 - y0) / group.cell_size + 1);
+
+        // counting sort of the members by cell
+        group.cell_start.assign(group.nx * group.ny + 1, 0);
+        cells.resize(members.size());
+        for (size_t j = 0; j < members.size(); j++) {
+            cells[j] = group.cell(positions_[members[j]]);
+            group.cell_start[cells[j] + 1]++;
+        }
+        for (size_t c = 0; c + 1 < group.cell_start.size(); c++) {
+            group.cell_start[c + 1] += group.cell_start[c];
+        }
+        group.rows.resize(members.size());
+        group.x.resize(members.size());
+        group.y.resize(members.size());
+        group.z.resize(members.size());
+        next.assign(group.cell_start.begin(), group.cell_start.end() - 1);
+        for (size_t j = 0; j < members.size(); j++) {
+            size_t i = next[cells[j]]++;
+            group.rows[i] = members[j];
+            group.x[i] = positions_[members[j]](0);
+            group.y[i] = positions_[members[j]](1);
+            group.z[i] = positions_[members[j]](2);
+        }
+    }
+
+    size_t num_rows = ids_.size();
+    neighbor_ids_.resize(num_rows * num_groups * neighbors_k_);
+    neighbor_counts_.assign(num_rows * num_groups, 0);
+
+    // rows are independent, so they are split between the job runner's
+    // threads
+    size_t num_threads = std::min(static_cast<size_t>(num_threads_),
+                                  num_rows / MIN_ROWS_PER_THREAD);
+    if (!job_runner_ || num_threads <= 1) {
+        compute_neighbors(0, num_rows);
+    } else {
+        jobs_.clear();
+        for (size_t t = 0; t < num_threads; t++) {
+            jobs_.push_back([this, t, num_threads, num_rows]() {
+                compute_neighbors(num_rows * t / num_threads,
+                                  num_rows * (t + 1) / num_threads);
+            });
+        }
+        job_runner_(jobs_);
+    }
+    neighbors_valid_ = true;
+}
+
+size_t RTree::NeighborGroup::cell(const Eigen::Vector3d &pos) const {
+    return cell_y(pos(1)) * nx + cell_x(pos(0));
+}
+
+int RTree::NeighborGroup::cell_x(double x) const {
+    return std::max(0, std::min(nx - 1, static_cast<int>(std::floor((x - x0) / cell_size))));
+}
+
+int RTree::NeighborGroup::cell_y(double y) const {
+    return std::max(0, std::min(ny - 1, static_cast<int>(std::floor((y - y0) / cell_size))));
+}
+
+void RTree::compute_neighbors(size_t begin, size_t end) {
+    size_t num_groups = groups_.size();
+    unsigned int k = neighbors_k_;
+    std::vector<std::pair<double, int>> best(k);
+    std::vector<size_t> best_rows(k);
+
+    // nearer, ties broken by id so the result doesn't depend on the order
+    // the entities were added in
+    auto closer = [](double d_a, int id_a, double d_b, int id_b) {
+        return d_a < d_b || (d_a == d_b && id_a < id_b);
+    };
+
+    for (size_t r = begin; r < end; r++) {
+        const Eigen::Vector3d &pos = positions_[r];
+
+        for (size_t g = 0; g < num_groups; g++) {
+            const NeighborGroup &group = groups_[g];
+            unsigned int count = 0;
+
+            // insertion of the members of a cell into the k nearest so far
+            auto scan_cell = [&](int ix, int iy) {
+                size_t c = iy * group.nx + ix;
+                for (size_t j = group.cell_start[c]; j < group.cell_start[c + 1]; j++) {
+                    double dx = group.x[j] - pos(0);
+                    double dy = group.y[j] - pos(1);
+                    double dz = group.z[j] - pos(2);
+                    double d2 = dx * dx + dy * dy + dz * dz;
+                    if (count == k && d2 > best[k-1].first) continue;
+                    if (group.rows[j] == r) continue;
+                    int id = ids_[group.rows[j]].id();
+                    if (count == k && !closer(d2, id, best[k-1].first, best[k-1].second)) {
+                        continue;
+                    }
+                    unsigned int i = count < k ? count++ : k - 1;
+                    while (i > 0 && closer(d2, id, best[i-1].first, best[i-1].second)) {
+                        best[i] = best[i-1];
+                        best_rows[i] = best_rows[i-1];
+                        i--;
+                    }
+                    best[i] = std::make_pair(d2, id);
+                    best_rows[i] = group.rows[j];
+                }
+            };
+
+            // Scan rings of cells around the query's cell. The cells of ring
+            // R are at least (R - 1) cells away in x or y, so the search
+            // stops once that is farther than the k-th nearest.
+            int cx = group.cell_x(pos(0));
+            int cy = group.cell_y(pos(1));
+            int max_ring = std::max(group.nx, group.ny);
+            for (int ring = 0; ring <= max_ring; ring++) {
+                double reach = (ring - 1) * group.cell_size;
+                if (count == k && ring > 1 && reach * reach > best[k-1].first) break;
+
+                for (int iy = std::max(0, cy - ring); iy <= std::min(group.ny - 1, cy + ring); iy++) {
+                    if (iy == cy - ring || iy == cy + ring) {
+                        for (int ix = std::max(0, cx - ring); ix <= std::min(group.nx - 1, cx + ring); ix++) {
+                            scan_cell(ix, iy);
+                        }
+                    } else {
+                        if (cx - ring >= 0) scan_cell(cx - ring, iy);
+                        if (cx + ring < group.nx) scan_cell(cx + ring, iy);
+                    }
+                }
+            }
+
+            ID *out = &neighbor_ids_[(r * num_groups + g) * k];
+            for (unsigned int i = 0; i < count; i++) {
+                out[i] = ids_[best_rows[i]];
+            }
+            neighbor_counts_[r * num_groups + g] = count;
+        }
+    }
+}
+
+bool RTree::nearest_neighbors(int self_id, unsigned int n, IDSlice &neighbors,
+                              int team_id) const {
+    if (!neighbors_valid_ || n > neighbors_k_) return false;
+
+    if (self_id < 0 || self_id >= static_cast<int>(rows_.size()) || rows_[self_id] < 0) {
+        return false;
+    }
+
+    auto it = std::lower_bound(group_teams_.begin(), group_teams_.end(), team_id);
+    if (it == group_teams_.end() || *it != team_id) {
+        // no entities on that team, or that kind of neighbors wasn't requested
+        if (team_id == -1 ? !neighbors_all_teams_ : !neighbors_by_team_) return false;
+        neighbors = IDSlice();
+        return true;
+    }
+    size_t g = it - group_teams_.begin();
+
+    size_t slot = rows_[self_id] * group_teams_.size() + g;
+    const ID *begin = &neighbor_ids_[slot * neighbors_k_];
+    neighbors = IDSlice(begin, begin + std::min(n, neighbor_counts_[slot]));
+    return true;
+}
+
+IDSlice RTree::nearest_neighbors(const Eigen::Vector3d &pos, int self_id,
+                                unsigned int n, std::vector<ID> &storage,
+                                int team_id) const {
+    IDSlice neighbors;
+    if (nearest_neighbors(self_id, n, neighbors, team_id)) return neighbors;
+
+    nearest_n_neighbors(pos, storage, n, self_id, team_id);
+    if (storage.size() > n) storage.resize(n);
+    return IDSlice(storage.data(), storage.data() + storage.size());
+}
+
 } // namespace scrimmage
@@ -1,5 +1,6 @@
 #include <scrimmage/common/Random.h>
 #include <chrono>
+#include <sstream>
 
 namespace scrimmage {
 
@@ -32,4 +33,19 @@ int Random::rng_discrete_int(std::vector<double> &weights)
 
 std::default_random_engine &Random::gener() {return gener_;}
 
+std::string Random::state()
+{
+    std::ostringstream out;
+    out << seed_ << " " << gener_ << " " << rng_normal_ << " " << rng_uniform_;
+    return out.str();
+}
+
+bool Random::set_state(std::string state)
+{
+    std::istringstream in(state);
+    // the engine and distribution extractors turn off skipws
+    in >> seed_ >> std::ws >> gener_ >> std::ws >> rng_normal_ >> std::ws >> rng_uniform_;
+    return !in.fail();
+}
+
 }
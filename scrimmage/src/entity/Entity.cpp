@@ -41,6 +41,9 @@
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/parse/ConfigParse.h>
 #include <scrimmage/parse/ParseUtils.h>
+#include <scrimmage/simcontrol/Snapshot.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/common/Arena.h>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -93,21 +96,7 @@ bool Entity::init(AttributeMap &overrides,
     // set state
     ////////////////////////////////////////////////////////////
     state_ = std::make_shared<State>();
-
-    double x = get("x", info, 0.0);
-    double y = get("y", info, 0.0);
-    double z = get("z", info, 0.0);
-    state_->pos() << x, y, z;
-
-    double vx = get("vx", info, 0.0);
-    double vy = get("vy", info, 0.0);
-    double vz = get("vz", info, 0.0);
-    state_->vel() << vx, vy, vz;
-
-    double roll = Angles::deg2rad(get("roll", info, 0));
-    double pitch = Angles::deg2rad(get("pitch", info, 0));
-    double yaw = Angles::deg2rad(get("heading", info, 0));
-    state_->quat().set(roll, pitch, yaw);
+    init_state(info);
 
     EntityPtr parent = shared_from_this();
 
@@ -137,6 +126,7 @@ bool Entity::init(AttributeMap &overrides,
         motion_model_->set_state(state_);
         motion_model_->set_parent(parent);
         motion_model_->set_network(network);
+        plugin_params_[motion_model_] = config_parse.params();
         motion_model_->init(info, config_parse.params());
     } 
 
@@ -161,6 +151,7 @@ bool Entity::init(AttributeMap &overrides,
         sensor->contacts() = contacts;
         sensor->rtree() = rtree;
         sensor->parent() = parent;
+        plugin_params_[sensor] = config_parse.params();
         sensor->init(config_parse.params());
         sensors_[sensor->name()].push_back(sensor);
 
@@ -186,6 +177,7 @@ bool Entity::init(AttributeMap &overrides,
         }
 
         sensable->parent() = parent;
+        plugin_params_[sensable] = config_parse.params();
         sensable->init(config_parse.params());
         sensables_[sensable->name()].push_back(sensable);
 
@@ -217,7 +209,8 @@ bool Entity::init(AttributeMap &overrides,
         autonomy->set_state(motion_model_->state());
         autonomy->set_contacts(contacts);
         autonomy->set_is_controlling(true);
-        autonomy->init(config_parse.params());        
+        plugin_params_[autonomy] = config_parse.params();
+        autonomy->init(config_parse.params());
 
         autonomies_.push_back(autonomy);
         autonomy_name = std::string("autonomy") + std::to_string(++autonomy_ct);
@@ -256,7 +249,8 @@ bool Entity::init(AttributeMap &overrides,
         }
         controller->set_parent(parent);
         controller->set_network(network);
-        controller->init(config_parse.params());        
+        plugin_params_[controller] = config_parse.params();
+        controller->init(config_parse.params());
 
         controllers_.push_back(controller);
 
@@ -272,6 +266,76 @@ bool Entity::init(AttributeMap &overrides,
     return true;
 }
 
+void Entity::init_state(std::map<std::string, std::string> &info)
+{
+    double x = get("x", info, 0.0);
+    double y = get("y", info, 0.0);
+    double z = get("z", info, 0.0);
+    state_->pos() << x, y, z;
+
+    double vx = get("vx", info, 0.0);
+    double vy = get("vy", info, 0.0);
+    double vz = get("vz", info, 0.0);
+    state_->vel() << vx, vy, vz;
+
+    double roll = Angles::deg2rad(get("roll", info, 0));
+    double pitch = Angles::deg2rad(get("pitch", info, 0));
+    double yaw = Angles::deg2rad(get("heading", info, 0));
+    state_->quat().set(roll, pitch, yaw);
+}
+
+bool Entity::reset(std::map<std::string, std::string> &info,
+                   MissionParsePtr mp,
+                   std::shared_ptr<GeographicLib::LocalCartesian> proj)
+{
+    mp_ = mp;
+    proj_ = proj;
+    health_points_ = info.count("health") > 0 ? std::stoi(info["health"]) : 1;
+    active_ = true;
+    visual_changed_ = false;
+
+    *state_ = State();
+    init_state(info);
+
+    // in the order init() initialized them, so they draw the same random
+    // numbers
+    bool success = true;
+    if (info.count("motion_model") > 0) {
+        success = motion_model_->reset(info, plugin_params_[motion_model_]);
+    }
+    for (auto &kv : sensors_) {
+        for (SensorPtr &sensor : kv.second) {
+            success = success && sensor->reset(plugin_params_[sensor]);
+        }
+    }
+    for (auto &kv : sensables_) {
+        for (SensablePtr &sensable : kv.second) {
+            success = success && sensable->reset(plugin_params_[sensable]);
+        }
+    }
+    for (AutonomyPtr &autonomy : autonomies_) {
+        *autonomy->desired_state() = State();
+        autonomy->shapes().clear();
+        autonomy->set_projection(proj);
+        success = success && autonomy->reset(plugin_params_[autonomy]);
+    }
+    for (ControllerPtr &controller : controllers_) {
+        success = success && controller->reset(plugin_params_[controller]);
+    }
+
+    if (!success) {
+        stop_networking();
+    }
+    return success;
+}
+
+void Entity::stop_networking()
+{
+    for (auto &kv : plugin_params_) {
+        kv.first->stop_networking();
+    }
+}
+
 bool Entity::parse_visual(std::map<std::string, std::string> &info,
                           MissionParsePtr mp, FileSearch &file_search)
 {
@@ -388,4 +452,61 @@ void Entity::setup_desired_state() {
 
 std::unordered_map<std::string, Service> &Entity::services() {return services_;}
 
+void Entity::save_state(Snapshot &snapshot, const std::string &prefix)
+{
+    snapshot.set(prefix + "/state", *state_);
+    snapshot.set(prefix + "/health_points", health_points_);
+    snapshot.set(prefix + "/active", active_);
+
+    motion_model_->save_state(snapshot, prefix + "/motion");
+    for (size_t i = 0; i < controllers_.size(); i++) {
+        controllers_[i]->save_state(snapshot, prefix + "/controller" + std::to_string(i));
+    }
+    for (size_t i = 0; i < autonomies_.size(); i++) {
+        autonomies_[i]->save_state(snapshot, prefix + "/autonomy" + std::to_string(i));
+    }
+    for (auto &kv : sensors_) {
+        int i = 0;
+        for (SensorPtr &sensor : kv.second) {
+            sensor->save_state(snapshot, prefix + "/sensor/" + kv.first + std::to_string(i++));
+        }
+    }
+    for (auto &kv : sensables_) {
+        int i = 0;
+        for (SensablePtr &sensable : kv.second) {
+            sensable->save_state(snapshot, prefix + "/sensable/" + kv.first + std::to_string(i++));
+        }
+    }
+}
+
+bool Entity::restore_state(const Snapshot &snapshot, const std::string &prefix)
+{
+    if (!snapshot.get(prefix + "/state", *state_) ||
+        !snapshot.get(prefix + "/health_points", health_points_) ||
+        !snapshot.get(prefix + "/active", active_)) {
+        return false;
+    }
+
+    bool success = motion_model_->restore_state(snapshot, prefix + "/motion");
+    for (size_t i = 0; i < controllers_.size(); i++) {
+        success &= controllers_[i]->restore_state(snapshot, prefix + "/controller" + std::to_string(i));
+    }
+    for (size_t i = 0; i < autonomies_.size(); i++) {
+        success &= autonomies_[i]->restore_state(snapshot, prefix + "/autonomy" + std::to_string(i));
+    }
+    for (auto &kv : sensors_) {
+        int i = 0;
+        for (SensorPtr &sensor : kv.second) {
+            success &= sensor->restore_state(snapshot, prefix + "/sensor/" + kv.first + std::to_string(i++));
+        }
+    }
+    for (auto &kv : sensables_) {
+        int i = 0;
+        for (SensablePtr &sensable : kv.second) {
+            success &= sensable->restore_state(snapshot, prefix + "/sensable/" + kv.first + std::to_string(i++));
+        }
+    }
+    return success;
+}
+
 } // scrimmage
@@ -0,0 +1,474 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/copy.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include <scrimmage/log/ColumnarLog.h>
+#include <scrimmage/log/FrameReader.h>
+#include <scrimmage/proto/Frame.pb.h>
+
+using std::cout;
+using std::endl;
+
+namespace sp = scrimmage_proto;
+namespace bio = boost::iostreams;
+
+namespace scrimmage {
+
+namespace {
+const char COLUMNAR_MAGIC[8] = {'S', 'C', 'C', 'O', 'L', '0', '0', '1'};
+const int NUM_COLUMNS = 10;
+const size_t KEY_BYTES = 4 * sizeof(int32_t);
+const size_t TICK_BYTES = sizeof(double) + sizeof(uint32_t);
+const size_t ROW_BYTES = sizeof(uint32_t) + sizeof(uint8_t) + NUM_COLUMNS * sizeof(double);
+
+// Columns are stored in host byte order (little endian on every platform
+// we run on).
+template <class T>
+void append(std::string &buf, const T *data, size_t n)
+{
+    buf.append(reinterpret_cast<const char *>(data), n * sizeof(T));
+}
+
+template <class T>
+void extract(const char *&ptr, T *data, size_t n)
+{
+    std::memcpy(data, ptr, n * sizeof(T));
+    ptr += n * sizeof(T);
+}
+
+template <class T>
+bool read_value(std::ifstream &input, T &value)
+{
+    input.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<size_t>(input.gcount()) == sizeof(T);
+}
+
+template <class T>
+void write_value(std::ofstream &output, const T &value)
+{
+    output.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// ColumnarLogWriter
+///////////////////////////////////////////////////////////////////////////////
+ColumnarLogWriter::ColumnarLogWriter() : ticks_per_chunk_(256), compress_(true) {}
+
+ColumnarLogWriter::~ColumnarLogWriter() { close(); }
+
+bool ColumnarLogWriter::open(std::string filename, unsigned int ticks_per_chunk,
+                             bool compress)
+{
+    close();
+    output_.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output_.is_open()) {
+        cout << "Failed to open file for writing: " << filename << endl;
+        return false;
+    }
+    ticks_per_chunk_ = std::max(1u, ticks_per_chunk);
+    compress_ = compress;
+    keys_.clear();
+    new_keys_.clear();
+
+    output_.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+    return output_.good();
+}
+
+bool ColumnarLogWriter::is_open() { return output_.is_open(); }
+
+bool ColumnarLogWriter::write_frame(const sp::Frame &frame)
+{
+    if (!output_.is_open()) return false;
+
+    times_.push_back(frame.time());
+    row_counts_.push_back(frame.contact_size());
+
+    for (const sp::Contact &c : frame.contact()) {
+        Key key(c.id().id(), c.id().sub_swarm_id(), c.id().team_id(), c.type());
+        auto it = keys_.find(key);
+        if (it == keys_.end()) {
+            it = keys_.emplace(key, keys_.size()).first;
+            new_keys_.push_back(key);
+        }
+        row_keys_.push_back(it->second);
+        active_.push_back(c.active());
+
+        const sp::State &s = c.state();
+        columns_[0].push_back(s.position().x());
+        columns_[1].push_back(s.position().y());
+        columns_[2].push_back(s.position().z());
+        columns_[3].push_back(s.velocity().x());
+        columns_[4].push_back(s.velocity().y());
+        columns_[5].push_back(s.velocity().z());
+        columns_[6].push_back(s.orientation().w());
+        columns_[7].push_back(s.orientation().x());
+        columns_[8].push_back(s.orientation().y());
+        columns_[9].push_back(s.orientation().z());
+    }
+
+    if (times_.size() >= ticks_per_chunk_) {
+        return flush();
+    }
+    return true;
+}
+
+bool ColumnarLogWriter::flush()
+{
+    if (!output_.is_open()) return false;
+    if (times_.empty()) return true;
+
+    uint32_t num_ticks = times_.size();
+    uint32_t num_rows = row_keys_.size();
+    uint32_t num_new_keys = new_keys_.size();
+
+    std::string raw;
+    raw.reserve(num_new_keys * KEY_BYTES + num_ticks * TICK_BYTES +
+                num_rows * ROW_BYTES);
+    for (Key &key : new_keys_) {
+        int32_t k[4] = {std::get<0>(key), std::get<1>(key),
+                        std::get<2>(key), std::get<3>(key)};
+        append(raw, k, 4);
+    }
+    append(raw, times_.data(), num_ticks);
+    append(raw, row_counts_.data(), num_ticks);
+    append(raw, row_keys_.data(), num_rows);
+    append(raw, active_.data(), num_rows);
+    for (int i = 0; i < NUM_COLUMNS; i++) {
+        append(raw, columns_[i].data(), num_rows);
+    }
+
+    std::string compressed;
+    if (compress_) {
+        bio::filtering_ostream out;
+        out.push(bio::zlib_compressor(bio::zlib::best_speed));
+        out.push(bio::back_inserter(compressed));
+        out.write(raw.data(), raw.size());
+    }
+    const std::string &payload = compress_ ? compressed : raw;
+
+    write_value(output_, num_ticks);
+    write_value(output_, num_rows);
+    write_value(output_, num_new_keys);
+    write_value(output_, static_cast<uint8_t>(compress_));
+    write_value(output_, static_cast<uint64_t>(raw.size()));
+    write_value(output_, static_cast<uint64_t>(payload.size()));
+    output_.write(payload.data(), payload.size());
+    output_.flush();
+
+    new_keys_.clear();
+    times_.clear();
+    row_counts_.clear();
+    row_keys_.clear();
+    active_.clear();
+    for (int i = 0; i < NUM_COLUMNS; i++) {
+        columns_[i].clear();
+    }
+
+    if (!output_.good()) {
+        cout << "ColumnarLogWriter: failed to write chunk" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool ColumnarLogWriter::close()
+{
+    if (!output_.is_open()) return true;
+    bool success = flush();
+    output_.close();
+    return success;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ColumnarLogReader
+///////////////////////////////////////////////////////////////////////////////
+ColumnarLogReader::ColumnarLogReader() : file_size_(0), clean_eof_(true) {}
+
+bool ColumnarLogReader::open(std::string filename)
+{
+    close();
+    input_.open(filename, std::ios::in | std::ios::binary);
+    if (!input_.is_open()) {
+        cout << "Failed to open file: " << filename << endl;
+        return false;
+    }
+    input_.seekg(0, std::ios::end);
+    file_size_ = input_.tellg();
+    input_.seekg(0, std::ios::beg);
+
+    char magic[sizeof(COLUMNAR_MAGIC)];
+    input_.read(magic, sizeof(magic));
+    if (input_.gcount() != sizeof(magic) ||
+        std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0) {
+        cout << "Not a columnar log file: " << filename << endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ColumnarLogReader::close()
+{
+    if (input_.is_open()) input_.close();
+    input_.clear();
+    file_size_ = 0;
+    clean_eof_ = true;
+    keys_.clear();
+}
+
+bool ColumnarLogReader::is_open() { return input_.is_open(); }
+
+bool ColumnarLogReader::clean_eof() { return clean_eof_; }
+
+bool ColumnarLogReader::read_chunk(std::vector<std::shared_ptr<sp::Frame>> &frames)
+{
+    frames.clear();
+    if (!input_.is_open()) return false;
+
+    uint32_t num_ticks, num_rows, num_new_keys;
+    uint8_t compressed;
+    uint64_t raw_size, stored_size;
+
+    if (!read_value(input_, num_ticks)) {
+        // A clean end of file lands exactly on a chunk boundary
+        clean_eof_ = input_.gcount() == 0;
+        return false;
+    }
+    if (!read_value(input_, num_rows) || !read_value(input_, num_new_keys) ||
+        !read_value(input_, compressed) || !read_value(input_, raw_size) ||
+        !read_value(input_, stored_size)) {
+        clean_eof_ = false;
+        return false;
+    }
+
+    uint64_t expected = num_new_keys * KEY_BYTES + num_ticks * TICK_BYTES +
+        static_cast<uint64_t>(num_rows) * ROW_BYTES;
+    if (raw_size != expected) {
+        cout << "ColumnarLogReader: corrupt chunk header" << endl;
+        clean_eof_ = false;
+        return false;
+    }
+
+    // Check the sizes before allocating, a corrupt header could ask for
+    // anything. zlib doesn't compress by more than about 1032:1.
+    uint64_t remaining = file_size_ - static_cast<uint64_t>(input_.tellg());
+    if (stored_size > remaining) {
+        // truncated, e.g. the simulation is still writing
+        clean_eof_ = false;
+        return false;
+    }
+    if (compressed ? raw_size > stored_size * 1032 + 64 : raw_size != stored_size) {
+        cout << "ColumnarLogReader: corrupt chunk header" << endl;
+        clean_eof_ = false;
+        return false;
+    }
+
+    std::string payload(stored_size, '\0');
+    input_.read(&payload[0], stored_size);
+    if (static_cast<uint64_t>(input_.gcount()) != stored_size) {
+        clean_eof_ = false;
+        return false;
+    }
+
+    std::string raw;
+    if (compressed) {
+        raw.reserve(raw_size);
+        bio::filtering_istream in;
+        in.push(bio::zlib_decompressor());
+        in.push(bio::array_source(payload.data(), payload.size()));
+        try {
+            bio::copy(in, bio::back_inserter(raw));
+        } catch (bio::zlib_error &e) {
+            cout << "ColumnarLogReader: failed to decompress chunk" << endl;
+            clean_eof_ = false;
+            return false;
+        }
+    } else {
+        raw.swap(payload);
+    }
+
+    if (raw.size() != raw_size) {
+        cout << "ColumnarLogReader: chunk size mismatch" << endl;
+        clean_eof_ = false;
+        return false;
+    }
+
+    const char *ptr = raw.data();
+    for (uint32_t i = 0; i < num_new_keys; i++) {
+        int32_t k[4];
+        extract(ptr, k, 4);
+        keys_.emplace_back(k[0], k[1], k[2], k[3]);
+    }
+
+    std::vector<double> times(num_ticks);
+    std::vector<uint32_t> row_counts(num_ticks);
+    std::vector<uint32_t> row_keys(num_rows);
+    std::vector<uint8_t> active(num_rows);
+    std::vector<double> columns[NUM_COLUMNS];
+    extract(ptr, times.data(), num_ticks);
+    extract(ptr, row_counts.data(), num_ticks);
+    extract(ptr, row_keys.data(), num_rows);
+    extract(ptr, active.data(), num_rows);
+    for (int i = 0; i < NUM_COLUMNS; i++) {
+        columns[i].resize(num_rows);
+        extract(ptr, columns[i].data(), num_rows);
+    }
+
+    frames.reserve(num_ticks);
+    uint32_t row = 0;
+    for (uint32_t t = 0; t < num_ticks; t++) {
+        auto frame = std::make_shared<sp::Frame>();
+        frame->set_time(times[t]);
+
+        if (row + row_counts[t] > num_rows) {
+            cout << "ColumnarLogReader: row count mismatch" << endl;
+            clean_eof_ = false;
+            return false;
+        }
+
+        for (uint32_t end = row + row_counts[t]; row < end; row++) {
+            if (row_keys[row] >= keys_.size()) {
+                cout << "ColumnarLogReader: invalid entity key" << endl;
+                clean_eof_ = false;
+                return false;
+            }
+            auto &key = keys_[row_keys[row]];
+
+            sp::Contact *c = frame->add_contact();
+            c->mutable_id()->set_id(std::get<0>(key));
+            c->mutable_id()->set_sub_swarm_id(std::get<1>(key));
+            c->mutable_id()->set_team_id(std::get<2>(key));
+            c->set_type(static_cast<sp::ContactType>(std::get<3>(key)));
+            c->set_active(active[row]);
+
+            sp::State *s = c->mutable_state();
+            s->mutable_position()->set_x(columns[0][row]);
+            s->mutable_position()->set_y(columns[1][row]);
+            s->mutable_position()->set_z(columns[2][row]);
+            s->mutable_velocity()->set_x(columns[3][row]);
+            s->mutable_velocity()->set_y(columns[4][row]);
+            s->mutable_velocity()->set_z(columns[5][row]);
+            s->mutable_orientation()->set_w(columns[6][row]);
+            s->mutable_orientation()->set_x(columns[7][row]);
+            s->mutable_orientation()->set_y(columns[8][row]);
+            s->mutable_orientation()->set_z(columns[9][row]);
+        }
+        frames.push_back(frame);
+    }
+    return true;
+}
+
+bool ColumnarLogReader::read_all(std::list<std::shared_ptr<sp::Frame>> &frames)
+{
+    std::vector<std::shared_ptr<sp::Frame>> chunk;
+    while (read_chunk(chunk)) {
+        frames.insert(frames.end(), chunk.begin(), chunk.end());
+    }
+    return clean_eof_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Conversion
+///////////////////////////////////////////////////////////////////////////////
+bool frames_to_columnar(std::string frames_file, std::string columnar_file,
+                        unsigned int ticks_per_chunk, bool compress)
+{
+    FrameReader reader;
+    if (!reader.open(frames_file, false)) return false;
+
+    ColumnarLogWriter writer;
+    if (!writer.open(columnar_file, ticks_per_chunk, compress)) return false;
+
+    sp::Frame frame;
+    for (size_t i = 0; i < reader.size(); i++) {
+        frame.Clear();
+        if (!reader.read(i, frame)) {
+            cout << "Failed to decode frame " << i << ": " << frames_file << endl;
+            return false;
+        }
+        if (!writer.write_frame(frame)) return false;
+    }
+
+    if (!reader.clean_eof()) {
+        cout << "Frames - WARNING: Clean end-of-file not detected." << endl;
+    }
+    return writer.close();
+}
+
+bool columnar_to_frames(std::string columnar_file, std::string frames_file)
+{
+    ColumnarLogReader reader;
+    if (!reader.open(columnar_file)) return false;
+
+    int fd = ::open(frames_file.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd == -1) {
+        cout << "Failed to open file for writing: " << frames_file << endl;
+        return false;
+    }
+
+    bool success = true;
+    {
+        google::protobuf::io::FileOutputStream output(fd);
+        std::vector<std::shared_ptr<sp::Frame>> frames;
+        while (success && reader.read_chunk(frames)) {
+            for (auto &frame : frames) {
+                google::protobuf::io::CodedOutputStream coded(&output);
+                coded.WriteVarint32(frame->ByteSize());
+                frame->SerializeWithCachedSizes(&coded);
+                if (coded.HadError()) {
+                    success = false;
+                    break;
+                }
+            }
+        }
+        success = output.Flush() && success;
+    }
+    ::close(fd);
+
+    if (!reader.clean_eof()) {
+        cout << "Columnar - WARNING: Clean end-of-file not detected." << endl;
+    }
+    return success;
+}
+
+} // namespace scrimmage
@@ -0,0 +1,281 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <scrimmage/log/FrameReader.h>
+#include <scrimmage/proto/Frame.pb.h>
+
+using std::cout;
+using std::endl;
+
+namespace gpio = google::protobuf::io;
+namespace gpi = google::protobuf::internal;
+
+namespace scrimmage {
+
+namespace {
+const char INDEX_MAGIC[8] = {'S', 'C', 'F', 'I', 'D', 'X', '0', '1'};
+const int MAX_VARINT32_BYTES = 5;
+}
+
+FrameReader::FrameReader() : fd_(-1), data_(nullptr), file_size_(0),
+                             clean_eof_(true) {}
+
+FrameReader::~FrameReader() { close(); }
+
+bool FrameReader::open(std::string filename, bool use_index_file)
+{
+    close();
+    filename_ = filename;
+
+    fd_ = ::open(filename.c_str(), O_RDONLY);
+    if (fd_ == -1) {
+        cout << "Failed to open file: " << filename << endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) == -1) {
+        cout << "Failed to stat file: " << filename << endl;
+        close();
+        return false;
+    }
+    file_size_ = st.st_size;
+
+    if (file_size_ > 0) {
+        void *ptr = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (ptr == MAP_FAILED) {
+            cout << "Failed to mmap file: " << filename << endl;
+            close();
+            return false;
+        }
+        data_ = static_cast<const uint8_t *>(ptr);
+    }
+
+    if (use_index_file && load_index_file()) {
+        return true;
+    }
+
+    if (!build_index()) {
+        return false;
+    }
+
+    if (use_index_file) {
+        save_index_file();
+    }
+    return true;
+}
+
+void FrameReader::close()
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t *>(data_), file_size_);
+        data_ = nullptr;
+    }
+    if (fd_ != -1) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    file_size_ = 0;
+    clean_eof_ = true;
+    index_.clear();
+}
+
+bool FrameReader::is_open() { return fd_ != -1; }
+
+size_t FrameReader::size() { return index_.size(); }
+
+double FrameReader::time(size_t i) { return index_[i].time; }
+
+size_t FrameReader::find(double t)
+{
+    auto it = std::lower_bound(index_.begin(), index_.end(), t,
+                               [](const IndexEntry &e, double t) { return e.time < t; });
+    return std::distance(index_.begin(), it);
+}
+
+bool FrameReader::read(size_t i, scrimmage_proto::Frame &frame)
+{
+    if (i >= index_.size()) {
+        return false;
+    }
+    IndexEntry &e = index_[i];
+    return frame.ParseFromArray(data_ + e.offset, e.size);
+}
+
+std::shared_ptr<scrimmage_proto::Frame> FrameReader::read(size_t i)
+{
+    auto frame = std::make_shared<scrimmage_proto::Frame>();
+    if (!read(i, *frame)) {
+        return nullptr;
+    }
+    return frame;
+}
+
+std::vector<FrameReader::IndexEntry> &FrameReader::index() { return index_; }
+
+std::string FrameReader::index_filename() { return filename_ + ".idx"; }
+
+bool FrameReader::clean_eof() { return clean_eof_; }
+
+bool FrameReader::build_index()
+{
+    index_.clear();
+    clean_eof_ = true;
+
+    const uint32_t time_tag = gpi::WireFormatLite::MakeTag(
+        scrimmage_proto::Frame::kTimeFieldNumber,
+        gpi::WireFormatLite::WIRETYPE_FIXED64);
+
+    uint64_t offset = 0;
+    while (offset < file_size_) {
+        // Read the size. A fresh CodedInputStream per message keeps us
+        // clear of protobuf's 2GB total bytes limit on large logs.
+        int avail = static_cast<int>(std::min<uint64_t>(MAX_VARINT32_BYTES, file_size_ - offset));
+        gpio::CodedInputStream size_input(data_ + offset, avail);
+        uint32_t size;
+        if (!size_input.ReadVarint32(&size)) {
+            clean_eof_ = false;
+            break;
+        }
+
+        uint64_t body = offset + size_input.CurrentPosition();
+        if (body + size > file_size_) {
+            clean_eof_ = false;
+            break;
+        }
+
+        // Only decode the time field, skip the contacts
+        IndexEntry entry;
+        entry.time = 0;
+        entry.offset = body;
+        entry.size = size;
+
+        gpio::CodedInputStream input(data_ + body, size);
+        uint32_t tag;
+        while ((tag = input.ReadTag()) != 0) {
+            if (tag == time_tag) {
+                uint64_t bits;
+                if (!input.ReadLittleEndian64(&bits)) break;
+                entry.time = gpi::WireFormatLite::DecodeDouble(bits);
+                break;
+            } else if (!gpi::WireFormatLite::SkipField(&input, tag)) {
+                break;
+            }
+        }
+
+        index_.push_back(entry);
+        offset = body + size;
+    }
+
+    if (!clean_eof_) {
+        cout << "Frames - WARNING: Clean end-of-file not detected." << endl;
+    }
+    return true;
+}
+
+bool FrameReader::load_index_file()
+{
+    std::ifstream in(index_filename(), std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    char magic[sizeof(INDEX_MAGIC)];
+    uint64_t file_size = 0, count = 0;
+    uint8_t clean_eof = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char *>(&file_size), sizeof(file_size));
+    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    in.read(reinterpret_cast<char *>(&clean_eof), sizeof(clean_eof));
+
+    // Stale index, the log has changed since it was written
+    if (!in || memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        file_size != file_size_) {
+        return false;
+    }
+
+    index_.resize(count);
+    for (IndexEntry &e : index_) {
+        in.read(reinterpret_cast<char *>(&e.time), sizeof(e.time));
+        in.read(reinterpret_cast<char *>(&e.offset), sizeof(e.offset));
+        in.read(reinterpret_cast<char *>(&e.size), sizeof(e.size));
+    }
+
+    if (!in) {
+        index_.clear();
+        return false;
+    }
+    clean_eof_ = clean_eof != 0;
+    return true;
+}
+
+bool FrameReader::save_index_file()
+{
+    // Write to a temporary file and rename so that readers never see a
+    // partially written index
+    std::string tmp = index_filename() + ".tmp";
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        // Read-only log directory, just don't cache the index
+        return false;
+    }
+
+    uint64_t count = index_.size();
+    uint8_t clean_eof = clean_eof_ ? 1 : 0;
+    out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    out.write(reinterpret_cast<const char *>(&file_size_), sizeof(file_size_));
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char *>(&clean_eof), sizeof(clean_eof));
+    for (IndexEntry &e : index_) {
+        out.write(reinterpret_cast<const char *>(&e.time), sizeof(e.time));
+        out.write(reinterpret_cast<const char *>(&e.offset), sizeof(e.offset));
+        out.write(reinterpret_cast<const char *>(&e.size), sizeof(e.size));
+    }
+    out.close();
+
+    if (!out || std::rename(tmp.c_str(), index_filename().c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace scrimmage
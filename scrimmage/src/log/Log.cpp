@@ -65,12 +65,16 @@ Log::Log() : frames_output_(), shapes_output_(), utm_terrain_output_(), contact_
     ascii_filename_ = "log.txt";
     
     frames_name_ = "frames.bin";
+    columnar_frames_name_ = "frames.col";
     shapes_name_ = "shapes.bin";
     utm_terrain_name_ = "utm_terrain.bin";
     contact_visual_name_ = "contact_visual.bin";
     msgs_name_ = "msgs.bin";
 
     enable_log_ = true;
+    lazy_frames_ = false;
+    columnar_frames_ = false;
+    columnar_ticks_per_chunk_ = 256;
 }
 
 bool Log::open_file(std::string filename, int &fd)
@@ -92,13 +96,19 @@ bool Log::init(std::string dir, Log::Mode mode)
     ascii_filename_ = log_dir_ + "/" + ascii_filename_;
 
     frames_name_ = log_dir_ + "/" + frames_name_;
+    columnar_frames_name_ = log_dir_ + "/" + columnar_frames_name_;
     shapes_name_ = log_dir_ + "/" + shapes_name_;
     utm_terrain_name_ = log_dir_ + "/" + utm_terrain_name_;
     contact_visual_name_ = log_dir_ + "/" + contact_visual_name_;
     msgs_name_ = log_dir_ + "/" + msgs_name_;
     
     if (mode_ == WRITE) {
-        if (open_file(frames_name_, frames_fd_)) {
+        if (columnar_frames_) {
+            columnar_writer_ = std::make_shared<ColumnarLogWriter>();
+            if (!columnar_writer_->open(columnar_frames_name_, columnar_ticks_per_chunk_)) {
+                columnar_writer_ = nullptr;
+            }
+        } else if (open_file(frames_name_, frames_fd_)) {
             frames_output_ = std::make_shared<google::protobuf::io::FileOutputStream>(frames_fd_);
         }
         if (open_file(shapes_name_, shapes_fd_)) {
@@ -122,11 +132,20 @@ bool Log::init(std::string dir, Log::Mode mode)
 
 void Log::init_network(NetworkPtr network)
 {
+    close_network();
     pubsub_ = std::make_shared<Plugin>();
     pubsub_->set_network(network);
     sub_ent_collisions_ = pubsub_->create_subscriber("EntityCollision");
 }
 
+void Log::close_network()
+{
+    if (pubsub_) {
+        pubsub_->stop_networking();
+        pubsub_ = nullptr;
+    }
+}
+
 bool Log::write_ascii(std::string str)
 {
     if (!enable_log_) return true;
@@ -146,7 +165,13 @@ bool Log::write_ascii(std::string str)
 }
 
 bool Log::save_frame(std::shared_ptr<scrimmage_proto::Frame> &frame)
-{ return writeDelimitedTo(*frame, frames_output_); }
+{
+    if (columnar_writer_ != nullptr) {
+        if (mode_ == READ || !enable_log_) return true;
+        return columnar_writer_->write_frame(*frame);
+    }
+    return writeDelimitedTo(*frame, frames_output_);
+}
 
 bool Log::save_shapes(scrimmage_proto::Shapes &shapes)
 { return writeDelimitedTo(shapes, shapes_output_); }
@@ -159,6 +184,8 @@ bool Log::save_contact_visual(std::shared_ptr<scrimmage_proto::ContactVisual> &c
 
 std::string Log::frames_filename() { return frames_name_; }
 
+std::string Log::columnar_frames_filename() { return columnar_frames_name_; }
+
 std::string Log::shapes_filename() { return shapes_name_; }
 
 std::string Log::utm_terrain_filename() { return utm_terrain_name_; }
@@ -169,6 +196,16 @@ std::string Log::msgs_filename() { return msgs_name_; }
 
 void Log::set_enable_log(bool enable) { enable_log_ = enable; }
 
+void Log::set_lazy_frames(bool lazy_frames) { lazy_frames_ = lazy_frames; }
+
+FrameReaderPtr &Log::frame_reader() { return frame_reader_; }
+
+void Log::set_columnar_frames(bool columnar_frames, unsigned int ticks_per_chunk)
+{
+    columnar_frames_ = columnar_frames;
+    columnar_ticks_per_chunk_ = ticks_per_chunk;
+}
+
 bool Log::parse(std::string dir)
 {
     if (!fs::is_directory(dir)) {
@@ -177,7 +214,16 @@ bool Log::parse(std::string dir)
     }
     
     if (!fs::exists(fs::path(frames_name_))) {
-        cout << "Frames file doesn't exist: " << frames_name_ << endl;
+        if (fs::exists(fs::path(columnar_frames_name_))) {
+            // Columnar logs are always loaded eagerly, even in lazy mode,
+            // so frame_reader() stays null and frames() holds them
+            parse_columnar_frames(columnar_frames_name_);
+        } else {
+            cout << "Frames file doesn't exist: " << frames_name_ << endl;
+        }
+    } else if (lazy_frames_) {
+        frame_reader_ = std::make_shared<FrameReader>();
+        frame_reader_->open(frames_name_);
     } else {
         parse(frames_name_, FRAMES);
     }
@@ -264,6 +310,23 @@ bool Log::parse_frames(std::string filename,
     return true;
 }
 
+bool Log::parse_columnar_frames(std::string filename)
+{
+    frames_.clear();
+    scrimmage_frames_.clear();
+
+    ColumnarLogReader reader;
+    if (!reader.open(filename)) return false;
+
+    if (!reader.read_all(frames_)) {
+        cout << "Frames - WARNING: Clean end-of-file not detected." << endl;
+    }
+    for (auto &frame : frames_) {
+        scrimmage_frames_.push_back(proto_2_frame(*frame));
+    }
+    return true;
+}
+
 bool Log::parse_shapes(std::string filename, 
                       ZeroCopyInputStreamPtr input)
 {
@@ -402,6 +465,11 @@ bool Log::close_log()
         ascii_output_.close();
     }
 
+    if (columnar_writer_ != nullptr) {
+        columnar_writer_->close();
+        columnar_writer_.reset();
+    }
+
     google::protobuf::ShutdownProtobufLibrary();
     frames_output_.reset();
     shapes_output_.reset();
@@ -0,0 +1,368 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <limits>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdio>
+
+#include <sys/stat.h>
+
+#include <scrimmage/log/RunIndex.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+
+namespace fs = boost::filesystem;
+
+using std::cout;
+using std::endl;
+
+namespace scrimmage {
+
+namespace {
+const char *INDEX_HEADER = "# outcome,summary_mtime_ns,summary_size,team_id:score ...,run_dir";
+
+// Modification time in nanoseconds and size of a file. last_write_time()
+// only has a resolution of one second, which misses a summary.csv that is
+// rewritten within the second it was indexed.
+bool file_stamp(const std::string &path, int64_t &mtime_ns, int64_t &size)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL +
+        st.st_mtim.tv_nsec;
+    size = st.st_size;
+    return true;
+}
+} // namespace
+
+RunIndex::RunIndex() {}
+
+std::map<std::string, RunIndex::Run> &RunIndex::runs() { return runs_; }
+
+bool RunIndex::load(std::string filename)
+{
+    runs_.clear();
+
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // An index written in another format is discarded, so every run is
+    // parsed again.
+    std::string line;
+    if (!std::getline(file, line) || line != INDEX_HEADER) {
+        cout << "RunIndex: ignoring index in an unknown format: " << filename << endl;
+        return false;
+    }
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        // The run directory is the remainder of the line, so it may
+        // contain commas.
+        size_t c1 = line.find(',');
+        size_t c2 = c1 == std::string::npos ? c1 : line.find(',', c1 + 1);
+        size_t c3 = c2 == std::string::npos ? c2 : line.find(',', c2 + 1);
+        size_t c4 = c3 == std::string::npos ? c3 : line.find(',', c3 + 1);
+        if (c4 == std::string::npos) {
+            cout << "RunIndex: skipping malformed line: " << line << endl;
+            continue;
+        }
+
+        Run run;
+        run.outcome = line.substr(0, c1);
+        try {
+            run.mtime_ns = std::stoll(line.substr(c1 + 1, c2 - c1 - 1));
+            run.size = std::stoll(line.substr(c2 + 1, c3 - c2 - 1));
+        } catch (std::exception &e) {
+            cout << "RunIndex: skipping malformed line: " << line << endl;
+            continue;
+        }
+
+        std::istringstream scores(line.substr(c3 + 1, c4 - c3 - 1));
+        std::string score;
+        while (scores >> score) {
+            size_t colon = score.find(':');
+            if (colon == std::string::npos) continue;
+            run.team_scores[std::stoi(score.substr(0, colon))] =
+                std::stod(score.substr(colon + 1));
+        }
+        runs_[line.substr(c4 + 1)] = run;
+    }
+    return true;
+}
+
+bool RunIndex::save(std::string filename)
+{
+    std::string tmp = filename + ".tmp";
+    {
+        std::ofstream file(tmp);
+        if (!file.is_open()) {
+            cout << "Failed to open file for writing: " << tmp << endl;
+            return false;
+        }
+
+        file << INDEX_HEADER << endl;
+        file << std::setprecision(std::numeric_limits<double>::max_digits10);
+        for (auto &kv : runs_) {
+            Run &run = kv.second;
+            file << run.outcome << "," << run.mtime_ns << "," << run.size << ",";
+            bool first = true;
+            for (auto &score : run.team_scores) {
+                file << (first ? "" : " ") << score.first << ":" << score.second;
+                first = false;
+            }
+            file << "," << kv.first << "\n";
+        }
+        if (!file.good()) {
+            cout << "Failed to write file: " << tmp << endl;
+            return false;
+        }
+    }
+
+    if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+        cout << "Failed to rename " << tmp << " to " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+int RunIndex::update(std::string log_dir, int num_threads, std::string exclude_dir)
+{
+    num_threads = std::max(1, num_threads);
+
+    std::vector<std::string> paths;
+    find_summaries(log_dir, num_threads, paths, exclude_dir);
+
+    // Reuse runs whose summary.csv hasn't changed
+    std::map<std::string, Run> old_runs;
+    old_runs.swap(runs_);
+
+    std::vector<std::string> dirs(paths.size());
+    std::vector<int64_t> mtimes(paths.size(), -1);
+    std::vector<int64_t> sizes(paths.size(), -1);
+    std::vector<size_t> to_parse;
+    for (size_t i = 0; i < paths.size(); i++) {
+        dirs[i] = fs::path(paths[i]).parent_path().string();
+        file_stamp(paths[i], mtimes[i], sizes[i]);
+
+        auto it = old_runs.find(dirs[i]);
+        if (it != old_runs.end() && mtimes[i] >= 0 &&
+            it->second.mtime_ns == mtimes[i] && it->second.size == sizes[i]) {
+            runs_[dirs[i]] = it->second;
+        } else {
+            to_parse.push_back(i);
+        }
+    }
+
+    std::vector<Run> parsed(to_parse.size());
+    std::vector<char> valid(to_parse.size(), 0);
+    std::atomic<size_t> next(0);
+
+    auto parse_worker = [&]() {
+        for (size_t j = next++; j < to_parse.size(); j = next++) {
+            size_t i = to_parse[j];
+            Run &run = parsed[j];
+            run.mtime_ns = mtimes[i];
+            run.size = sizes[i];
+            if (!parse_summary(paths[i], run.team_scores)) continue;
+
+            // Runs without a winner are kept in the index too, so they
+            // aren't parsed again on every update.
+            run.outcome = outcome(run.team_scores);
+            if (run.outcome == "") {
+                cout << "Warning: Couldn't determine winner of: " << paths[i] << endl;
+            }
+            valid[j] = 1;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.push_back(std::thread(parse_worker));
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    for (size_t j = 0; j < to_parse.size(); j++) {
+        if (valid[j]) {
+            runs_[dirs[to_parse[j]]] = parsed[j];
+        }
+    }
+    return to_parse.size();
+}
+
+std::map<std::string, std::vector<std::string>> RunIndex::outcomes()
+{
+    std::map<std::string, std::vector<std::string>> result;
+    for (auto &kv : runs_) {
+        if (kv.second.outcome != "") {
+            result[kv.second.outcome].push_back(kv.first);
+        }
+    }
+    return result;
+}
+
+bool RunIndex::parse_summary(std::string filename,
+                             std::map<int, double> &team_scores)
+{
+    std::ifstream csv_file(filename);
+    if (!csv_file.is_open()) {
+        cout << "Failed to open file: " << filename << endl;
+        return false;
+    }
+
+    std::string line;
+    std::getline(csv_file, line); //skip header comment
+
+    while (std::getline(csv_file, line)) {
+        std::vector<std::string> t;
+        boost::split(t, line, boost::is_any_of(","));
+        if (t.size() < 2) continue;
+
+        try {
+            team_scores[std::stoi(t[0])] = std::stod(t[1]);
+        } catch (std::exception &e) {
+            cout << "Warning: Invalid line in " << filename << ": " << line << endl;
+        }
+    }
+    return true;
+}
+
+std::string RunIndex::outcome(std::map<int, double> &team_scores)
+{
+    // Determine which teams lost, won, and drew
+    double max_score = -std::numeric_limits<double>::infinity();
+    std::vector<int> winning_team;
+    for (auto &kv : team_scores) {
+        if (std::abs(kv.second-max_score) < 0.000001) {
+            // A possible draw
+            winning_team.push_back(kv.first);
+        } else if (kv.second > max_score) {
+            max_score = kv.second;
+            winning_team.clear();
+            winning_team.push_back(kv.first);
+        }
+    }
+
+    if (winning_team.size() == 0) {
+        return "";
+    } else if (winning_team.size() == 1) {
+        return "team_" + std::to_string(winning_team[0]);
+    }
+
+    // Draw for multiple winners
+    std::string result = "draw";
+    for (int team : winning_team) {
+        result += "_" + std::to_string(team);
+    }
+    return result;
+}
+
+void RunIndex::find_summaries(std::string dir, int num_threads,
+                              std::vector<std::string> &paths,
+                              std::string exclude_dir)
+{
+    paths.clear();
+    if (!fs::is_directory(dir)) {
+        cout << "Path doesn't exist: " << dir << endl;
+        return;
+    }
+
+    fs::path exclude = exclude_dir == "" ? fs::path() : fs::absolute(exclude_dir);
+
+    std::deque<fs::path> queue;
+    queue.push_back(fs::absolute(dir));
+    int pending = 1; // directories queued or being listed
+
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    auto worker = [&]() {
+        std::vector<fs::path> subdirs;
+        while (true) {
+            fs::path current;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]() { return !queue.empty() || pending == 0; });
+                if (queue.empty()) return;
+                current = queue.front();
+                queue.pop_front();
+            }
+
+            subdirs.clear();
+            bool is_run = false;
+            boost::system::error_code ec;
+            for (fs::directory_iterator it(current, ec), end; !ec && it != end;
+                 it.increment(ec)) {
+                // Symlinked directories aren't followed, they can form
+                // cycles or reach the same runs twice.
+                fs::file_status status = it->symlink_status(ec);
+                if (ec) break;
+                if (fs::is_directory(status)) {
+                    if (it->path() != exclude) subdirs.push_back(it->path());
+                } else if (it->path().filename() == "summary.csv" &&
+                           fs::is_regular_file(it->status(ec))) {
+                    is_run = true;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (is_run) {
+                paths.push_back((current / "summary.csv").string());
+            } else {
+                queue.insert(queue.end(), subdirs.begin(), subdirs.end());
+                pending += subdirs.size();
+            }
+            pending--;
+            cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < std::max(1, num_threads); t++) {
+        threads.push_back(std::thread(worker));
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+}
+
+} // namespace scrimmage
@@ -0,0 +1,183 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <scrimmage/common/Checkpoint.h>
+#include <scrimmage/math/LowRankCMAES.h>
+
+namespace scrimmage {
+
+LowRankCMAES::LowRankCMAES() : lambda_(1), sigma_(0), t_(0)
+{
+}
+
+void LowRankCMAES::init(size_t n, size_t lambda, size_t rank, double sigma)
+{
+    lambda_ = std::max<size_t>(1, lambda);
+    sigma_ = sigma;
+    t_ = 0;
+    D_.assign(n, 1);
+    p_sigma_.assign(n, 0);
+    paths_.assign(rank, vec_t(n, 0));
+}
+
+void LowRankCMAES::latent(uint32_t seed, float_t *z) const
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<float_t> normal(0, 1);
+    for (size_t i = 0; i < D_.size(); i++) z[i] = normal(gen);
+}
+
+void LowRankCMAES::transform(float_t *v) const
+{
+    size_t n = D_.size();
+    size_t m = std::min<uint64_t>(t_, paths_.size());
+    for (size_t j = 0; j < m; j++) {
+        // v = (1 - c) v + c p (p . v), with slower rates for longer paths
+        const float_t *p = paths_[j].data();
+        double c = 1.0 / (std::pow(1.5, j) * n);
+        double dot = 0;
+        for (size_t i = 0; i < n; i++) dot += p[i] * v[i];
+        float_t a = static_cast<float_t>(1 - c);
+        float_t b = static_cast<float_t>(c * dot);
+        for (size_t i = 0; i < n; i++) v[i] = a * v[i] + b * p[i];
+    }
+}
+
+void LowRankCMAES::sample(uint32_t seed, vec_t &theta) const
+{
+    size_t n = D_.size();
+    vec_t v(n);
+    latent(seed, v.data());
+    for (size_t i = 0; i < n; i++) v[i] *= D_[i];
+    transform(v.data());
+
+    float_t s = static_cast<float_t>(sigma_);
+    for (size_t i = 0; i < n; i++) theta[i] += s * v[i];
+}
+
+void LowRankCMAES::update(vec_t &theta, const std::vector<int32_t> &seeds,
+                          const std::vector<double> &weights)
+{
+    size_t n = D_.size();
+    double total = 0, sum_sq = 0;
+    for (double w : weights) total += w;
+    if (seeds.empty() || total <= 0) return;
+    for (double w : weights) sum_sq += (w / total) * (w / total);
+    double mu_eff = 1 / sum_sq;
+
+    // weighted mean of z and z^2 over the samples
+    std::vector<double> z_mean(n, 0), z_sq(n, 0);
+    vec_t z(n);
+    for (size_t k = 0; k < seeds.size(); k++) {
+        double w = weights[k] / total;
+        if (w == 0) continue;
+        latent(seeds[k], z.data());
+        for (size_t i = 0; i < n; i++) {
+            z_mean[i] += w * z[i];
+            z_sq[i] += w * z[i] * z[i];
+        }
+    }
+
+    // the mean moves to the recombination of the samples. M is linear, so
+    // one transform of the mean latent is enough.
+    vec_t v_mean(n);
+    for (size_t i = 0; i < n; i++) v_mean[i] = D_[i] * z_mean[i];
+    vec_t step = v_mean;
+    transform(step.data());
+    for (size_t i = 0; i < n; i++) theta[i] += sigma_ * step[i];
+
+    // step size path on z, evolution paths on D z
+    double c_sigma = std::min(1.0, 2.0 * lambda_ / n);
+    double h_sigma = std::sqrt(c_sigma * (2 - c_sigma) * mu_eff);
+    double norm_sq = 0;
+    for (size_t i = 0; i < n; i++) {
+        p_sigma_[i] = (1 - c_sigma) * p_sigma_[i] + h_sigma * z_mean[i];
+        norm_sq += p_sigma_[i] * p_sigma_[i];
+    }
+
+    for (size_t j = 0; j < paths_.size(); j++) {
+        double c = std::min(1.0, lambda_ / (std::pow(4.0, j) * n));
+        double h = std::sqrt(mu_eff * c * (2 - c));
+        float_t *p = paths_[j].data();
+        for (size_t i = 0; i < n; i++) p[i] = (1 - c) * p[i] + h * v_mean[i];
+    }
+
+    // separable rank-mu update of D, the learning rate of sep-CMA-ES
+    double c_mu = (n + 2) / 3.0 * 2 * (mu_eff - 2 + 1 / mu_eff) /
+        ((n + 2) * (n + 2) + mu_eff);
+    c_mu = std::max(0.0, std::min(1.0, c_mu));
+    for (size_t i = 0; i < n; i++) {
+        D_[i] *= std::exp(0.5 * c_mu * (z_sq[i] - 1));
+    }
+
+    sigma_ *= std::exp(0.5 * c_sigma * (norm_sq / n - 1));
+    t_++;
+}
+
+void LowRankCMAES::save(Checkpoint &checkpoint) const
+{
+    vec_t paths;
+    for (const vec_t &p : paths_) paths.insert(paths.end(), p.begin(), p.end());
+
+    checkpoint.set("cma_lambda", static_cast<uint64_t>(lambda_));
+    checkpoint.set("cma_sigma", sigma_);
+    checkpoint.set("cma_t", t_);
+    checkpoint.set("cma_rank", static_cast<uint64_t>(paths_.size()));
+    checkpoint.set("cma_D", D_);
+    checkpoint.set("cma_p_sigma", p_sigma_);
+    checkpoint.set("cma_paths", paths);
+}
+
+bool LowRankCMAES::load(Checkpoint &checkpoint)
+{
+    uint64_t lambda, rank;
+    vec_t paths;
+    if (!checkpoint.get("cma_lambda", lambda) ||
+        !checkpoint.get("cma_sigma", sigma_) ||
+        !checkpoint.get("cma_t", t_) ||
+        !checkpoint.get("cma_rank", rank) ||
+        !checkpoint.get("cma_D", D_) ||
+        !checkpoint.get("cma_p_sigma", p_sigma_) ||
+        !checkpoint.get("cma_paths", paths) ||
+        p_sigma_.size() != D_.size() || paths.size() != rank * D_.size()) {
+        return false;
+    }
+
+    lambda_ = lambda;
+    paths_.assign(rank, vec_t());
+    for (size_t j = 0; j < rank; j++) {
+        paths_[j].assign(paths.begin() + j * D_.size(),
+                         paths.begin() + (j + 1) * D_.size());
+    }
+    return true;
+}
+
+} // namespace scrimmage
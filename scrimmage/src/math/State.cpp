@@ -1,11 +1,71 @@
 #include <scrimmage/math/State.h>
 
+#include <limits>
+
 namespace scrimmage {
 
-State::State() {}
+State::State() {
+    clear_cache();
+}
 
 State::State(Eigen::Vector3d _pos, Eigen::Vector3d _vel, Quaternion _quat) :
-    pos_(_pos), vel_(_vel), quat_(_quat) {}
+    pos_(_pos), vel_(_vel), quat_(_quat) {
+    clear_cache();
+}
+
+State::State(const State &other) :
+    pos_(other.pos_), vel_(other.vel_), quat_(other.quat_) {
+    clear_cache();
+}
+
+State &State::operator=(const State &other) {
+    pos_ = other.pos_;
+    vel_ = other.vel_;
+    quat_ = other.quat_;
+    return *this;
+}
+
+void State::clear_cache() {
+    cache_seq_.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < CACHE_VALUES; i++) {
+        cache_[CACHE_KEY + i].store(std::numeric_limits<double>::quiet_NaN(),
+                                    std::memory_order_relaxed);
+    }
+}
+
+void State::update_cache(double *values) const {
+    uint32_t seq = cache_seq_.load(std::memory_order_relaxed);
+    const double key[CACHE_VALUES] = {quat_.w(), quat_.x(), quat_.y(), quat_.z()};
+
+    values[0] = quat_.roll();
+    values[1] = quat_.pitch();
+    values[2] = quat_.yaw();
+    Eigen::Matrix3d rot = quat_.normalized().toRotationMatrix();
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            values[3 + 3 * r + c] = rot(r, c);
+        }
+    }
+
+    // Leave the cache to another thread that is already writing it
+    if ((seq & 1) == 0 &&
+        cache_seq_.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed)) {
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < CACHE_VALUES; i++) {
+            cache_[CACHE_KEY + i].store(key[i], std::memory_order_relaxed);
+        }
+        for (int i = 0; i < NUM_CACHE_VALUES; i++) {
+            cache_[CACHE_VALUES + i].store(values[i], std::memory_order_relaxed);
+        }
+        cache_seq_.store(seq + 2, std::memory_order_release);
+    }
+}
+
+Eigen::Matrix3d State::rotation() const {
+    double values[NUM_CACHE_VALUES];
+    if (!read_cache(0, NUM_CACHE_VALUES, values)) update_cache(values);
+    return Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(values + 3);
+}
 
 Eigen::Vector3d &State::pos() {return pos_;}
 
@@ -34,7 +94,7 @@ bool State::InFieldOfView(State &other, double fov_width, double fov_height) {
 }
 
 Eigen::Vector3d State::rel_pos_local_frame(Eigen::Vector3d &other) {
-    return quat_.rotate_reverse(other - pos_);
+    return rotation().transpose() * (other - pos_);
 }
 
 Eigen::Vector3d State::pos_offset(double distance, bool offset_with_velocity) const {
@@ -46,13 +106,14 @@ Eigen::Vector3d State::pos_offset(double distance, bool offset_with_velocity) co
 }
 
 Eigen::Vector3d State::orient_global_frame() const {
-    return quat_.rotate_reverse(Eigen::Vector3d::UnitX());
+    // same as quat_.rotate_reverse(Eigen::Vector3d::UnitX())
+    return rotation().row(0).transpose();
 }
 
 double State::rel_az(const Eigen::Vector3d &other) {
     Eigen::Vector3d diff = other - pos_;
     double az = atan2(diff(1), diff(0));
-    return Angles::angle_diff_rad(az, quat_.yaw());
+    return Angles::angle_diff_rad(az, yaw());
 }
 
 }
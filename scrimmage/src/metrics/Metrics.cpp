@@ -46,11 +46,16 @@ void Metrics::init() {}
 
 void Metrics::init(std::map<std::string, std::string> &params) {}
 
+bool Metrics::reset(std::map<std::string, std::string> &params) { return false; }
+
 bool Metrics::step_metrics(double t, double dt) { return false; }
 
 void Metrics::set_team_lookup(std::shared_ptr<std::unordered_map<int, int> > &lookup)
 { team_lookup_ = lookup; }
 
+void Metrics::set_entity_index(EntityIndexPtr &entity_index)
+{ entity_index_ = entity_index; }
+
 void Metrics::calc_team_scores() {}
 
 void Metrics::print_team_summaries() {}
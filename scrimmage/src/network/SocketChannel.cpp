@@ -0,0 +1,301 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <scrimmage/common/Checkpoint.h>
+#include <scrimmage/network/SocketChannel.h>
+
+using std::cout;
+using std::endl;
+
+namespace scrimmage {
+
+namespace {
+// Splits "tcp:host:port" or "unix:path"
+bool parse_address(const std::string &address, std::string &type,
+                   std::string &host, std::string &port)
+{
+    size_t colon = address.find(':');
+    if (colon == std::string::npos) return false;
+    type = address.substr(0, colon);
+    std::string rest = address.substr(colon + 1);
+
+    if (type == "unix") {
+        host = rest;
+        return !host.empty();
+    } else if (type == "tcp") {
+        size_t port_colon = rest.rfind(':');
+        if (port_colon == std::string::npos) return false;
+        host = rest.substr(0, port_colon);
+        port = rest.substr(port_colon + 1);
+        return !port.empty();
+    }
+    return false;
+}
+
+bool unix_sockaddr(const std::string &path, sockaddr_un &addr)
+{
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return true;
+}
+
+addrinfo *tcp_addrinfo(const std::string &host, const std::string &port, bool passive)
+{
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (passive) hints.ai_flags = AI_PASSIVE;
+
+    addrinfo *result = nullptr;
+    const char *node = host.empty() ? nullptr : host.c_str();
+    if (getaddrinfo(node, port.c_str(), &hints, &result) != 0) return nullptr;
+    return result;
+}
+
+bool write_all(int fd, const char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool read_all(int fd, char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = ::recv(fd, data, size, 0);
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+void set_nodelay(int fd)
+{
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+} // namespace
+
+constexpr uint64_t SocketChannel::max_message_size;
+
+SocketChannel::SocketChannel() : fd_(-1) {}
+
+SocketChannel::~SocketChannel() { close(); }
+
+bool SocketChannel::connect(std::string address, double timeout)
+{
+    close();
+
+    std::string type, host, port;
+    if (!parse_address(address, type, host, port)) {
+        cout << "Invalid socket address: " << address << endl;
+        return false;
+    }
+
+    auto end = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(static_cast<int>(timeout * 1000));
+    do {
+        if (type == "unix") {
+            sockaddr_un addr;
+            if (!unix_sockaddr(host, addr)) return false;
+            fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd_ != -1 && ::connect(fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+                return true;
+            }
+        } else {
+            addrinfo *info = tcp_addrinfo(host, port, false);
+            if (info != nullptr) {
+                fd_ = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+                bool connected = fd_ != -1 && ::connect(fd_, info->ai_addr, info->ai_addrlen) == 0;
+                freeaddrinfo(info);
+                if (connected) {
+                    set_nodelay(fd_);
+                    return true;
+                }
+            }
+        }
+        close();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    } while (std::chrono::steady_clock::now() < end);
+
+    cout << "Failed to connect to " << address << endl;
+    return false;
+}
+
+void SocketChannel::close()
+{
+    if (fd_ != -1) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool SocketChannel::is_open() const { return fd_ != -1; }
+
+bool SocketChannel::send(const std::string &msg)
+{
+    if (fd_ == -1) return false;
+    uint64_t size = msg.size();
+    if (size > max_message_size) {
+        cout << "Message of " << size << " bytes is too large to send" << endl;
+        return false;
+    }
+    return write_all(fd_, reinterpret_cast<const char *>(&size), sizeof(size)) &&
+        write_all(fd_, msg.data(), msg.size());
+}
+
+bool SocketChannel::recv(std::string &msg)
+{
+    if (fd_ == -1) return false;
+    uint64_t size;
+    if (!read_all(fd_, reinterpret_cast<char *>(&size), sizeof(size))) return false;
+    if (size > max_message_size) {
+        cout << "Received a message length of " << size
+             << " bytes, closing the channel" << endl;
+        close();
+        return false;
+    }
+    msg.resize(size);
+    return size == 0 || read_all(fd_, &msg[0], size);
+}
+
+bool SocketChannel::send(const Checkpoint &msg) { return send(msg.serialize()); }
+
+bool SocketChannel::recv(Checkpoint &msg)
+{
+    std::string data;
+    return recv(data) && msg.deserialize(data);
+}
+
+SocketServer::SocketServer() : fd_(-1) {}
+
+SocketServer::~SocketServer() { close(); }
+
+bool SocketServer::listen(std::string address)
+{
+    close();
+
+    std::string type, host, port;
+    if (!parse_address(address, type, host, port)) {
+        cout << "Invalid socket address: " << address << endl;
+        return false;
+    }
+
+    if (type == "unix") {
+        sockaddr_un addr;
+        if (!unix_sockaddr(host, addr)) {
+            cout << "Socket path too long: " << host << endl;
+            return false;
+        }
+        ::unlink(host.c_str());
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd_ == -1 || ::bind(fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            cout << "Failed to bind " << address << endl;
+            close();
+            return false;
+        }
+        unix_path_ = host;
+        address_ = address;
+    } else {
+        addrinfo *info = tcp_addrinfo(host, port, true);
+        if (info == nullptr) {
+            cout << "Failed to resolve " << address << endl;
+            return false;
+        }
+        fd_ = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+        int one = 1;
+        bool bound = fd_ != -1 &&
+            setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0 &&
+            ::bind(fd_, info->ai_addr, info->ai_addrlen) == 0;
+        freeaddrinfo(info);
+        if (!bound) {
+            cout << "Failed to bind " << address << endl;
+            close();
+            return false;
+        }
+
+        sockaddr_in addr;
+        socklen_t len = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<sockaddr *>(&addr), &len);
+        address_ = "tcp:" + host + ":" + std::to_string(ntohs(addr.sin_port));
+    }
+
+    if (::listen(fd_, 128) != 0) {
+        cout << "Failed to listen on " << address << endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool SocketServer::accept(SocketChannel &channel)
+{
+    channel.close();
+    if (fd_ == -1) return false;
+    int fd = ::accept(fd_, nullptr, nullptr);
+    if (fd == -1) return false;
+    if (unix_path_.empty()) set_nodelay(fd);
+    channel.fd_ = fd;
+    return true;
+}
+
+void SocketServer::close()
+{
+    if (fd_ != -1) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    if (!unix_path_.empty()) {
+        ::unlink(unix_path_.c_str());
+        unix_path_ = "";
+    }
+}
+
+std::string SocketServer::address() const { return address_; }
+
+} // namespace scrimmage
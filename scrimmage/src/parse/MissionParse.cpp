@@ -87,6 +87,15 @@ MissionParse::MissionParse()
     job_number_ = -1;
 }
 
+std::shared_ptr<MissionParse> MissionParse::clone() const
+{
+    std::shared_ptr<MissionParse> mp = std::make_shared<MissionParse>(*this);
+    if (utm_terrain_) {
+        mp->utm_terrain_ = std::make_shared<scrimmage_proto::UTMTerrain>(*utm_terrain_);
+    }
+    return mp;
+}
+
 void MissionParse::set_log_dir(std::string logdir){
     log_dir_=logdir;
 }
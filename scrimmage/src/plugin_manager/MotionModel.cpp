@@ -28,6 +28,7 @@
  * ---------------------------------------------------------------------------
  */
 #include <scrimmage/motion/MotionModel.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 #include <functional>
 #include <boost/numeric/odeint.hpp>
 
@@ -42,6 +43,9 @@ std::string MotionModel::type() { return std::string("MotionModel"); }
 bool MotionModel::init(std::map<std::string, std::string> &info, std::map<std::string, std::string> &params)
 { return false; }
 
+bool MotionModel::reset(std::map<std::string, std::string> &info, std::map<std::string, std::string> &params)
+{ return false; }
+
 bool MotionModel::step(double time, double dt) { return false; }
 
 bool MotionModel::posthumous(double t) { return true; }
@@ -60,6 +64,22 @@ void MotionModel::ode_step(double dt) {
 
 void MotionModel::model(const MotionModel::vector_t &x, MotionModel::vector_t &dxdt, double t) {}
 
+void MotionModel::save_state(Snapshot &snapshot, const std::string &prefix)
+{
+    Plugin::save_state(snapshot, prefix);
+    snapshot.set(prefix + "/x", x_);
+}
+
+bool MotionModel::restore_state(const Snapshot &snapshot, const std::string &prefix)
+{
+    vector_t x;
+    if (!snapshot.get(prefix + "/x", x) || x.size() != x_.size()) {
+        return false;
+    }
+    x_ = x;
+    return Plugin::restore_state(snapshot, prefix);
+}
+
 void MotionModel::set_external_force(Eigen::Vector3d force)
 {
     ext_force_ = force;
@@ -32,12 +32,14 @@
 #include <scrimmage/pubsub/Network.h>
 #include <scrimmage/pubsub/Publisher.h>
 #include <scrimmage/pubsub/Subscriber.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 
 namespace scrimmage {
 
 int Plugin::plugin_count_ = 0;
 
-Plugin::Plugin() : network_id_(plugin_count_++)
+Plugin::Plugin() : network_id_(plugin_count_++), loop_rate_(0),
+    loop_period_(1)
 {
 }
 
@@ -69,6 +71,7 @@ PublisherPtr Plugin::create_publisher(std::string topic)
 {
     PublisherPtr pub = std::make_shared<Publisher>();
     pub->set_topic(topic);
+    pub->set_arena(network_->arena());
     network_->add_publisher(network_id_, pub, topic);
     pub->plugin() = shared_from_this();
     pubs_[topic] = pub;
@@ -93,6 +96,7 @@ SubscriberPtr Plugin::create_subscriber(std::string topic)
 {
     SubscriberPtr sub = std::make_shared<Subscriber>();
     sub->set_topic(topic);
+    sub->set_arena(network_->arena());
     network_->add_subscriber(network_id_, sub, topic);
     subs_[topic] = sub;
     return sub;
@@ -112,6 +116,19 @@ void Plugin::stop_subscribing(SubscriberPtr &sub)
     sub->set_topic("");
 }
 
+void Plugin::stop_networking()
+{
+    // copies, stop_publishing() and stop_subscribing() erase from the maps
+    std::map<std::string, PublisherPtr> pubs = pubs_;
+    for (auto &kv : pubs) {
+        stop_publishing(kv.second);
+    }
+    std::map<std::string, SubscriberPtr> subs = subs_;
+    for (auto &kv : subs) {
+        stop_subscribing(kv.second);
+    }
+}
+
 void Plugin::publish(double t, PublisherPtr pub, MessageBasePtr msg)
 {
     msg->sender = network_id_;
@@ -131,6 +148,25 @@ void Plugin::publish_immediate(double t, PublisherPtr pub, MessageBasePtr msg)
     }
 }    
     
+void Plugin::set_loop_rate(double loop_rate) {loop_rate_ = loop_rate;}
+
+double Plugin::loop_rate() {return loop_rate_;}
+
+void Plugin::set_loop_period(int loop_period) {loop_period_ = loop_period;}
+
+int Plugin::loop_period() {return loop_period_;}
+
+void Plugin::save_state(Snapshot &snapshot, const std::string &prefix)
+{
+    snapshot.save_messages(prefix, *this);
+}
+
+bool Plugin::restore_state(const Snapshot &snapshot, const std::string &prefix)
+{
+    snapshot.restore_messages(prefix, *this);
+    return true;
+}
+
 void Plugin::clear_subscribers()
 {
     for (auto &kv : subs_) {
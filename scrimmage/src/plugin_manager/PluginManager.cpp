@@ -31,6 +31,7 @@
 #include <iostream>
 #include <dlfcn.h>
 #include <scrimmage/parse/ConfigParse.h>
+#include <scrimmage/parse/ParseUtils.h>
 #include <boost/filesystem.hpp>
 
 namespace scrimmage {
@@ -170,10 +171,12 @@ PluginPtr PluginManager::make_plugin(std::string plugin_type,
     }
 
     std::string plugin_name_so = config_parse.params()["library"];
+    double loop_rate = get("loop_rate", config_parse.params(), 0.0);
 
     // first, if this has already been processed, return it
     PluginPtr plugin = make_plugin_helper(plugin_type, plugin_name_so);
     if (plugin != nullptr) {
+        plugin->set_loop_rate(loop_rate);
         return plugin;
     }
 
@@ -192,6 +195,7 @@ PluginPtr PluginManager::make_plugin(std::string plugin_type,
                 // will do this already
                 so_files_.erase(it);
                 PluginPtr ptr = make_plugin_helper(plugin_type, plugin_name_so);
+                if (ptr != nullptr) ptr->set_loop_rate(loop_rate);
                 return ptr;
             }
         }
@@ -205,7 +209,9 @@ PluginPtr PluginManager::make_plugin(std::string plugin_type,
                 // don't need to check again that it is in the map since the helper
                 // will do this already
                 so_files_.erase(it);
-                return make_plugin_helper(plugin_type, plugin_name_so);
+                PluginPtr ptr = make_plugin_helper(plugin_type, plugin_name_so);
+                if (ptr != nullptr) ptr->set_loop_rate(loop_rate);
+                return ptr;
             }
         }
         it++;
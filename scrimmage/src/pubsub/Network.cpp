@@ -27,6 +27,7 @@
 /// ---------------------------------------------------------------------------
 #include <memory>
 
+#include <scrimmage/common/Arena.h>
 #include <scrimmage/pubsub/Network.h>
 #include <scrimmage/pubsub/Publisher.h>
 #include <scrimmage/pubsub/Subscriber.h>
@@ -35,7 +36,8 @@
 
 namespace scrimmage {
 
-Network::Network() : rtree_(std::make_shared<RTree>()) {}
+Network::Network() : rtree_(std::make_shared<RTree>()),
+                     arena_(Arena::create()) {}
 
 void Network::init(std::map<std::string, std::string> &params) {return;}
 
@@ -133,8 +135,49 @@ void Network::clear_subscriber_msgs() {
     }
 }
 
+void Network::clear_subscriber_msgs(const std::set<int> &held_ids) {
+    for (auto &kv : sub_map_) {
+        for (auto &kv2 : kv.second) {
+            if (held_ids.count(kv2.first)) continue;
+            for (auto &sub : kv2.second) {
+                sub->msg_list().clear();
+            }
+        }
+    }
+}
+
+void Network::clear_publisher_msgs() {
+    for (auto &kv : pub_map_) {
+        for (auto &kv2 : kv.second) {
+            for (auto &pub : kv2.second) {
+                pub->msg_list().clear();
+            }
+        }
+    }
+}
+
 RTreePtr &Network::rtree() {return rtree_;}
 
+ArenaPtr &Network::arena() {return arena_;}
+
+void Network::reset_arena() {
+    arena_ = Arena::create();
+    for (auto &kv : pub_map_) {
+        for (auto &kv2 : kv.second) {
+            for (auto &pub : kv2.second) {
+                pub->set_arena(arena_);
+            }
+        }
+    }
+    for (auto &kv : sub_map_) {
+        for (auto &kv2 : kv.second) {
+            for (auto &sub : kv2.second) {
+                sub->set_arena(arena_);
+            }
+        }
+    }
+}
+
 std::map<std::string, std::map<int, std::list<SubscriberPtr> > > &Network::sub_map()
 { return sub_map_; }
 
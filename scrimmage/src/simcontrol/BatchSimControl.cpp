@@ -0,0 +1,90 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <scrimmage/simcontrol/BatchSimControl.h>
+#include <scrimmage/simcontrol/InferenceBatch.h>
+#include <scrimmage/simcontrol/SimControl.h>
+
+#include <memory>
+
+namespace scrimmage {
+
+BatchSimControl::BatchSimControl() :
+    inference_batch_(std::make_shared<InferenceBatch>()) {}
+
+void BatchSimControl::add(SimControl *env) {
+    env->set_inference_batch(inference_batch_);
+    envs_.push_back(env);
+}
+
+std::vector<SimControl*> &BatchSimControl::envs() { return envs_; }
+
+InferenceBatchPtr BatchSimControl::inference_batch() { return inference_batch_; }
+
+void BatchSimControl::start() {
+    thread_ = std::thread(&BatchSimControl::run, this);
+}
+
+void BatchSimControl::run() {
+    std::vector<SimControl*> running;
+    running.reserve(envs_.size());
+    for (SimControl *env : envs_) {
+        env->run_start();
+        running.push_back(env);
+    }
+
+    while (!running.empty()) {
+        // step every environment once, dropping those that ended
+        for (SimControl *env : running) {
+            env->run_step_autonomies();
+        }
+        inference_batch_->run();
+
+        auto it = running.begin();
+        while (it != running.end()) {
+            if ((*it)->run_step_motion()) {
+                ++it;
+            } else {
+                (*it)->run_finish();
+                it = running.erase(it);
+            }
+        }
+    }
+}
+
+void BatchSimControl::join() {
+    if (thread_.joinable()) thread_.join();
+}
+
+bool BatchSimControl::finished() {
+    for (SimControl *env : envs_) {
+        if (!env->finished()) return false;
+    }
+    return true;
+}
+
+} // namespace scrimmage
@@ -0,0 +1,145 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include <scrimmage/simcontrol/EarlyTermination.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/parse/MissionParse.h>
+
+namespace scrimmage {
+
+EarlyTermination::EarlyTermination() {}
+
+void EarlyTermination::add(std::string name, Predicate predicate)
+{
+    predicates_.push_back(std::make_pair(name, predicate));
+}
+
+void EarlyTermination::clear()
+{
+    predicates_.clear();
+    reason_ = "";
+}
+
+bool EarlyTermination::empty() const { return predicates_.empty(); }
+
+bool EarlyTermination::parse(std::string str, MissionParsePtr mp)
+{
+    std::vector<std::string> entries;
+    boost::split(entries, str, boost::is_any_of(","));
+
+    for (std::string &entry : entries) {
+        boost::trim(entry);
+        if (entry.empty()) continue;
+
+        std::vector<std::string> args;
+        boost::split(args, entry, boost::is_any_of(":"));
+        std::string name = args[0];
+
+        try {
+            if (name == "team_eliminated" && args.size() == 2) {
+                add(entry, team_eliminated(std::stoi(args[1])));
+            } else if (name == "bases_unreachable" && args.size() == 2) {
+                add(entry, bases_unreachable(mp->team_info(), mp->tend(),
+                                             std::stod(args[1])));
+            } else {
+                std::cout << "Unknown early_termination predicate: "
+                          << entry << std::endl;
+                return false;
+            }
+        } catch (std::exception &e) {
+            std::cout << "Invalid early_termination argument: "
+                      << entry << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EarlyTermination::check(double t, std::list<EntityPtr> &ents)
+{
+    for (auto &name_pred : predicates_) {
+        if (name_pred.second(t, ents)) {
+            reason_ = name_pred.first;
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::string &EarlyTermination::reason() const { return reason_; }
+
+EarlyTermination::Predicate EarlyTermination::team_eliminated(int team_id)
+{
+    return [=](double t, std::list<EntityPtr> &ents) {
+        for (EntityPtr &ent : ents) {
+            if (ent->id().team_id() == team_id) return false;
+        }
+        return true;
+    };
+}
+
+EarlyTermination::Predicate EarlyTermination::bases_unreachable(
+        std::map<int, TeamInfo> &team_info, double tend, double max_speed)
+{
+    // (team_id, base position, base radius) of every base
+    struct Base {
+        int team_id;
+        Eigen::Vector3d pos;
+        double radius;
+    };
+    std::vector<Base> bases;
+    for (auto &kv : team_info) {
+        size_t i = 0;
+        for (Eigen::Vector3d &pos : kv.second.bases) {
+            double radius = i < kv.second.radii.size() ? kv.second.radii[i] : 0;
+            bases.push_back(Base{kv.first, pos, radius});
+            i++;
+        }
+    }
+
+    return [=](double t, std::list<EntityPtr> &ents) {
+        double max_dist = std::max(0.0, tend - t) * max_speed;
+        for (EntityPtr &ent : ents) {
+            for (const Base &base : bases) {
+                if (base.team_id != ent->id().team_id() &&
+                    (base.pos - ent->state()->pos()).norm() - base.radius <= max_dist) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+}
+
+} // namespace scrimmage
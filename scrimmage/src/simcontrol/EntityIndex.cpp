@@ -0,0 +1,112 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <scrimmage/simcontrol/EntityIndex.h>
+#include <scrimmage/entity/Entity.h>
+
+namespace scrimmage {
+
+EntityIndex::EntityIndex() {}
+
+void EntityIndex::clear()
+{
+    slots_.clear();
+    ents_.clear();
+}
+
+void EntityIndex::reserve(int num_entities)
+{
+    // IDs start at 1
+    slots_.reserve(num_entities + 1);
+    ents_.reserve(num_entities);
+}
+
+void EntityIndex::add(EntityPtr &ent)
+{
+    int id = ent->id().id();
+    if (id < 0) {
+        return;
+    }
+
+    if (static_cast<size_t>(id) >= slots_.size()) {
+        slots_.resize(id + 1, -1);
+    }
+
+    if (slots_[id] >= 0) {
+        ents_[slots_[id]] = ent;
+        return;
+    }
+
+    slots_[id] = ents_.size();
+    ents_.push_back(ent);
+}
+
+void EntityIndex::remove(int id)
+{
+    int s = slot(id);
+    if (s < 0) {
+        return;
+    }
+
+    // Swap the last entity into the removed slot so that ents_ stays dense
+    int last = ents_.size() - 1;
+    if (s != last) {
+        ents_[s] = ents_[last];
+        slots_[ents_[s]->id().id()] = s;
+    }
+    ents_.pop_back();
+    slots_[id] = -1;
+}
+
+bool EntityIndex::count(int id) const
+{
+    return slot(id) >= 0;
+}
+
+const EntityPtr &EntityIndex::at(int id) const
+{
+    static const EntityPtr null_ent;
+    int s = slot(id);
+    if (s < 0) {
+        return null_ent;
+    }
+    return ents_[s];
+}
+
+int EntityIndex::slot(int id) const
+{
+    if (id < 0 || static_cast<size_t>(id) >= slots_.size()) {
+        return -1;
+    }
+    return slots_[id];
+}
+
+std::vector<EntityPtr> &EntityIndex::entities() { return ents_; }
+
+int EntityIndex::size() const { return ents_.size(); }
+
+} // namespace scrimmage
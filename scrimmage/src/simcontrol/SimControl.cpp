@@ -28,7 +28,9 @@
 #include <string>
 #include <memory>
 #include <future>
+#include <set>
 
+#include <scrimmage/common/Arena.h>
 #include <scrimmage/common/Random.h>
 //#include <scrimmage/common/Shape.h>
 #include <scrimmage/parse/MissionParse.h>
@@ -40,11 +42,15 @@
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/entity/Contact.h>
 #include <scrimmage/common/RTree.h>
+#include <scrimmage/common/EngagementGeometry.h>
 #include <scrimmage/entity/Entity.h>
 #include <scrimmage/motion/MotionModel.h>
 #include <scrimmage/motion/Controller.h>
 #include <scrimmage/simcontrol/SimControl.h>
 #include <scrimmage/simcontrol/EntityInteraction.h>
+#include <scrimmage/simcontrol/EntityIndex.h>
+#include <scrimmage/simcontrol/InferenceBatch.h>
+#include <scrimmage/simcontrol/Snapshot.h>
 #include <scrimmage/parse/ConfigParse.h>
 #include <scrimmage/parse/ParseUtils.h>
 #include <scrimmage/autonomy/Autonomy.h>
@@ -70,7 +76,11 @@ using std::endl;
 namespace scrimmage {
 
     SimControl::SimControl() : mp_(NULL), display_progress_(false),
-                               finished_(false), exit_(false)
+                               finished_(false), exit_(false),
+                               time_step_(0), loop_number_(0), exit_loop_(false),
+                               multi_rate_(false),
+                               final_step_(false), restored_(false),
+                               snapshot_time_(0), recycle_entities_(false)
     {
         pause(false);
         single_step(false);
@@ -79,6 +89,7 @@ namespace scrimmage {
         plugin_manager_ = std::make_shared<scrimmage::PluginManager>();
 
         team_lookup_ = std::make_shared<std::unordered_map<int,int> >();
+        entity_index_ = std::make_shared<EntityIndex>();
 
         contacts_mutex_.lock();
         contacts_ = std::make_shared<ContactMap>();
@@ -89,24 +100,10 @@ namespace scrimmage {
         send_shutdown_msg_ = true;
     }
 
-    bool SimControl::init()
+    bool SimControl::init_mission()
     {
-        if (mp_ == NULL) {
-            cout << "Mission Parse hasn't been set yet." << endl;
-            return false;
-        }
-
         proj_ = mp_->projection(); // get projection (origin) from mission
 
-        if (get("show_plugins", mp_->params(), false)) {
-            plugin_manager_->print_plugins("scrimmage::Autonomy", "Autonomy Plugins", file_search_);
-            plugin_manager_->print_plugins("scrimmage::MotionModel", "Motion Plugins", file_search_);
-            plugin_manager_->print_plugins("scrimmage::Controller", "Controller Plugins", file_search_);
-            plugin_manager_->print_plugins("scrimmage::EntityInteraction", "Entity Interaction Plugins", file_search_);
-            plugin_manager_->print_plugins("scrimmage::Sensor", "Sensor Plugins", file_search_);
-            plugin_manager_->print_plugins("scrimmage::Sensable", "Sensable Plugins", file_search_);
-        }
-
 #if ENABLE_JSBSIM==1
         jsbsim_root_ = "./";
         if(const char* env_p = std::getenv("JSBSIM_ROOT")) {
@@ -123,6 +120,7 @@ namespace scrimmage {
         // What is the end condition?
         if (mp_->params().count("end_condition") > 0) {
             std::string cond = mp_->params()["end_condition"];
+            end_conditions_ = static_cast<EndConditionFlags>(0);
 
             if (cond.find("time") != std::string::npos) {
                 end_conditions_ = end_conditions_ | EndConditionFlags::TIME;
@@ -144,6 +142,13 @@ namespace scrimmage {
             end_conditions_ = EndConditionFlags::TIME;
         }
 
+        if (mp_->params().count("early_termination") > 0 &&
+            !early_termination_.parse(mp_->params()["early_termination"], mp_)) {
+            return false;
+        }
+
+        recycle_entities_ = get("recycle_entities", mp_->params(), false);
+
         // Start with the simulation paused?
         //if (mp_->start_paused() && mp_->enable_gui()) {
         if (mp_->start_paused()) {
@@ -207,9 +212,46 @@ namespace scrimmage {
             max_num_entities += kv.second.total_count;
         }
 
-        rtree_ = std::make_shared<scrimmage::RTree>();
+        // plugins keep pointers to the tree and geometry, reset() reuses them
+        if (rtree_ == nullptr) {
+            rtree_ = std::make_shared<scrimmage::RTree>();
+        }
         rtree_->init(max_num_entities);
 
+        if (engagement_geometry_ == nullptr) {
+            engagement_geometry_ = std::make_shared<EngagementGeometry>();
+        }
+        engagement_geometry_->set_max_range(get("engagement_max_range", mp_->params(), -1.0));
+
+        entity_index_->clear();
+        entity_index_->reserve(max_num_entities);
+
+        contacts_mutex_.lock();
+        contacts_->reserve(max_num_entities+1);
+        contacts_mutex_.unlock();
+        return true;
+    }
+
+    bool SimControl::init()
+    {
+        if (mp_ == NULL) {
+            cout << "Mission Parse hasn't been set yet." << endl;
+            return false;
+        }
+
+        if (get("show_plugins", mp_->params(), false)) {
+            plugin_manager_->print_plugins("scrimmage::Autonomy", "Autonomy Plugins", file_search_);
+            plugin_manager_->print_plugins("scrimmage::MotionModel", "Motion Plugins", file_search_);
+            plugin_manager_->print_plugins("scrimmage::Controller", "Controller Plugins", file_search_);
+            plugin_manager_->print_plugins("scrimmage::EntityInteraction", "Entity Interaction Plugins", file_search_);
+            plugin_manager_->print_plugins("scrimmage::Sensor", "Sensor Plugins", file_search_);
+            plugin_manager_->print_plugins("scrimmage::Sensable", "Sensable Plugins", file_search_);
+        }
+
+        if (!init_mission()) {
+            return false;
+        }
+
         auto it_network = mp_->params().find("network");
         if (it_network == mp_->params().end()) {
             // use default perfect model
@@ -258,8 +300,11 @@ namespace scrimmage {
 
             if (metrics != nullptr) {
                 metrics->set_team_lookup(team_lookup_);
+                metrics->set_entity_index(entity_index_);
                 metrics->set_network(network_);
+                plugin_params_[metrics] = config_parse.params();
                 metrics->init(config_parse.params());
+                set_loop_period(metrics);
                 metrics_.push_back(metrics);
             } else {
                 cout << "Failed to load metrics: " << metrics_name << endl;
@@ -288,7 +333,10 @@ namespace scrimmage {
             ent_inter->set_projection(proj_);
             ent_inter->set_network(network_);
             ent_inter->set_team_lookup(team_lookup_);
+            ent_inter->set_entity_index(entity_index_);
+            plugin_params_[ent_inter] = config_parse.params();
             ent_inter->init(mp_->params(), config_parse.params());
+            set_loop_period(ent_inter);
 
             // Get shapes from plugin
             shapes_[0].insert(shapes_[0].end(), ent_inter->shapes().begin(), ent_inter->shapes().end());
@@ -297,10 +345,98 @@ namespace scrimmage {
             ent_inters_.push_back(ent_inter);
         }
 
+        return init_entities();
+    }
+
+    bool SimControl::reset()
+    {
+        if (network_ == nullptr) {
+            cout << "SimControl::reset() needs a SimControl that has been initialized." << endl;
+            return false;
+        }
+        if (mp_ == NULL) {
+            cout << "Mission Parse hasn't been set yet." << endl;
+            return false;
+        }
+
+        // The last rollout ran on another thread. Free its blocks as the
+        // owner, so they aren't left behind.
+        network_->arena()->set_owner_thread();
+
+        // Forget the last rollout
+        set_finished(false);
+        exit_mutex_.lock();
+        exit_ = false;
+        exit_mutex_.unlock();
+        time_step_ = 0;
+        loop_number_ = 0;
+        exit_loop_ = false;
+        multi_rate_ = false;
+        final_step_ = false;
+        restored_ = false;
+        snapshot_callback_ = nullptr;
+        next_id_ = 1;
+
+        ents_.clear();
         contacts_mutex_.lock();
-        contacts_->reserve(max_num_entities+1);
+        contacts_->clear();
         contacts_mutex_.unlock();
+        contact_visuals_.clear();
+        team_lookup_->clear();
+        shapes_.clear();
+        early_termination_.clear();
+        rtree_->clear();
+        network_->clear_publisher_msgs();
+        network_->clear_subscriber_msgs();
+        // A new arena rather than bumping on through the old one
+        network_->reset_arena();
+
+        // The entities generated in the last rollout are reset by
+        // generate_entities() when their id comes up again. Those left over
+        // from the rollout before weren't generated in the last one.
+        for (auto &kv : spare_ents_) {
+            kv.second->stop_networking();
+        }
+        spare_ents_.clear();
+        for (EntityPtr &ent : generated_ents_) {
+            spare_ents_[ent->id().id()] = ent;
+        }
+        generated_ents_.clear();
+
+        if (!init_mission()) {
+            return false;
+        }
+
+        log_->init_network(network_);
+
+        for (MetricsPtr &metrics : metrics_) {
+            if (!metrics->reset(plugin_params_[metrics])) {
+                cout << "Metrics plugin " << metrics->name()
+                     << " doesn't support reset()" << endl;
+                return false;
+            }
+            set_loop_period(metrics);
+        }
 
+        for (EntityInteractionPtr &ent_inter : ent_inters_) {
+            ent_inter->set_mission_parse(mp_);
+            ent_inter->set_projection(proj_);
+            if (!ent_inter->reset(mp_->params(), plugin_params_[ent_inter])) {
+                cout << "Entity interaction plugin " << ent_inter->name()
+                     << " doesn't support reset()" << endl;
+                return false;
+            }
+            set_loop_period(ent_inter);
+
+            shapes_[0].insert(shapes_[0].end(), ent_inter->shapes().begin(), ent_inter->shapes().end());
+            ent_inter->shapes().clear();
+        }
+
+        return init_entities();
+    }
+
+    bool SimControl::init_entities()
+    {
         generate_entities(0);
 
         if (get("show_plugins", mp_->params(), false)) {
@@ -316,6 +452,11 @@ namespace scrimmage {
             for (int i = 0; i < num_entity_threads_; i++) {
                 entity_worker_threads_.push_back(std::thread(&SimControl::worker, this));
             }
+            rtree_->set_job_runner([this](std::vector<std::function<void()>> &jobs) {
+                    run_jobs(jobs);
+                }, num_entity_threads_);
+        } else {
+            rtree_->set_job_runner(nullptr, 1);
         }
 
         run_send_shapes(); // draw any intial shapes
@@ -403,19 +544,30 @@ namespace scrimmage {
                     it->second["longitude"] = std::to_string(lon);
                     it->second["altitude"] = std::to_string(alt);
 
-                    std::shared_ptr<Entity> ent = std::make_shared<Entity>();
-                    ent->set_random(random_);
-                    ent->set_parameter_vector(parameter_vector_);
-                    ent->set_nn_path(nn_path_);
-                    ent->set_nn_path2(nn_path2_);
+                    // Reuse the entity with this id from the last rollout,
+                    // unless one of its plugins can't be reset
+                    EntityPtr ent = spare_entity(next_id_, it->first);
+                    bool recycled = false;
+                    if (ent != nullptr) {
+                        configure_entity(ent);
+                        recycled = ent->reset(it->second, mp_, proj_);
+                    }
 
-                    contacts_mutex_.lock();
-                    AttributeMap &attr_map = mp_->entity_attributes()[it->first];
-                    bool ent_status = ent->init(attr_map, it->second, contacts_,mp_,
-                                                proj_, next_id_, it->first,
-                                                plugin_manager_,
-                                                network_, file_search_, rtree_);
-                    contacts_mutex_.unlock();
+                    bool ent_status = true;
+                    if (!recycled) {
+                        // from the heap, recycled entities outlive the
+                        // rollout's arena
+                        ent = std::make_shared<Entity>();
+                        configure_entity(ent);
+
+                        contacts_mutex_.lock();
+                        AttributeMap &attr_map = mp_->entity_attributes()[it->first];
+                        ent_status = ent->init(attr_map, it->second, contacts_,mp_,
+                                               proj_, next_id_, it->first,
+                                               plugin_manager_,
+                                               network_, file_search_, rtree_);
+                        contacts_mutex_.unlock();
+                    }
 
                     if (!ent_status) {
                         cout << "Failed to parse entity at start position: "
@@ -430,13 +582,32 @@ namespace scrimmage {
                     // Send the visual information to the viewer
                     outgoing_interface_->send_contact_visual(ent->contact_visual());
 
+                    for (AutonomyPtr &autonomy : ent->autonomies()) {
+                        autonomy->set_entity_index(entity_index_);
+                        set_loop_period(autonomy);
+                    }
+                    for (auto &kv : ent->sensors()) {
+                        for (SensorPtr &sensor : kv.second) {
+                            set_loop_period(sensor);
+                        }
+                    }
+                    for (auto &kv : ent->sensables()) {
+                        for (SensablePtr &sensable : kv.second) {
+                            set_loop_period(sensable);
+                        }
+                    }
+
                     ents_.push_back(ent);
+                    if (recycle_entities_) {
+                        generated_ents_.push_back(ent);
+                    }
+                    entity_index_->add(ent);
                     rtree_->add(ent->state()->pos(), ent->id());
                     contacts_mutex_.lock();
                     (*contacts_)[ent->id().id()] = Contact(ent->id(), ent->state(), ent->type(), ent->contact_visual(), ent->sensables());
                     contacts_mutex_.unlock();
 
-                    auto msg = std::make_shared<Message<sm::EntityGenerated>>();
+                    auto msg = network_->arena()->make_shared<Message<sm::EntityGenerated>>();
                     msg->data.set_entity_id(ent->id().id());
                     pubsub_->publish(t, pub_ent_gen_, msg);
 
@@ -473,11 +644,55 @@ namespace scrimmage {
         return true;
     }
 
+    void SimControl::configure_entity(EntityPtr &ent)
+    {
+        ent->set_random(random_);
+        ent->set_parameter_vector(parameter_vector_);
+        ent->set_nn_path(nn_path_);
+        ent->set_nn_path2(nn_path2_);
+        ent->set_opponent(opponent_);
+        ent->set_search_distribution(search_distribution_);
+        ent->set_engagement_geometry(engagement_geometry_);
+        ent->set_inference_batch(use_entity_threads_ ? nullptr : inference_batch_);
+    }
+
+    void SimControl::set_inference_batch(InferenceBatchPtr batch)
+    {
+        inference_batch_ = batch;
+        for (EntityPtr &ent : ents_) {
+            ent->set_inference_batch(use_entity_threads_ ? nullptr : inference_batch_);
+        }
+    }
+
+    EntityPtr SimControl::spare_entity(int id, int sub_swarm_id)
+    {
+        auto it = spare_ents_.find(id);
+        if (it == spare_ents_.end()) {
+            return nullptr;
+        }
+        EntityPtr ent = it->second;
+        spare_ents_.erase(it);
+
+        // a different entity description
+        if (ent->id().sub_swarm_id() != sub_swarm_id) {
+            ent->stop_networking();
+            return nullptr;
+        }
+        return ent;
+    }
+
     void SimControl::set_mission_parse(MissionParsePtr mp) { mp_ = mp; }
 
     MissionParsePtr SimControl::mp() { return mp_; }
 
-    void SimControl::set_log(std::shared_ptr<Log> &log) { log_ = log; }
+    void SimControl::set_log(std::shared_ptr<Log> &log)
+    {
+        // the log of the last rollout, see reset()
+        if (log_ && log_ != log) {
+            log_->close_network();
+        }
+        log_ = log;
+    }
 
     bool SimControl::enable_gui()
     {
@@ -493,7 +708,176 @@ namespace scrimmage {
 
     void SimControl::join()
     {
-        thread_.join();
+        // not started when run by a BatchSimControl
+        if (thread_.joinable()) thread_.join();
+    }
+
+    void SimControl::snapshot(Snapshot &snapshot) {
+        snapshot.set("sim/t", t());
+        snapshot.set("sim/time_step", time_step_);
+        snapshot.set("sim/next_id", next_id_);
+        snapshot.set("sim/random", random_->state());
+
+        snapshot.set("sim/gen_info", mp_->gen_info());
+        for (auto &kv : mp_->next_gen_times()) {
+            snapshot.set("sim/next_gen_times/" + std::to_string(kv.first), kv.second);
+        }
+
+        std::vector<int> ids;
+        for (EntityPtr &ent : ents_) {
+            int id = ent->id().id();
+            ids.push_back(id);
+            ent->save_state(snapshot, "entity/" + std::to_string(id));
+        }
+        snapshot.set("sim/entity_ids", ids);
+
+        int i = 0;
+        for (EntityInteractionPtr &ent_inter : ent_inters_) {
+            ent_inter->save_state(snapshot, "interaction/" + std::to_string(i++));
+        }
+        i = 0;
+        for (MetricsPtr &metrics : metrics_) {
+            metrics->save_state(snapshot, "metrics/" + std::to_string(i++));
+        }
+    }
+
+    bool SimControl::restore(const Snapshot &snapshot) {
+        double t;
+        unsigned int time_step;
+        int next_id;
+        std::string random_state;
+        std::vector<int> ids;
+        std::map<int, GenerateInfo> gen_info;
+        if (!snapshot.get("sim/t", t) ||
+            !snapshot.get("sim/time_step", time_step) ||
+            !snapshot.get("sim/next_id", next_id) ||
+            !snapshot.get("sim/random", random_state) ||
+            !snapshot.get("sim/gen_info", gen_info) ||
+            !snapshot.get("sim/entity_ids", ids)) {
+            cout << "Snapshot is missing the simulation state" << endl;
+            return false;
+        }
+
+        if (!random_->set_state(random_state)) {
+            cout << "Failed to restore the random number generator" << endl;
+            return false;
+        }
+
+        mp_->gen_info() = gen_info;
+        for (auto &kv : mp_->next_gen_times()) {
+            snapshot.get("sim/next_gen_times/" + std::to_string(kv.first), kv.second);
+        }
+
+        // entities that had been removed when the snapshot was taken
+        std::set<int> snapshot_ids(ids.begin(), ids.end());
+        std::map<int, EntityPtr> ents;
+        for (EntityPtr &ent : ents_) {
+            if (snapshot_ids.count(ent->id().id())) {
+                ents[ent->id().id()] = ent;
+            } else {
+                ent->set_active(false);
+            }
+        }
+        run_remove_inactive();
+
+        for (int id : ids) {
+            auto it = ents.find(id);
+            if (it == ents.end()) {
+                cout << "Snapshot entity " << id
+                     << " doesn't exist in this simulation" << endl;
+                return false;
+            }
+            if (!it->second->restore_state(snapshot, "entity/" + std::to_string(id))) {
+                cout << "Failed to restore entity " << id << endl;
+                return false;
+            }
+        }
+
+        bool success = true;
+        int i = 0;
+        for (EntityInteractionPtr &ent_inter : ent_inters_) {
+            success &= ent_inter->restore_state(snapshot, "interaction/" + std::to_string(i++));
+        }
+        i = 0;
+        for (MetricsPtr &metrics : metrics_) {
+            success &= metrics->restore_state(snapshot, "metrics/" + std::to_string(i++));
+        }
+        if (!success) {
+            cout << "Failed to restore entity interactions or metrics" << endl;
+            return false;
+        }
+
+        next_id_ = next_id;
+        time_step_ = time_step;
+        set_time(t);
+        restored_ = true;
+        return true;
+    }
+
+    void SimControl::set_snapshot_callback(double t, std::function<void(SnapshotPtr)> callback) {
+        snapshot_time_ = t;
+        snapshot_callback_ = callback;
+    }
+
+    void SimControl::set_loop_period(const PluginPtr &plugin) {
+        if (plugin->loop_rate() <= 0) return;
+
+        double steps = 1.0 / (plugin->loop_rate() * dt_);
+        int period = std::max(1, static_cast<int>(std::round(steps)));
+        if (std::abs(steps - period) > 1e-6) {
+            cout << plugin->name() << ": loop_rate " << plugin->loop_rate()
+                 << " isn't a divisor of the simulation rate, stepping every "
+                 << period << " time steps" << endl;
+        }
+        plugin->set_loop_period(period);
+        multi_rate_ |= period > 1;
+    }
+
+    bool SimControl::loop_due(const PluginPtr &plugin) {
+        return final_step_ || plugin->loop_due(time_step_);
+    }
+
+    double SimControl::loop_dt(const PluginPtr &plugin) {
+        return plugin->loop_steps(time_step_) * dt_;
+    }
+
+    void SimControl::clear_subscriber_msgs() {
+        if (!multi_rate_) {
+            network_->clear_subscriber_msgs();
+            return;
+        }
+
+        // The entities' plugins have stepped this time step, the entity
+        // interactions and metrics on the last one
+        std::set<int> held_ids;
+        for (EntityPtr &ent : ents_) {
+            for (auto &kv : ent->sensors()) {
+                for (SensorPtr &sensor : kv.second) {
+                    if (!loop_due(sensor)) held_ids.insert(sensor->get_network_id());
+                }
+            }
+            for (auto &kv : ent->sensables()) {
+                for (SensablePtr &sensable : kv.second) {
+                    if (!loop_due(sensable)) held_ids.insert(sensable->get_network_id());
+                }
+            }
+            for (AutonomyPtr &autonomy : ent->autonomies()) {
+                if (!loop_due(autonomy)) held_ids.insert(autonomy->get_network_id());
+            }
+        }
+        if (time_step_ > 0) {
+            for (EntityInteractionPtr &ent_inter : ent_inters_) {
+                if (!ent_inter->loop_due(time_step_ - 1)) {
+                    held_ids.insert(ent_inter->get_network_id());
+                }
+            }
+            for (MetricsPtr &metrics : metrics_) {
+                if (!metrics->loop_due(time_step_ - 1)) {
+                    held_ids.insert(metrics->get_network_id());
+                }
+            }
+        }
+        network_->clear_subscriber_msgs(held_ids);
     }
 
     void SimControl::create_rtree() {
@@ -501,6 +885,8 @@ namespace scrimmage {
         for (EntityPtr &ent: ents_) {
             rtree_->add(ent->state()->pos(), ent->id());
         }
+        rtree_->compute_neighbors();
+        engagement_geometry_->update(ents_);
     }
 
     void SimControl::set_autonomy_contacts() {
@@ -526,9 +912,13 @@ namespace scrimmage {
     }
 
     bool SimControl::run_interaction_detection() {
+        // the entities have moved since create_rtree()
+        engagement_geometry_->update(ents_);
+
         bool any_false = false;
         for (EntityInteractionPtr ent_inter : ent_inters_) {
-            bool result = ent_inter->step_entity_interaction(ents_, t_, dt_);
+            if (!loop_due(ent_inter)) continue;
+            bool result = ent_inter->step_entity_interaction(ents_, t_, loop_dt(ent_inter));
             if (!result) {
                 cout << "Entity interaction requested simulation termination: "
                      << ent_inter->name() << endl;
@@ -543,7 +933,7 @@ namespace scrimmage {
             if (!it->is_alive() && it->posthumous(this->t())) {
                 int id = it->id().id();
 
-                auto msg = std::make_shared<Message<sm::EntityRemoved>>();
+                auto msg = network_->arena()->make_shared<Message<sm::EntityRemoved>>();
                 msg->data.set_entity_id(id);
                 pubsub_->publish_immediate(t_, pub_ent_rm_, msg);
 
@@ -566,7 +956,9 @@ namespace scrimmage {
         outgoing_interface_->send_frame(t_, contacts_);
 
         for (MetricsPtr metrics : metrics_) {
-            metrics->step_metrics(t(), dt_);
+            if (loop_due(metrics)) {
+                metrics->step_metrics(t(), loop_dt(metrics));
+            }
         }
         contacts_mutex_.unlock();
     }
@@ -578,6 +970,7 @@ namespace scrimmage {
             if (!(*it)->active()) {
                 int id = (*it)->id().id();
                 it = ents_.erase(it);
+                entity_index_->remove(id);
                 contacts_mutex_.lock();
                 contacts_->erase(id);
                 contacts_mutex_.unlock();
@@ -589,92 +982,133 @@ namespace scrimmage {
 
     void SimControl::run()
     {
-        start_overall_timer();
+        run_start();
         // Simulate over the time range
-        int loop_number = 0;
-        bool exit_loop = false;
-        set_time(t0_);
-        bool end_condition_interaction;
-        do {
-            double t = this->t();
-            start_loop_timer();
-            if (!generate_entities(t)) {
-                cout << "Failed to generate entity" << endl;
+        while (run_step()) {}
+        run_finish();
+    }
+
+    void SimControl::run_start()
+    {
+        start_overall_timer();
+        // the arena is only allocated from by the thread running the steps
+        network_->arena()->set_owner_thread();
+        // a restored simulation continues at the snapshot's time step
+        loop_number_ = restored_ ? time_step_ : 0;
+        exit_loop_ = false;
+        if (!restored_) set_time(t0_);
+    }
+
+    bool SimControl::run_step()
+    {
+        run_step_autonomies();
+        if (inference_batch_) inference_batch_->run();
+        return run_step_motion();
+    }
+
+    void SimControl::run_step_autonomies()
+    {
+        double t = this->t();
+        time_step_ = loop_number_;
+        start_loop_timer();
+        if (!generate_entities(t)) {
+            cout << "Failed to generate entity" << endl;
+        }
+        create_rtree();
+        set_autonomy_contacts();
+        run_autonomies();
+    }
+
+    bool SimControl::run_step_motion()
+    {
+        double t = this->t();
+        run_motion();
+        // Distribute messages from entities
+        clear_subscriber_msgs();
+        network_->distribute();
+        bool end_condition_interaction = run_interaction_detection();
+        if (end_condition_interaction) {
+            auto msg = network_->arena()->make_shared<Message<sm::EntityInteractionExit>>();
+            pubsub_->publish_immediate(t_, pub_ent_int_exit_, msg);
+        }
+        // Interaction plugins use publish_immediate, so subs will have
+        // newest messages
+        run_logging();
+
+        run_remove_inactive();
+        run_send_shapes();
+        run_send_contact_visuals(); // send updated visuals
+        if (display_progress_) {
+            if (loop_number_ % 100 == 0) {
+                sc::display_progress((tend_ == 0) ? 1.0 : t / tend_);
             }
-            create_rtree();
-            set_autonomy_contacts();
-            run_entities();
-            // Distribute messages from entities
-            network_->clear_subscriber_msgs();
-            network_->distribute();
-            end_condition_interaction = run_interaction_detection();
-            if (end_condition_interaction) {
-                auto msg = std::make_shared<Message<sm::EntityInteractionExit>>();
-                pubsub_->publish_immediate(t_, pub_ent_int_exit_, msg);
+        }
+
+        // Wait loop timer.
+        // Stay in loop if currently paused.
+        do {
+            loop_wait();
+            // Were we told to exit, externally?
+            exit_mutex_.lock();
+            if (exit_) {
+                exit_loop_ = true;
             }
-            // Interaction plugins use publish_immediate, so subs will have
-            // newest messages
-            run_logging();
-
-            run_remove_inactive();
-            run_send_shapes();
-            run_send_contact_visuals(); // send updated visuals
-            if (display_progress_) {
-                if (loop_number % 100 == 0) {
-                    sc::display_progress((tend_ == 0) ? 1.0 : t / tend_);
-                }
+            exit_mutex_.unlock();
+            if (single_step()) {
+                single_step(false);
+                take_step_mutex_.lock();
+                take_step_ = true;
+                take_step_mutex_.unlock();
+                break;
             }
+            run_check_network_msgs();
+            scrimmage_proto::SimInfo info;
+            info.set_time(this->t());
+            info.set_desired_warp(this->time_warp());
+            info.set_actual_warp(this->actual_time_warp());
+            info.set_shutting_down(false);
+            outgoing_interface_->send_sim_info(info);
+        } while(paused() && !exit_loop_);
+        // Increment time and loop counter
+        set_time(t + dt_);
+        loop_number_++;
+
+        if (snapshot_callback_ && t >= snapshot_time_ - dt_ / 2.0) {
+            time_step_ = loop_number_;
+            SnapshotPtr snap = std::make_shared<Snapshot>();
+            snapshot(*snap);
+            snapshot_callback_(snap);
+            snapshot_callback_ = nullptr;
+        }
 
-            // Wait loop timer.
-            // Stay in loop if currently paused.
-            do {
-                loop_wait();
-                // Were we told to exit, externally?
-                exit_mutex_.lock();
-                if (exit_) {
-                    exit_loop = true;
-                }
-                exit_mutex_.unlock();
-                if (single_step()) {
-                    single_step(false);
-                    take_step_mutex_.lock();
-                    take_step_ = true;
-                    take_step_mutex_.unlock();
-                    break;
-                }
-                run_check_network_msgs();
-                scrimmage_proto::SimInfo info;
-                info.set_time(this->t());
-                info.set_desired_warp(this->time_warp());
-                info.set_actual_warp(this->actual_time_warp());
-                info.set_shutting_down(false);
-                outgoing_interface_->send_sim_info(info);
-            } while(paused() && !exit_loop);
-            // Increment time and loop counter
-            set_time(t + dt_);
-            loop_number++;
-
-        } while (!end_condition_interaction && !end_condition_reached(t(), dt_) && !exit_loop);
+        return !end_condition_interaction && !end_condition_reached(this->t(), dt_) && !exit_loop_;
+    }
 
+    void SimControl::run_finish()
+    {
         if (use_entity_threads_) {
+            entity_pool_mutex_.lock();
             entity_pool_stop_ = true;
+            entity_pool_mutex_.unlock();
             entity_pool_condition_var_.notify_all();
             for (std::thread &t : entity_worker_threads_) {
                 t.join();
             }
+            rtree_->set_job_runner(nullptr, 1);
         }
         // account for last step
         set_time(t() - dt_);
-        loop_number--;
+        loop_number_--;
 
         // Save EntityPresentAtEnd messages
         for (EntityPtr &ent : ents_) {
-            auto msg = std::make_shared<Message<sm::EntityPresentAtEnd>>();
+            auto msg = network_->arena()->make_shared<Message<sm::EntityPresentAtEnd>>();
             msg->data.set_entity_id(ent->id().id());
             pubsub_->publish_immediate(t_, pub_ent_pres_end_, msg);
         }
 
         //run entity interaction again so that interactions can finalize things
+        final_step_ = true;
         run_interaction_detection();
 
         run_logging();
@@ -687,13 +1121,13 @@ namespace scrimmage {
     bool SimControl::end_condition_reached(double t, double dt)
     {
         if ((static_cast<int>(end_conditions_) & static_cast<int>(EndConditionFlags::TIME)) && t > mp_->tend() + dt/2.0) {
-            auto msg = std::make_shared<Message<sm::EndTime>>();
+            auto msg = network_->arena()->make_shared<Message<sm::EndTime>>();
             pubsub_->publish_immediate(t, pub_end_time_, msg);
             return true;
         }
 
         if (ents_.empty()) {
-            auto msg = std::make_shared<Message<sm::NoTeamsPresent>>();
+            auto msg = network_->arena()->make_shared<Message<sm::NoTeamsPresent>>();
             pubsub_->publish_immediate(t, pub_no_teams_, msg);
             if (static_cast<int>(end_conditions_) & static_cast<int>(EndConditionFlags::ALL_DEAD | EndConditionFlags::ONE_TEAM)) {
 //                std::cout << std::endl << "End of Simulation: No Entities Remaining" << std::endl;
@@ -705,7 +1139,7 @@ namespace scrimmage {
             // note that ents_ cannot be empty from the above if statement
             int team1_id = ents_.front()->id().team_id();
             if (!std::any_of(ents_.rbegin(), ents_.rend(), [=](EntityPtr &ent) {return team1_id != ent->id().team_id();})) {
-                auto msg = std::make_shared<Message<sm::OneTeamPresent>>();
+                auto msg = network_->arena()->make_shared<Message<sm::OneTeamPresent>>();
                 pubsub_->publish_immediate(t, pub_one_team_, msg);
                 //                std::cout << std::endl << "End of Simulation: One Team (" << team1_id << ")" << std::endl;
                 if (static_cast<int>(end_conditions_) & static_cast<int>(EndConditionFlags::ONE_TEAM))
@@ -713,13 +1147,21 @@ namespace scrimmage {
             }
         }
 
+        if (!early_termination_.empty() && early_termination_.check(t, ents_)) {
+            return true;
+        }
+
         return false;
     }
 
+    EarlyTermination &SimControl::early_termination() { return early_termination_; }
+
     Timer &SimControl::timer() {return timer_;}
 
     std::list<MetricsPtr> &SimControl::metrics() { return metrics_; }
 
+    EntityIndexPtr &SimControl::entity_index() { return entity_index_; }
+
     PluginManagerPtr &SimControl::plugin_manager() {return plugin_manager_;}
 
     FileSearch &SimControl::file_search() {return file_search_;}
@@ -959,11 +1401,16 @@ namespace scrimmage {
 
     void SimControl::worker() {
         while (true) {
+            // the predicate keeps a task queued while every worker was busy
+            // from waiting for the next notify
             entity_pool_mutex_.lock();
-            entity_pool_condition_var_.wait(entity_pool_mutex_);
+            entity_pool_condition_var_.wait(entity_pool_mutex_, [this]() {
+                    return entity_pool_stop_ || !entity_pool_queue_.empty();
+                });
+            bool stop = entity_pool_stop_ && entity_pool_queue_.empty();
             entity_pool_mutex_.unlock();
 
-            if (entity_pool_stop_) {
+            if (stop) {
                 break;
             }
 
@@ -977,22 +1424,36 @@ namespace scrimmage {
                 entity_pool_queue_.pop_front();
                 entity_pool_mutex_.unlock();
 
+                if (task->job) {
+                    task->job();
+                    entity_pool_mutex_.lock();
+                    task->prom.set_value(true);
+                    entity_pool_mutex_.unlock();
+                    continue;
+                }
+
                 bool success = true;
 
                 for (auto &kv : task->ent->sensables()) {
                     for (SensablePtr &sensable : kv.second) {
-                        success &= sensable->update(t_, dt_);
+                        if (loop_due(sensable)) {
+                            success &= sensable->update(t_, loop_dt(sensable));
+                        }
                     }
                 }
 
                 for (auto &kv : task->ent->sensors()) {
                     for (SensorPtr &sensor : kv.second) {
-                        success &= sensor->sense(t_, dt_);
+                        if (loop_due(sensor)) {
+                            success &= sensor->sense(t_, loop_dt(sensor));
+                        }
                     }
                 }
 
                 for (AutonomyPtr &autonomy : task->ent->autonomies()) {
-                    success &= autonomy->step_autonomy(t_, dt_);
+                    if (loop_due(autonomy)) {
+                        success &= autonomy->step_autonomy(t_, loop_dt(autonomy));
+                    }
                 }
 
                 double motion_dt = dt_ / mp_->motion_multiplier();
@@ -1012,7 +1473,26 @@ namespace scrimmage {
         }
     }
 
-    void SimControl::run_entities() {
+    void SimControl::run_jobs(std::vector<std::function<void()>> &jobs) {
+        std::vector<std::future<bool>> futures;
+        futures.reserve(jobs.size());
+
+        entity_pool_mutex_.lock();
+        for (std::function<void()> &job : jobs) {
+            std::shared_ptr<Task> task = std::make_shared<Task>();
+            task->job = job;
+            entity_pool_queue_.push_back(task);
+            futures.push_back(task->prom.get_future());
+        }
+        entity_pool_mutex_.unlock();
+        entity_pool_condition_var_.notify_all();
+
+        for (std::future<bool> &future : futures) {
+            future.get();
+        }
+    }
+
+    void SimControl::run_autonomies() {
         contacts_mutex_.lock();
         if (use_entity_threads_) {
             // put tasks on queue
@@ -1039,19 +1519,32 @@ namespace scrimmage {
             for (EntityPtr ent : ents_) {
                 for (auto &kv : ent->sensables()) {
                     for (SensablePtr &sensable : kv.second) {
-                        sensable->update(t_, dt_);
+                        if (loop_due(sensable)) {
+                            sensable->update(t_, loop_dt(sensable));
+                        }
                     }
                 }
                 for (auto &kv : ent->sensors()) {
                     for (SensorPtr &sensor : kv.second) {
-                        sensor->sense(t_, dt_);
+                        if (loop_due(sensor)) {
+                            sensor->sense(t_, loop_dt(sensor));
+                        }
                     }
                 }
                 for (AutonomyPtr &autonomy : ent->autonomies()) {
-                    autonomy->step_autonomy(t_, dt_);
+                    if (loop_due(autonomy)) {
+                        autonomy->step_autonomy(t_, loop_dt(autonomy));
+                    }
                 }
                 ent->setup_desired_state();
             }
+        }
+        contacts_mutex_.unlock();
+    }
+
+    void SimControl::run_motion() {
+        contacts_mutex_.lock();
+        if (!use_entity_threads_) {
             double motion_dt = dt_ / mp_->motion_multiplier();
             double temp_t = t_;
             for (int i = 0; i < mp_->motion_multiplier(); i++) {
@@ -0,0 +1,95 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <scrimmage/simcontrol/Snapshot.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/plugin_manager/Plugin.h>
+#include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/pubsub/Subscriber.h>
+
+#include <array>
+
+namespace scrimmage {
+
+void Snapshot::set(std::string key, const State &state)
+{
+    const Eigen::Vector3d &pos = state.pos_const();
+    const Eigen::Vector3d &vel = state.vel_const();
+    const Quaternion &quat = state.quat_const();
+    std::array<double, 10> values = {{pos(0), pos(1), pos(2),
+                                      vel(0), vel(1), vel(2),
+                                      quat.w(), quat.x(), quat.y(), quat.z()}};
+    set(key, values);
+}
+
+bool Snapshot::get(std::string key, State &state) const
+{
+    std::array<double, 10> values;
+    if (!get(key, values)) return false;
+    state.pos() << values[0], values[1], values[2];
+    state.vel() << values[3], values[4], values[5];
+    state.quat() = Quaternion(values[6], values[7], values[8], values[9]);
+    return true;
+}
+
+void Snapshot::save_messages(const std::string &prefix, Plugin &plugin)
+{
+    for (auto &kv : plugin.pubs()) {
+        if (!kv.second->msg_list().empty()) {
+            MessageList &msgs = kv.second->msg_list();
+            messages_[prefix + "/pub/" + kv.first].assign(msgs.begin(), msgs.end());
+        }
+    }
+    for (auto &kv : plugin.subs()) {
+        if (!kv.second->msg_list().empty()) {
+            MessageList &msgs = kv.second->msg_list();
+            messages_[prefix + "/sub/" + kv.first].assign(msgs.begin(), msgs.end());
+        }
+    }
+}
+
+void Snapshot::restore_messages(const std::string &prefix, Plugin &plugin) const
+{
+    auto restore = [&](const std::string &key, MessageList &msgs) {
+        auto it = messages_.find(key);
+        if (it == messages_.end()) {
+            msgs.clear();
+        } else {
+            // keeps the list's allocator, the arena of this simulation
+            msgs.assign(it->second.begin(), it->second.end());
+        }
+    };
+    for (auto &kv : plugin.pubs()) {
+        restore(prefix + "/pub/" + kv.first, kv.second->msg_list());
+    }
+    for (auto &kv : plugin.subs()) {
+        restore(prefix + "/sub/" + kv.first, kv.second->msg_list());
+    }
+}
+
+} // namespace scrimmage
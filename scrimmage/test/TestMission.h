@@ -0,0 +1,133 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef TEST_MISSION_H_
+#define TEST_MISSION_H_
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+#include <scrimmage/entity/Contact.h>
+#include <scrimmage/log/Log.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/network/Interface.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/simcontrol/SimControl.h>
+
+// Two teams of aircraft flying at each other with the core plugins
+// (Straight, SimpleAircraft and SimpleCollision), loaded from
+// SCRIMMAGE_PLUGIN_PATH. Besides five aircraft spread out around each
+// start point, one aircraft of each team flies head on at the other along
+// y = 400, so that the two collide at about t = 4.8. Returns the name
+// of the mission file.
+inline std::string write_test_mission(double end = 5)
+{
+    char name[] = "/tmp/test_mission_XXXXXX";
+    close(mkstemp(name));
+    std::ofstream file(name);
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<runscript name=\"test_mission\">\n"
+         << "  <run start=\"0.0\" end=\"" << end << "\" dt=\"0.1\" time_warp=\"0\"\n"
+         << "       enable_gui=\"false\" network_gui=\"false\" start_paused=\"false\"/>\n"
+         << "  <end_condition>time</end_condition>\n"
+         << "  <output_type>summary</output_type>\n"
+         << "  <metrics order=\"0\">SimpleCollisionMetrics</metrics>\n"
+         << "  <entity_interaction order=\"0\">SimpleCollision</entity_interaction>\n"
+         << "  <latitude_origin>35.721025</latitude_origin>\n"
+         << "  <longitude_origin>-120.767925</longitude_origin>\n"
+         << "  <altitude_origin>300</altitude_origin>\n";
+    for (int team = 1; team <= 2; team++) {
+        for (int count : {5, 1}) {
+            double variance = count == 1 ? 0 : 100;
+            file << "  <entity>\n"
+                 << "    <team_id>" << team << "</team_id>\n"
+                 << "    <color>77 77 255</color>\n"
+                 << "    <count>" << count << "</count>\n"
+                 << "    <health>1</health>\n"
+                 << "    <variance_x>" << variance << "</variance_x>\n"
+                 << "    <variance_y>" << variance << "</variance_y>\n"
+                 << "    <variance_z>" << variance / 10 << "</variance_z>\n"
+                 << "    <x>" << (team == 1 ? -100 : 100) << "</x>\n"
+                 << "    <y>" << (count == 1 ? 400 : 0) << "</y>\n"
+                 << "    <z>200</z>\n"
+                 << "    <heading>" << (team == 1 ? 0 : 180) << "</heading>\n"
+                 << "    <controller>SimpleAircraftControllerPID</controller>\n"
+                 << "    <motion_model>SimpleAircraft</motion_model>\n"
+                 << "    <autonomy>Straight</autonomy>\n"
+                 << "  </entity>\n";
+        }
+    }
+    file << "</runscript>\n";
+    return name;
+}
+
+// A simulation of a test mission, without logging or a GUI
+struct TestEnv {
+    scrimmage::SimControl sim;
+    std::shared_ptr<scrimmage::Log> log = std::make_shared<scrimmage::Log>();
+
+    bool init(scrimmage::MissionParsePtr mp, int seed) {
+        mp->params()["seed"] = std::to_string(seed);
+        log->set_enable_log(false);
+        log->init(mp->log_dir(), scrimmage::Log::NONE);
+        sim.set_log(log);
+
+        scrimmage::InterfacePtr to_gui_interface = std::make_shared<scrimmage::Interface>();
+        scrimmage::InterfacePtr from_gui_interface = std::make_shared<scrimmage::Interface>();
+        to_gui_interface->set_log(log);
+        from_gui_interface->set_log(log);
+        sim.set_incoming_interface(from_gui_interface);
+        sim.set_outgoing_interface(to_gui_interface);
+
+        sim.set_mission_parse(mp);
+        if (!sim.init()) return false;
+        sim.display_progress(false);
+        return true;
+    }
+
+    // The exact state of every entity at the end
+    std::map<int, std::vector<double>> result() {
+        std::unordered_map<int, scrimmage::Contact> contacts;
+        sim.get_contacts(contacts);
+        std::map<int, std::vector<double>> states;
+        for (auto &kv : contacts) {
+            scrimmage::StatePtr &s = kv.second.state();
+            states[kv.first] = {s->pos()(0), s->pos()(1), s->pos()(2),
+                                s->vel()(0), s->vel()(1), s->vel()(2),
+                                s->quat().w(), s->quat().x(), s->quat().y(),
+                                s->quat().z()};
+        }
+        return states;
+    }
+};
+#endif
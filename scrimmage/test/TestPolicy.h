@@ -0,0 +1,61 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#ifndef TEST_POLICY_H_
+#define TEST_POLICY_H_
+#include <cmath>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+// The CaptureTheFlagLearn policy and inputs shared by the FixedMLP and
+// QuantizedMLP tests and the InferenceBatch test
+
+// input size with 2 friends and 3 enemies
+const size_t policy_num_inputs = 9 + 4 + 4 + 10 * 2 + 7 * 3;
+
+inline void make_policy(tiny_dnn::network<tiny_dnn::sequential> &net, size_t num_inputs)
+{
+    using namespace tiny_dnn;
+    using namespace tiny_dnn::layers;
+    net << fc(num_inputs, 200) << activation::tanh()
+        << fc(200, 200) << activation::tanh()
+        << fc(200, 50) << activation::tanh()
+        << fc(50, 3) << activation::tanh();
+    net.weight_init(weight_init::lecun());
+    net.bias_init(weight_init::lecun());
+    net.init_weight();
+}
+
+inline tiny_dnn::vec_t make_input(size_t n, int k)
+{
+    tiny_dnn::vec_t in(n);
+    for (size_t i = 0; i < n; i++) {
+        in[i] = std::sin(0.37 * i + k) * (1 + k % 3);
+    }
+    return in;
+}
+#endif
@@ -0,0 +1,184 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <scrimmage/common/Arena.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/plugin_manager/Plugin.h>
+#include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/pubsub/Subscriber.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+TEST(arena_test, reuses_freed_blocks)
+{
+    auto arena = sc::Arena::create();
+    void *a = arena->allocate(40);
+    void *b = arena->allocate(40);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % sc::Arena::granularity, 0u);
+    EXPECT_EQ(arena->bytes_in_use(), 96u);
+
+    arena->deallocate(a, 40);
+    // same size class
+    void *c = arena->allocate(33);
+    EXPECT_EQ(a, c);
+    // a different size class doesn't get it
+    arena->deallocate(c, 33);
+    void *d = arena->allocate(8);
+    EXPECT_NE(a, d);
+
+    arena->deallocate(b, 40);
+    arena->deallocate(d, 8);
+    EXPECT_EQ(arena->bytes_in_use(), 0u);
+}
+
+TEST(arena_test, steady_state)
+{
+    // publishing the same messages every step stops growing the arena
+    auto arena = sc::Arena::create();
+    size_t reserved = 0;
+    for (int step = 0; step < 100; step++) {
+        std::vector<std::shared_ptr<sc::Message<double>>> msgs;
+        for (int i = 0; i < 50; i++) {
+            msgs.push_back(arena->make_shared<sc::Message<double>>(i));
+        }
+        EXPECT_EQ(msgs.back()->data, 49);
+        if (step == 0) reserved = arena->bytes_reserved();
+    }
+    EXPECT_GT(reserved, 0u);
+    EXPECT_EQ(arena->bytes_reserved(), reserved);
+    EXPECT_EQ(arena->bytes_in_use(), 0u);
+}
+
+TEST(arena_test, large_blocks)
+{
+    auto arena = sc::Arena::create();
+    void *p = arena->allocate(sc::Arena::max_block_size + 1);
+    EXPECT_EQ(arena->bytes_in_use(), 0u);
+    arena->deallocate(p, sc::Arena::max_block_size + 1);
+
+    std::shared_ptr<sc::State> state = arena->make_shared<sc::State>();
+    state->pos() << 1, 2, 3;
+    EXPECT_EQ(state->pos()(2), 3);
+}
+
+TEST(arena_test, outlives_owner)
+{
+    // blocks stay valid after the last ArenaPtr is gone, the arena is
+    // freed with the last block
+    std::shared_ptr<sc::Message<int>> msg;
+    std::shared_ptr<sc::State> state;
+    {
+        sc::ArenaPtr arena = sc::Arena::create();
+        msg = arena->make_shared<sc::Message<int>>(7);
+        state = arena->make_shared<sc::State>();
+    }
+    EXPECT_EQ(msg->data, 7);
+    msg = nullptr;
+    state->pos() << 1, 2, 3;
+    EXPECT_EQ(state->pos()(0), 1);
+    state = nullptr;
+}
+
+TEST(arena_test, full)
+{
+    // once the reservation is used up, blocks come from the heap
+    auto arena = sc::Arena::create(64);
+    void *a = arena->allocate(48);
+    void *b = arena->allocate(48);
+    EXPECT_EQ(arena->bytes_reserved(), 48u);
+    EXPECT_EQ(arena->bytes_in_use(), 48u);
+    arena->deallocate(b, 48);
+    arena->deallocate(a, 48);
+    EXPECT_EQ(arena->bytes_in_use(), 0u);
+}
+
+TEST(arena_test, threads)
+{
+    // only the owner thread allocates from the arena or reuses its blocks
+    auto arena = sc::Arena::create();
+    std::thread worker([arena]() {
+        sc::ArenaAllocator<int> alloc(arena.get());
+        for (int i = 0; i < 1000; i++) {
+            std::list<int, sc::ArenaAllocator<int>> list(alloc);
+            for (int j = 0; j < 20; j++) list.push_back(j);
+        }
+    });
+    worker.join();
+    EXPECT_EQ(arena->bytes_reserved(), 0u);
+
+    // a block freed on another thread isn't reused
+    auto msg = arena->make_shared<sc::Message<int>>(1);
+    void *block = msg.get();
+    std::thread([&msg]() { msg = nullptr; }).join();
+    auto next = arena->make_shared<sc::Message<int>>(2);
+    EXPECT_NE(static_cast<void*>(next.get()), block);
+
+    // handing the arena to another thread
+    std::thread([arena]() {
+        arena->set_owner_thread();
+        size_t reserved = arena->bytes_reserved();
+        void *p = arena->allocate(16);
+        EXPECT_EQ(arena->bytes_reserved(), reserved + 16);
+        arena->deallocate(p, 16);
+        void *q = arena->allocate(16);
+        EXPECT_EQ(q, p);
+        arena->deallocate(q, 16);
+    }).join();
+}
+
+TEST(arena_test, network)
+{
+    auto network = std::make_shared<sc::Network>();
+    auto plugin = std::make_shared<sc::Plugin>();
+    plugin->set_network(network);
+    sc::PublisherPtr pub = plugin->create_publisher("topic");
+    sc::SubscriberPtr sub = plugin->create_subscriber("topic");
+    EXPECT_EQ(pub->arena(), network->arena());
+    EXPECT_EQ(sub->arena(), network->arena());
+
+    auto msg = sc::make_shared_from<sc::Message<int>>(pub->arena(), 3);
+    plugin->publish(0, pub, msg);
+    network->distribute();
+    ASSERT_EQ(sub->msg_list().size(), 1u);
+    EXPECT_EQ(sub->msg_list().front(), msg);
+    EXPECT_GT(network->arena()->bytes_in_use(), 0u);
+
+    // without an arena, the heap
+    auto heap_msg = sc::make_shared_from<sc::Message<int>>(nullptr, 4);
+    EXPECT_EQ(heap_msg->data, 4);
+}
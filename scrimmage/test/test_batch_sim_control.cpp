@@ -0,0 +1,93 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/simcontrol/BatchSimControl.h>
+#include <scrimmage/simcontrol/SimControl.h>
+#include <scrimmage/simcontrol/Snapshot.h>
+
+#include "TestMission.h"
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+TEST(batch_sim_control_test, identical_to_threads)
+{
+    std::string mission_file = write_test_mission();
+    sc::MissionParsePtr mission = std::make_shared<sc::MissionParse>();
+    ASSERT_TRUE(mission->parse(mission_file));
+    std::remove(mission_file.c_str());
+
+    // Environment 1 is told to exit at t = 2, from its own thread so that
+    // it stops on the same time step in both runs
+    const size_t num_envs = 4;
+    const size_t exit_env = 1;
+    auto make_envs = [&](std::vector<std::unique_ptr<TestEnv>> &envs) {
+        for (size_t i = 0; i < num_envs; i++) {
+            envs.emplace_back(new TestEnv());
+            ASSERT_TRUE(envs.back()->init(mission->clone(), 10 + i))
+                << "the core plugins need to be in SCRIMMAGE_PLUGIN_PATH";
+        }
+        sc::SimControl *sim = &envs[exit_env]->sim;
+        sim->set_snapshot_callback(2.0, [sim](sc::SnapshotPtr) { sim->force_exit(); });
+    };
+
+    // a thread per environment
+    std::vector<std::unique_ptr<TestEnv>> threaded;
+    make_envs(threaded);
+    for (auto &env : threaded) env->sim.start();
+    for (auto &env : threaded) env->sim.join();
+
+    // two batches of two, stepped in lockstep
+    std::vector<std::unique_ptr<TestEnv>> batched;
+    make_envs(batched);
+    std::vector<sc::BatchSimControlPtr> batches;
+    for (size_t i = 0; i < num_envs; i++) {
+        if (i % 2 == 0) batches.push_back(std::make_shared<sc::BatchSimControl>());
+        batches.back()->add(&batched[i]->sim);
+    }
+    for (auto &batch : batches) batch->start();
+    for (auto &batch : batches) batch->join();
+
+    for (auto &batch : batches) EXPECT_TRUE(batch->finished());
+    for (size_t i = 0; i < num_envs; i++) {
+        EXPECT_TRUE(batched[i]->sim.finished());
+        EXPECT_EQ(batched[i]->sim.t(), threaded[i]->sim.t());
+        EXPECT_EQ(batched[i]->result(), threaded[i]->result()) << "environment " << i;
+    }
+    EXPECT_LT(batched[exit_env]->sim.t(), 3.0);
+    EXPECT_GT(batched[exit_env + 1]->sim.t(), 4.5);
+
+    // environments with different seeds don't end up the same
+    EXPECT_NE(batched[2]->result(), batched[3]->result());
+}
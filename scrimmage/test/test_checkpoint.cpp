@@ -0,0 +1,159 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <scrimmage/common/Checkpoint.h>
+#include <scrimmage/common/Random.h>
+#include <scrimmage/common/Utilities.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+
+std::string checkpoint_name()
+{
+    char name[] = "/tmp/test_checkpoint_XXXXXX";
+    int fd = mkstemp(name);
+    close(fd);
+    return std::string(name);
+}
+
+TEST(checkpoint_test, round_trip)
+{
+    std::string filename = checkpoint_name();
+
+    std::vector<float> theta = {1.5f, -0.25f, std::numeric_limits<float>::denorm_min(), 3e38f};
+    sc::Checkpoint ckpt;
+    ckpt.set("generation", static_cast<size_t>(42));
+    ckpt.set("testing", true);
+    ckpt.set("log_dir", std::string("/tmp/some,dir"));
+    ckpt.set("theta", theta);
+    ASSERT_TRUE(ckpt.save(filename));
+
+    sc::Checkpoint loaded;
+    ASSERT_TRUE(loaded.load(filename));
+
+    size_t n = 0;
+    bool testing = false;
+    std::string log_dir;
+    std::vector<float> theta2;
+    ASSERT_TRUE(loaded.get("generation", n));
+    ASSERT_TRUE(loaded.get("testing", testing));
+    ASSERT_TRUE(loaded.get("log_dir", log_dir));
+    ASSERT_TRUE(loaded.get("theta", theta2));
+    ASSERT_EQ(n, 42);
+    ASSERT_TRUE(testing);
+    ASSERT_EQ(log_dir, "/tmp/some,dir");
+    ASSERT_EQ(theta, theta2);
+
+    // wrong size and missing keys
+    int small;
+    ASSERT_FALSE(loaded.get("generation", small));
+    ASSERT_FALSE(loaded.get("missing", n));
+
+    std::remove(filename.c_str());
+}
+
+TEST(checkpoint_test, corrupt)
+{
+    std::string filename = checkpoint_name();
+
+    sc::Checkpoint ckpt;
+    ckpt.set("theta", std::vector<double>(100, 1.0));
+    ASSERT_TRUE(ckpt.save(filename));
+
+    // flip a byte in the body
+    {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(40);
+        file.put('x');
+    }
+
+    sc::Checkpoint loaded;
+    ASSERT_FALSE(loaded.load(filename));
+    ASSERT_FALSE(loaded.has("theta"));
+
+    std::remove(filename.c_str());
+
+    // a length that wraps around the end of the body, e.g. off the network
+    uint64_t header[] = {1, std::numeric_limits<uint64_t>::max() - 7, 0};
+    std::string body(reinterpret_cast<char *>(header), sizeof(header));
+    EXPECT_FALSE(loaded.deserialize(body));
+}
+
+TEST(checkpoint_test, async_writer)
+{
+    std::string filename = checkpoint_name();
+
+    sc::CheckpointWriter writer;
+    for (int i = 0; i < 5; i++) {
+        sc::Checkpoint ckpt;
+        ckpt.set("generation", i);
+        writer.save(std::move(ckpt), filename);
+    }
+    ASSERT_TRUE(writer.wait());
+
+    sc::Checkpoint loaded;
+    int n = -1;
+    ASSERT_TRUE(loaded.load(filename));
+    ASSERT_TRUE(loaded.get("generation", n));
+    ASSERT_EQ(n, 4);
+
+    std::remove(filename.c_str());
+}
+
+TEST(checkpoint_test, learner_state)
+{
+    // Random continues the same sequence after a restore
+    sc::Random random;
+    random.seed(1234);
+    random.rng_normal();
+    std::string state = random.state();
+
+    sc::Random restored;
+    ASSERT_TRUE(restored.set_state(state));
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(random.rng_normal(), restored.rng_normal());
+        ASSERT_EQ(random.rng_uniform_int(0, 1000), restored.rng_uniform_int(0, 1000));
+    }
+
+    // Adam continues with the same moments
+    sc::AdamOptimizer<std::vector<double>> adam, adam2;
+    std::vector<double> grad = {0.1, -0.2, 0.3};
+    adam.step(grad);
+    adam2.set_moments(adam.first_moment(), adam.second_moment());
+    ASSERT_EQ(adam.step(grad), adam2.step(grad));
+}
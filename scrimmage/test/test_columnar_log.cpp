@@ -0,0 +1,202 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <memory>
+#include <string>
+#include <vector>
+#include <list>
+#include <cstdio>
+#include <fstream>
+
+#include <unistd.h>
+
+#include <scrimmage/log/ColumnarLog.h>
+#include <scrimmage/log/FrameReader.h>
+#include <scrimmage/proto/Frame.pb.h>
+
+#include <google/protobuf/util/message_differencer.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+namespace sp = scrimmage_proto;
+
+std::shared_ptr<sp::Frame> make_frame(int i)
+{
+    auto frame = std::make_shared<sp::Frame>();
+    frame->set_time(i * 0.1);
+    // entities drop out over time
+    for (int j = 0; j < 5 - i / 10; j++) {
+        sp::Contact *c = frame->add_contact();
+        c->mutable_id()->set_id(j + 1);
+        c->mutable_id()->set_sub_swarm_id(0);
+        c->mutable_id()->set_team_id(j % 2 + 1);
+        c->set_type(j % 2 ? sp::QUADROTOR : sp::AIRCRAFT);
+        c->set_active(j != 2);
+        sp::State *s = c->mutable_state();
+        s->mutable_position()->set_x(i + j);
+        s->mutable_position()->set_y(-i * 0.5);
+        s->mutable_position()->set_z(100 + j);
+        s->mutable_velocity()->set_x(j);
+        s->mutable_orientation()->set_w(1);
+        s->mutable_orientation()->set_z(0.01 * i);
+    }
+    return frame;
+}
+
+std::string temp_name()
+{
+    char name[] = "/tmp/test_columnar_log_XXXXXX";
+    int fd = mkstemp(name);
+    close(fd);
+    return std::string(name);
+}
+
+void round_trip(bool compress)
+{
+    std::string filename = temp_name();
+    std::vector<std::shared_ptr<sp::Frame>> frames;
+    for (int i = 0; i < 45; i++) {
+        frames.push_back(make_frame(i));
+    }
+
+    sc::ColumnarLogWriter writer;
+    ASSERT_TRUE(writer.open(filename, 16, compress));
+    for (auto &frame : frames) {
+        ASSERT_TRUE(writer.write_frame(*frame));
+    }
+    ASSERT_TRUE(writer.close());
+
+    sc::ColumnarLogReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    std::list<std::shared_ptr<sp::Frame>> result;
+    ASSERT_TRUE(reader.read_all(result));
+    ASSERT_TRUE(reader.clean_eof());
+    ASSERT_EQ(result.size(), frames.size());
+
+    auto it = result.begin();
+    for (auto &frame : frames) {
+        ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(*frame, **it));
+        ++it;
+    }
+    std::remove(filename.c_str());
+}
+
+TEST(columnar_log_test, round_trip)
+{
+    round_trip(true);
+    round_trip(false);
+}
+
+TEST(columnar_log_test, convert)
+{
+    std::string col_file = temp_name();
+    std::string bin_file = temp_name();
+    std::string col_file2 = temp_name();
+
+    sc::ColumnarLogWriter writer;
+    ASSERT_TRUE(writer.open(col_file, 7));
+    for (int i = 0; i < 30; i++) {
+        ASSERT_TRUE(writer.write_frame(*make_frame(i)));
+    }
+    ASSERT_TRUE(writer.close());
+
+    ASSERT_TRUE(sc::columnar_to_frames(col_file, bin_file));
+
+    sc::FrameReader frames;
+    ASSERT_TRUE(frames.open(bin_file, false));
+    ASSERT_EQ(frames.size(), 30);
+    ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+        *frames.read(17), *make_frame(17)));
+
+    ASSERT_TRUE(sc::frames_to_columnar(bin_file, col_file2));
+    sc::ColumnarLogReader reader;
+    ASSERT_TRUE(reader.open(col_file2));
+    std::list<std::shared_ptr<sp::Frame>> result;
+    ASSERT_TRUE(reader.read_all(result));
+    ASSERT_EQ(result.size(), 30);
+    ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+        *result.back(), *make_frame(29)));
+
+    std::remove(col_file.c_str());
+    std::remove(bin_file.c_str());
+    std::remove(col_file2.c_str());
+}
+
+TEST(columnar_log_test, truncated)
+{
+    std::string filename = temp_name();
+    sc::ColumnarLogWriter writer;
+    ASSERT_TRUE(writer.open(filename, 10));
+    for (int i = 0; i < 25; i++) {
+        ASSERT_TRUE(writer.write_frame(*make_frame(i)));
+    }
+    ASSERT_TRUE(writer.close());
+
+    // drop the tail of the last chunk
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    size_t size = in.tellg();
+    in.close();
+    ASSERT_EQ(truncate(filename.c_str(), size - 5), 0);
+
+    sc::ColumnarLogReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    std::list<std::shared_ptr<sp::Frame>> result;
+    ASSERT_FALSE(reader.read_all(result));
+    ASSERT_FALSE(reader.clean_eof());
+    ASSERT_EQ(result.size(), 20);
+    std::remove(filename.c_str());
+}
+
+TEST(columnar_log_test, corrupt_size)
+{
+    std::string filename = temp_name();
+    sc::ColumnarLogWriter writer;
+    ASSERT_TRUE(writer.open(filename, 10));
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(writer.write_frame(*make_frame(i)));
+    }
+    ASSERT_TRUE(writer.close());
+
+    // the stored size of the first chunk, after the magic, the three
+    // counts, the compressed flag and the raw size
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(8 + 3 * sizeof(uint32_t) + 1 + sizeof(uint64_t));
+    uint64_t huge = 1ULL << 62;
+    file.write(reinterpret_cast<const char *>(&huge), sizeof(huge));
+    file.close();
+
+    // rejected without trying to allocate it
+    sc::ColumnarLogReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    std::list<std::shared_ptr<sp::Frame>> result;
+    ASSERT_FALSE(reader.read_all(result));
+    ASSERT_FALSE(reader.clean_eof());
+    ASSERT_TRUE(result.empty());
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,105 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <list>
+#include <memory>
+
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/simcontrol/EarlyTermination.h>
+#include <scrimmage/common/ID.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+
+namespace {
+sc::EntityPtr make_entity(int id, int team_id, double x)
+{
+    sc::EntityPtr ent = std::make_shared<sc::Entity>();
+    sc::ID ent_id(id, 0, team_id);
+    ent->set_id(ent_id);
+    ent->state()->pos() << x, 0, 0;
+    return ent;
+}
+} // namespace
+
+TEST(early_termination_test, team_eliminated)
+{
+    sc::EarlyTermination term;
+    term.add("team_eliminated:1", sc::EarlyTermination::team_eliminated(1));
+
+    std::list<sc::EntityPtr> ents;
+    ents.push_back(make_entity(1, 1, 0));
+    ents.push_back(make_entity(2, 2, 0));
+    EXPECT_FALSE(term.check(0, ents));
+
+    ents.pop_front();
+    EXPECT_TRUE(term.check(1, ents));
+    EXPECT_EQ(term.reason(), "team_eliminated:1");
+}
+
+TEST(early_termination_test, bases_unreachable)
+{
+    std::map<int, sc::TeamInfo> team_info;
+    team_info[1].team_id = 1;
+    team_info[1].bases.push_back(Eigen::Vector3d(0, 0, 0));
+    team_info[1].radii.push_back(10);
+    team_info[2].team_id = 2;
+    team_info[2].bases.push_back(Eigen::Vector3d(1000, 0, 0));
+    team_info[2].radii.push_back(10);
+
+    sc::EarlyTermination term;
+    term.add("bases_unreachable", sc::EarlyTermination::bases_unreachable(team_info, 100, 10));
+
+    // team 1 at x = 500 needs 49 s to reach the team 2 base
+    std::list<sc::EntityPtr> ents;
+    ents.push_back(make_entity(1, 1, 500));
+    EXPECT_FALSE(term.check(50, ents));
+    EXPECT_FALSE(term.check(51, ents));
+    EXPECT_TRUE(term.check(51.5, ents));
+
+    // its own base doesn't count
+    ents.front()->state()->pos() << 5, 0, 0;
+    EXPECT_TRUE(term.check(99, ents));
+}
+
+TEST(early_termination_test, parse)
+{
+    sc::MissionParsePtr mp = std::make_shared<sc::MissionParse>();
+
+    sc::EarlyTermination term;
+    EXPECT_TRUE(term.parse("team_eliminated:1, bases_unreachable:30", mp));
+    EXPECT_FALSE(term.empty());
+
+    sc::EarlyTermination bad;
+    EXPECT_FALSE(bad.parse("team_eliminated", mp));
+    EXPECT_FALSE(bad.parse("team_eliminated:x", mp));
+    EXPECT_FALSE(bad.parse("no_such_predicate:1", mp));
+}
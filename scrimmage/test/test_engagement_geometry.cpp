@@ -0,0 +1,154 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cmath>
+#include <list>
+#include <memory>
+#include <random>
+
+#include <scrimmage/common/EngagementGeometry.h>
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/math/State.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+namespace {
+
+std::list<sc::EntityPtr> random_entities(int num, unsigned int seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> pos(-100, 100);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> pitch(-0.5, 0.5);
+
+    std::list<sc::EntityPtr> ents;
+    for (int i = 1; i <= num; i++) {
+        sc::EntityPtr ent = std::make_shared<sc::Entity>();
+        sc::ID id(i, 0, i % 2 + 1);
+        ent->set_id(id);
+        ent->state()->pos() << pos(gen), pos(gen), pos(gen) / 10;
+        ent->state()->quat().set(angle(gen) / 4, pitch(gen), angle(gen));
+        // push_front so the snapshot has to sort them
+        ents.push_front(ent);
+    }
+    return ents;
+}
+
+}  // namespace
+
+TEST(engagement_geometry_test, matches_state)
+{
+    std::list<sc::EntityPtr> ents = random_entities(40, 1);
+    sc::EngagementGeometry geometry;
+    geometry.update(ents);
+
+    for (sc::EntityPtr &src : ents) {
+        const sc::EngagementRow *row = geometry.row(src->id().id());
+        ASSERT_NE(row, nullptr);
+        ASSERT_EQ(row->size(), ents.size() - 1);
+
+        for (sc::EntityPtr &tgt : ents) {
+            int tgt_id = tgt->id().id();
+            const sc::Engagement *e = row->find(tgt_id);
+            if (tgt == src) {
+                EXPECT_EQ(e, nullptr);
+                continue;
+            }
+            ASSERT_NE(e, nullptr);
+            EXPECT_EQ(e->target_id, tgt_id);
+
+            sc::State &state = *src->state();
+            Eigen::Vector3d rel_pos = state.rel_pos_local_frame(tgt->state()->pos());
+            EXPECT_NEAR((e->rel_pos - rel_pos).norm(), 0, 1e-9);
+            EXPECT_DOUBLE_EQ(e->range, (tgt->state()->pos() - state.pos()).norm());
+            EXPECT_NEAR(e->az, atan2(rel_pos(1), rel_pos(0)), 1e-9);
+            EXPECT_NEAR(e->el, atan2(rel_pos(2), rel_pos.head<2>().norm()), 1e-9);
+
+            for (double fov : {0.3, 1.0, 2.5}) {
+                // skip targets within rounding of the edge of the cone
+                if (std::abs(std::abs(e->az) - fov / 2) < 1e-9 ||
+                    std::abs(std::abs(e->el) - fov / 2) < 1e-9) continue;
+                EXPECT_EQ(e->in_field_of_view(fov, fov),
+                          state.InFieldOfView(*tgt->state(), fov, fov));
+            }
+        }
+    }
+}
+
+TEST(engagement_geometry_test, max_range)
+{
+    std::list<sc::EntityPtr> ents = random_entities(40, 2);
+    sc::EngagementGeometry geometry;
+    geometry.set_max_range(60);
+    geometry.update(ents);
+
+    for (sc::EntityPtr &src : ents) {
+        for (sc::EntityPtr &tgt : ents) {
+            if (tgt == src) continue;
+            double range = (tgt->state()->pos() - src->state()->pos()).norm();
+            sc::Engagement e;
+            EXPECT_EQ(geometry.get(src->id().id(), tgt->id().id(), e), range <= 60);
+        }
+    }
+
+    EXPECT_FALSE(geometry.contains(0));
+    EXPECT_FALSE(geometry.contains(41));
+    EXPECT_EQ(geometry.row(41), nullptr);
+}
+
+TEST(engagement_geometry_test, update)
+{
+    std::list<sc::EntityPtr> ents = random_entities(5, 3);
+    sc::EngagementGeometry geometry;
+    geometry.update(ents);
+
+    sc::Engagement before;
+    ASSERT_TRUE(geometry.get(1, 2, before));
+
+    // rows are only refreshed by update()
+    sc::EntityPtr ent2 = nullptr;
+    for (sc::EntityPtr &ent : ents) {
+        if (ent->id().id() == 2) ent2 = ent;
+    }
+    ent2->state()->pos()(0) += 10;
+
+    sc::Engagement e;
+    ASSERT_TRUE(geometry.get(1, 2, e));
+    EXPECT_EQ(e.range, before.range);
+
+    geometry.update(ents);
+    ASSERT_TRUE(geometry.get(1, 2, e));
+    EXPECT_NE(e.range, before.range);
+
+    ents.remove(ent2);
+    geometry.update(ents);
+    EXPECT_FALSE(geometry.contains(2));
+    EXPECT_FALSE(geometry.get(1, 2, e));
+    EXPECT_EQ(geometry.row(1)->size(), 3);
+}
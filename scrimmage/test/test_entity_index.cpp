@@ -0,0 +1,118 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <memory>
+#include <vector>
+
+#include <scrimmage/entity/Entity.h>
+#include <scrimmage/simcontrol/EntityIndex.h>
+#include <scrimmage/common/ID.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+
+sc::EntityPtr make_entity(int id, int team_id)
+{
+    sc::EntityPtr ent = std::make_shared<sc::Entity>();
+    sc::ID ent_id(id, 0, team_id);
+    ent->set_id(ent_id);
+    return ent;
+}
+
+TEST(entity_index_test, add_find)
+{
+    sc::EntityIndex index;
+    index.reserve(10);
+
+    std::vector<sc::EntityPtr> ents;
+    for (int i = 1; i <= 10; i++) {
+        ents.push_back(make_entity(i, i % 2 + 1));
+        index.add(ents.back());
+    }
+
+    ASSERT_EQ(index.size(), 10);
+    for (sc::EntityPtr &ent : ents) {
+        int id = ent->id().id();
+        ASSERT_TRUE(index.count(id));
+        ASSERT_EQ(index.at(id), ent);
+        ASSERT_EQ(index.entities()[index.slot(id)], ent);
+    }
+
+    ASSERT_FALSE(index.count(0));
+    ASSERT_FALSE(index.count(11));
+    ASSERT_FALSE(index.count(-1));
+    ASSERT_EQ(index.at(11), nullptr);
+}
+
+TEST(entity_index_test, remove)
+{
+    sc::EntityIndex index;
+
+    std::vector<sc::EntityPtr> ents;
+    for (int i = 1; i <= 5; i++) {
+        ents.push_back(make_entity(i, 1));
+        index.add(ents.back());
+    }
+
+    index.remove(2);
+    index.remove(5);
+    index.remove(42); // not present, no-op
+
+    ASSERT_EQ(index.size(), 3);
+    ASSERT_FALSE(index.count(2));
+    ASSERT_FALSE(index.count(5));
+    ASSERT_EQ(index.at(2), nullptr);
+
+    // Remaining entities must still be reachable through their slots
+    for (int id : {1, 3, 4}) {
+        ASSERT_TRUE(index.count(id));
+        ASSERT_EQ(index.at(id)->id().id(), id);
+        ASSERT_EQ(index.entities()[index.slot(id)]->id().id(), id);
+    }
+
+    // IDs are not reused, but adding after a removal must still work
+    sc::EntityPtr ent = make_entity(6, 2);
+    index.add(ent);
+    ASSERT_EQ(index.size(), 4);
+    ASSERT_EQ(index.at(6), ent);
+}
+
+TEST(entity_index_test, missing_const)
+{
+    sc::EntityIndex index;
+    sc::EntityPtr ent = make_entity(1, 1);
+    index.add(ent);
+
+    // lookups only read the index, so they work on a const one and missing
+    // ids all share one null pointer that can't be assigned through
+    const sc::EntityIndex &const_index = index;
+    ASSERT_EQ(const_index.at(1), ent);
+    ASSERT_EQ(const_index.at(2), nullptr);
+    ASSERT_EQ(&const_index.at(2), &const_index.at(-1));
+}
@@ -0,0 +1,248 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <scrimmage/math/FastMath.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace fm = scrimmage::fast_math;
+
+namespace {
+
+// error of x in units in the last place of the (more precise) reference
+double ulps(double x, long double ref)
+{
+    double r = static_cast<double>(ref);
+    if (x == r) return 0;
+    double ulp = std::nextafter(std::fabs(r), INFINITY) - std::fabs(r);
+    if (ulp == 0 || std::isinf(ulp)) ulp = std::numeric_limits<double>::denorm_min();
+    return static_cast<double>(std::fabs(static_cast<long double>(x) - ref) / ulp);
+}
+
+// equal or both NaN
+bool same(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+template <class F, class Ref>
+double max_ulps(double lo, double hi, F f, Ref ref)
+{
+    std::mt19937_64 gen(1);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    double max_err = 0;
+    for (int i = 0; i < 200000; i++) {
+        double x = dist(gen);
+        max_err = std::max(max_err, ulps(f(x), ref(x)));
+    }
+    return max_err;
+}
+
+struct Libm {
+    static void sincos(double x, double &s, double &c) { s = std::sin(x); c = std::cos(x); }
+    static double tan(double x) { return std::tan(x); }
+    static double atan2(double y, double x) { return std::atan2(y, x); }
+};
+
+struct Fast {
+    static void sincos(double x, double &s, double &c) { fm::sincos(x, s, c); }
+    static double tan(double x) { return fm::tan(x); }
+    static double atan2(double y, double x) { return fm::atan2(y, x); }
+};
+
+// A SimpleAircraft (turning radius 13, roll limited to 30 degrees) flying
+// pursuit on a target that turns at a constant rate. Returns the closest
+// approach, the engagement being a capture when it's within 5 m.
+template <class M>
+double pursuit(double x, double y, double yaw, double tx, double ty, double tyaw)
+{
+    const double dt = 0.1, speed = 25, target_speed = 24, length = 13;
+    const double max_roll = 30 * M_PI / 180, target_turn = 0.15;
+    double roll = 0, min_dist = INFINITY;
+    for (int i = 0; i < 1000; i++) {
+        double dx = tx - x, dy = ty - y;
+        min_dist = std::min(min_dist, std::sqrt(dx * dx + dy * dy));
+
+        double err = M::atan2(dy, dx) - yaw;
+        err = M::atan2(std::sin(err), std::cos(err));
+        roll = std::max(-max_roll, std::min(max_roll, roll + dt * (2 * err - roll)));
+
+        double s, c;
+        M::sincos(yaw, s, c);
+        x += dt * speed * c;
+        y += dt * speed * s;
+        yaw += dt * speed / length * M::tan(roll);
+
+        M::sincos(tyaw, s, c);
+        tx += dt * target_speed * c;
+        ty += dt * target_speed * s;
+        tyaw += dt * target_turn;
+    }
+    return min_dist;
+}
+
+} // namespace
+
+TEST(fast_math_test, sin_cos)
+{
+    auto sin = [](double x) { return fm::sin(x); };
+    auto cos = [](double x) { return fm::cos(x); };
+    auto sinl = [](double x) { return std::sin(static_cast<long double>(x)); };
+    auto cosl = [](double x) { return std::cos(static_cast<long double>(x)); };
+    EXPECT_LE(max_ulps(-10, 10, sin, sinl), 1.5);
+    EXPECT_LE(max_ulps(-10, 10, cos, cosl), 1.5);
+    EXPECT_LE(max_ulps(-1e5, 1e5, sin, sinl), 2.5);
+    EXPECT_LE(max_ulps(-1e5, 1e5, cos, cosl), 2.5);
+
+    // beyond the reduction's range libm is used
+    EXPECT_EQ(fm::sin(1e300), std::sin(1e300));
+    EXPECT_EQ(fm::cos(-1e10), std::cos(-1e10));
+    EXPECT_TRUE(std::isnan(fm::sin(NAN)));
+    EXPECT_TRUE(std::isnan(fm::cos(INFINITY)));
+    EXPECT_EQ(fm::sin(0.0), 0.0);
+    EXPECT_EQ(fm::cos(0.0), 1.0);
+}
+
+TEST(fast_math_test, tan)
+{
+    auto tan = [](double x) { return fm::tan(x); };
+    auto tanl = [](double x) { return std::tan(static_cast<long double>(x)); };
+    EXPECT_LE(max_ulps(-10, 10, tan, tanl), 3);
+    EXPECT_LE(max_ulps(-1e5, 1e5, tan, tanl), 4);
+    EXPECT_EQ(fm::tan(1e300), std::tan(1e300));
+}
+
+TEST(fast_math_test, atan2)
+{
+    for (double x : {1.0, -1.0, 0.7, -1e-3, 1e6}) {
+        auto atan2 = [x](double y) { return fm::atan2(y, x); };
+        auto atan2l = [x](double y) {
+            return std::atan2(static_cast<long double>(y), static_cast<long double>(x));
+        };
+        EXPECT_LE(max_ulps(-3, 3, atan2, atan2l), 1.5) << "x = " << x;
+        EXPECT_LE(max_ulps(-1e6, 1e6, atan2, atan2l), 1.5) << "x = " << x;
+    }
+
+    for (double y : {0.0, -0.0, 1.0, -1.0}) {
+        for (double x : {0.0, -0.0, 1.0, -1.0, HUGE_VAL, -HUGE_VAL}) {
+            double expected = std::atan2(y, x);
+            double result = fm::atan2(y, x);
+            EXPECT_EQ(result, expected) << "atan2(" << y << ", " << x << ")";
+            EXPECT_EQ(std::signbit(result), std::signbit(expected));
+        }
+    }
+    EXPECT_EQ(fm::atan2(INFINITY, 1.0), M_PI / 2);
+    EXPECT_EQ(fm::atan2(-INFINITY, -1.0), -M_PI / 2);
+    EXPECT_TRUE(std::isnan(fm::atan2(NAN, 1.0)));
+    EXPECT_TRUE(std::isnan(fm::atan2(1.0, NAN)));
+}
+
+TEST(fast_math_test, exp_tanh)
+{
+    auto exp = [](double x) { return fm::exp(x); };
+    auto expl = [](double x) { return std::exp(static_cast<long double>(x)); };
+    auto tanh = [](double x) { return fm::tanh(x); };
+    auto tanhl = [](double x) { return std::tanh(static_cast<long double>(x)); };
+    EXPECT_LE(max_ulps(-708, 709.7, exp, expl), 1.5);
+    EXPECT_LE(max_ulps(-2, 2, exp, expl), 1.5);
+    EXPECT_LE(max_ulps(-1e-3, 1e-3, tanh, tanhl), 1.5);
+    EXPECT_LE(max_ulps(-1, 1, tanh, tanhl), 1.5);
+    EXPECT_LE(max_ulps(-20, 20, tanh, tanhl), 1.5);
+
+    EXPECT_EQ(fm::exp(0.0), 1.0);
+    EXPECT_EQ(fm::exp(-800.0), 0.0);
+    EXPECT_EQ(fm::exp(710.0), INFINITY);
+    EXPECT_EQ(fm::exp(-INFINITY), 0.0);
+    EXPECT_TRUE(std::isnan(fm::exp(NAN)));
+    EXPECT_EQ(fm::tanh(0.0), 0.0);
+    EXPECT_EQ(fm::tanh(100.0), 1.0);
+    EXPECT_EQ(fm::tanh(-INFINITY), -1.0);
+    EXPECT_TRUE(std::isnan(fm::tanh(NAN)));
+}
+
+TEST(fast_math_test, batch)
+{
+    std::vector<double> x, y;
+    for (int i = 0; i < 1001; i++) {
+        x.push_back((i - 500) * 0.37);
+        y.push_back(std::cos(i * 0.1) * 3);
+    }
+    x[17] = 1e300;
+    x[18] = NAN;
+    size_t n = x.size();
+    std::vector<double> out(n);
+
+    fm::sin(x.data(), out.data(), n);
+    for (size_t i = 0; i < n; i++) EXPECT_TRUE(same(out[i], fm::sin(x[i]))) << i;
+    fm::cos(x.data(), out.data(), n);
+    for (size_t i = 0; i < n; i++) EXPECT_TRUE(same(out[i], fm::cos(x[i]))) << i;
+    fm::tan(x.data(), out.data(), n);
+    for (size_t i = 0; i < n; i++) EXPECT_TRUE(same(out[i], fm::tan(x[i]))) << i;
+    fm::atan2(y.data(), x.data(), out.data(), n);
+    for (size_t i = 0; i < n; i++) EXPECT_TRUE(same(out[i], fm::atan2(y[i], x[i]))) << i;
+
+    std::vector<double> in_place(y);
+    fm::tanh(in_place.data(), in_place.data(), n);
+    for (size_t i = 0; i < n; i++) EXPECT_TRUE(same(in_place[i], fm::tanh(y[i]))) << i;
+    fm::exp(x.data(), out.data(), n);
+    for (size_t i = 0; i < n; i++) EXPECT_TRUE(same(out[i], fm::exp(x[i]))) << i;
+
+    std::vector<float> f(y.begin(), y.end()), f_out(n);
+    fm::tanh(f.data(), f_out.data(), n);
+    for (size_t i = 0; i < n; i++) EXPECT_NEAR(f_out[i], std::tanh(f[i]), 1e-7) << i;
+}
+
+TEST(fast_math_test, pursuit_outcomes)
+{
+    // The individual trajectories diverge after enough steps, so compare
+    // the outcome statistics over many initial conditions instead
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> pos(-500, 500), angle(-M_PI, M_PI);
+    const int runs = 300;
+    int captures_libm = 0, captures_fast = 0;
+    double dist_libm = 0, dist_fast = 0;
+    for (int i = 0; i < runs; i++) {
+        double x = pos(gen), y = pos(gen), yaw = angle(gen);
+        double tx = pos(gen), ty = pos(gen), tyaw = angle(gen);
+        double d_libm = pursuit<Libm>(x, y, yaw, tx, ty, tyaw);
+        double d_fast = pursuit<Fast>(x, y, yaw, tx, ty, tyaw);
+        captures_libm += d_libm < 5;
+        captures_fast += d_fast < 5;
+        dist_libm += d_libm / runs;
+        dist_fast += d_fast / runs;
+    }
+    EXPECT_GT(captures_libm, runs / 10);
+    EXPECT_LT(captures_libm, runs);
+    EXPECT_NEAR(captures_fast, captures_libm, 0.02 * runs);
+    EXPECT_NEAR(dist_fast, dist_libm, 0.02 * dist_libm);
+}
@@ -0,0 +1,211 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <scrimmage/common/FitnessShaping.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+
+namespace {
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// The rank transform that was inlined in scrimmage-learn, with nan scores
+// already replaced by -1e100
+std::vector<double> original_rank_transform(std::vector<double> scores)
+{
+    size_t num_threads = scores.size();
+    std::vector<double> rank(scores.size());
+    std::vector<double> rank_scores(scores.size());
+    std::size_t m(0);
+    std::generate(std::begin(rank), std::end(rank), [&]{ return m++; });
+    std::sort(std::begin(rank), std::end(rank), [&](double i1, double i2) { return scores[i1] < scores[i2]; });
+
+    if (num_threads > 1) {
+        size_t num_similar = 0;
+        double last_value = 0.0;
+        rank_scores[rank[0]] = 0.0;
+        last_value = scores[rank[0]];
+        for (size_t i = 1; i < num_threads; i++) {
+            if (last_value == scores[rank[i]])
+                num_similar++;
+            rank_scores[rank[i]] = (double) (i - num_similar);
+            last_value = scores[rank[i]];
+        }
+        if (num_similar == m - 1)
+            for (size_t i = 0; i < num_threads; i++)
+                rank_scores[i] = 1.0;
+        for (size_t i = 0; i < num_threads; i++)
+            rank_scores[i] = (double)(rank_scores[i] + 1) / (double)(m - num_similar) - 0.5;
+    } else {
+        rank_scores[0] = 1.0;
+    }
+    return rank_scores;
+}
+
+double sum(const std::vector<double> &v)
+{
+    return std::accumulate(v.begin(), v.end(), 0.0);
+}
+} // namespace
+
+TEST(fitness_shaping_test, argsort_nan_first)
+{
+    std::vector<double> scores = {3, NaN, 1, 2, NaN, 1};
+    std::vector<uint32_t> order = sc::argsort(scores);
+    std::vector<uint32_t> expected = {1, 4, 2, 5, 3, 0};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(fitness_shaping_test, fractional_ranks_ties)
+{
+    std::vector<double> scores = {10, 20, 20, 5, 20};
+    std::vector<double> ranks = sc::fractional_ranks(scores);
+    std::vector<double> expected = {1, 3, 3, 0, 3};
+    EXPECT_EQ(ranks, expected);
+}
+
+TEST(fitness_shaping_test, centered_ranks)
+{
+    std::vector<double> scores = {1, 4, 2, 3, 5};
+    std::vector<double> w = sc::centered_ranks(scores);
+    std::vector<double> expected = {-0.5, 0.25, -0.25, 0, 0.5};
+    for (size_t i = 0; i < w.size(); i++) EXPECT_DOUBLE_EQ(w[i], expected[i]);
+
+    // all ties and a single sample give no update
+    for (double x : sc::centered_ranks({7, 7, 7})) EXPECT_EQ(x, 0);
+    EXPECT_EQ(sc::centered_ranks({1}), std::vector<double>{0});
+    EXPECT_TRUE(sc::centered_ranks({}).empty());
+
+    // nan scores are the worst and tied
+    w = sc::centered_ranks({NaN, 0, NaN, -1e300});
+    EXPECT_EQ(w[0], w[2]);
+    EXPECT_LT(w[0], w[3]);
+    EXPECT_LT(w[3], w[1]);
+    EXPECT_NEAR(sum(w), 0, 1e-12);
+}
+
+TEST(fitness_shaping_test, utility_weights)
+{
+    std::mt19937 gen(3);
+    std::normal_distribution<double> dist;
+    std::vector<double> scores(100);
+    for (double &s : scores) s = dist(gen);
+
+    std::vector<double> w = sc::utility_weights(scores);
+    EXPECT_NEAR(sum(w), 0, 1e-12);
+
+    // monotonic in the score, and the bottom half all get -1/n
+    std::vector<uint32_t> order = sc::argsort(scores);
+    for (size_t i = 1; i < order.size(); i++) {
+        EXPECT_LE(w[order[i-1]], w[order[i]]);
+    }
+    EXPECT_DOUBLE_EQ(w[order[0]], -1.0 / 100);
+    EXPECT_DOUBLE_EQ(w[order[49]], -1.0 / 100);
+    EXPECT_GT(w[order[99]], w[order[98]]);
+
+    // ties share a weight
+    w = sc::utility_weights({1, 2, 2, 0});
+    EXPECT_EQ(w[1], w[2]);
+}
+
+TEST(fitness_shaping_test, dense_ranks_match_original)
+{
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 20);
+    for (size_t n : {1, 2, 3, 10, 300}) {
+        for (int trial = 0; trial < 20; trial++) {
+            std::vector<double> scores(n);
+            for (double &s : scores) s = dist(gen);
+            if (trial == 0) std::fill(scores.begin(), scores.end(), 4.0);
+
+            std::vector<double> expected = original_rank_transform(scores);
+            std::vector<double> w = sc::dense_rank_weights(scores);
+            ASSERT_EQ(w.size(), n);
+            for (size_t i = 0; i < n; i++) EXPECT_DOUBLE_EQ(w[i], expected[i]);
+        }
+    }
+}
+
+TEST(fitness_shaping_test, elite_weights)
+{
+    std::vector<double> scores = {5, 1, 9, 3, 7, NaN, 8, 2, 6, 4};
+    std::vector<double> w = sc::elite_weights(scores, 0.2);
+    std::vector<double> expected = {0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+    EXPECT_EQ(w, expected);
+
+    // 0.25 * 10 rounds up to 3 elites
+    EXPECT_EQ(sum(sc::elite_weights(scores, 0.25)), 3);
+
+    // a tie at the boundary keeps both
+    w = sc::elite_weights({1, 3, 3, 2}, 0.25);
+    expected = {0, 1, 1, 0};
+    EXPECT_EQ(w, expected);
+
+    // at least one elite
+    EXPECT_EQ(sum(sc::elite_weights({1, 2, 3}, 0)), 1);
+}
+
+TEST(fitness_shaping_test, recombination_weights)
+{
+    std::vector<double> w = sc::recombination_weights({3, 1, 4, 2, NaN, 0});
+    // mu = 3: log(3.5) - log(k) for k = 1, 2, 3
+    double w1 = std::log(3.5), w2 = std::log(3.5) - std::log(2.0);
+    double w3 = std::log(3.5) - std::log(3.0);
+    double total = w1 + w2 + w3;
+    EXPECT_NEAR(w[2], w1 / total, 1e-12);
+    EXPECT_NEAR(w[0], w2 / total, 1e-12);
+    EXPECT_NEAR(w[3], w3 / total, 1e-12);
+    EXPECT_EQ(w[1], 0);
+    EXPECT_EQ(w[4], 0);
+    EXPECT_EQ(w[5], 0);
+    EXPECT_NEAR(sum(w), 1, 1e-12);
+
+    // the best two are tied
+    w = sc::recombination_weights({5, 5, 1, 0});
+    EXPECT_DOUBLE_EQ(w[0], 0.5);
+    EXPECT_DOUBLE_EQ(w[1], 0.5);
+}
+
+TEST(fitness_shaping_test, parse)
+{
+    sc::FitnessShaping shaping;
+    EXPECT_TRUE(sc::str2fitness_shaping("utility", shaping));
+    EXPECT_EQ(shaping, sc::FitnessShaping::UTILITY);
+    EXPECT_TRUE(sc::str2fitness_shaping("elite", shaping));
+    EXPECT_EQ(sc::shape_fitness({1, 2, 3, 4, 5}, shaping, 0.4),
+              sc::elite_weights({1, 2, 3, 4, 5}, 0.4));
+    EXPECT_FALSE(sc::str2fitness_shaping("rank", shaping));
+}
@@ -0,0 +1,134 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+#include <scrimmage/math/FixedMLP.h>
+
+#include "tiny_dnn/tiny_dnn.h"
+#include "TestPolicy.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+using namespace tiny_dnn;
+using namespace tiny_dnn::layers;
+
+TEST(fixed_mlp_test, matches_tiny_dnn)
+{
+    size_t num_inputs = policy_num_inputs;
+    network<sequential> net;
+    make_policy(net, num_inputs);
+    net.perturb_weights(12345, 0.02);
+
+    sc::FixedMLP<200, 200, 50, 3> mlp;
+    ASSERT_TRUE(mlp.from_network(net));
+    ASSERT_EQ(mlp.in_data_size(), num_inputs);
+    ASSERT_EQ(mlp.out_data_size(), 3);
+
+    for (int k = 0; k < 20; k++) {
+        vec_t in = make_input(num_inputs, k);
+        vec_t expected = net.predict(in);
+        const vec_t &result = mlp.predict(in);
+        // same operations in the same order as tiny_dnn's scalar kernel
+        EXPECT_EQ(result, expected);
+    }
+}
+
+TEST(fixed_mlp_test, load)
+{
+    network<sequential> net;
+    make_policy(net, 13);
+
+    char name[] = "/tmp/test_fixed_mlp_XXXXXX";
+    close(mkstemp(name));
+    net.save(name);
+
+    sc::FixedMLP<200, 200, 50, 3> mlp;
+    ASSERT_TRUE(mlp.load(name));
+    vec_t in = make_input(13, 1);
+    vec_t expected = net.predict(in);
+    EXPECT_EQ(mlp.predict(in), expected);
+
+    // the widths don't match this type
+    sc::FixedMLP<200, 50, 3> wrong;
+    ASSERT_FALSE(wrong.from_network(net));
+    ASSERT_FALSE(wrong.loaded());
+
+    std::remove(name);
+}
+
+TEST(fixed_mlp_test, fast_math)
+{
+    size_t num_inputs = policy_num_inputs;
+    network<sequential> net;
+    make_policy(net, num_inputs);
+
+    sc::FixedMLP<200, 200, 50, 3> mlp;
+    ASSERT_TRUE(mlp.from_network(net));
+    mlp.set_fast_math(true);
+    for (int k = 0; k < 20; k++) {
+        vec_t in = make_input(num_inputs, k);
+        vec_t expected = net.predict(in);
+        const vec_t &result = mlp.predict(in);
+        for (size_t i = 0; i < expected.size(); i++) {
+            EXPECT_NEAR(result[i], expected[i], 1e-6);
+        }
+    }
+}
+
+TEST(fixed_mlp_test, predict_rows)
+{
+    size_t num_inputs = policy_num_inputs;
+    network<sequential> net;
+    make_policy(net, num_inputs);
+    net.perturb_weights(12345, 0.02);
+
+    sc::FixedMLP<200, 200, 50, 3> mlp;
+    ASSERT_TRUE(mlp.from_network(net));
+    for (bool fast_math : {false, true}) {
+        mlp.set_fast_math(fast_math);
+        for (size_t rows : {1, 5, 17}) {
+            vec_t in;
+            for (size_t r = 0; r < rows; r++) {
+                vec_t row = make_input(num_inputs, r);
+                in.insert(in.end(), row.begin(), row.end());
+            }
+            vec_t result = mlp.predict_rows(in.data(), rows);
+            ASSERT_EQ(result.size(), rows * 3);
+            for (size_t r = 0; r < rows; r++) {
+                const vec_t &expected = mlp.predict(&in[r * num_inputs]);
+                vec_t row(result.begin() + r * 3, result.begin() + (r + 1) * 3);
+                EXPECT_EQ(row, expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <memory>
+#include <string>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <scrimmage/log/FrameReader.h>
+#include <scrimmage/proto/Frame.pb.h>
+
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/io/coded_stream.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+namespace sp = scrimmage_proto;
+
+// Writes num_frames length-delimited frames the same way Log::save_frame does
+std::string write_frames(int num_frames, double dt, bool truncate = false)
+{
+    char name[] = "/tmp/test_frame_reader_XXXXXX";
+    int fd = mkstemp(name);
+    {
+        google::protobuf::io::FileOutputStream out(fd);
+        for (int i = 0; i < num_frames; i++) {
+            sp::Frame frame;
+            frame.set_time(i * dt);
+            for (int j = 0; j <= i % 3; j++) {
+                sp::Contact *c = frame.add_contact();
+                c->mutable_id()->set_id(j + 1);
+                c->mutable_id()->set_team_id(1);
+                c->mutable_state()->mutable_position()->set_x(i + j);
+            }
+            google::protobuf::io::CodedOutputStream coded(&out);
+            coded.WriteVarint32(frame.ByteSizeLong());
+            frame.SerializeWithCachedSizes(&coded);
+        }
+    }
+    if (truncate) {
+        off_t end = lseek(fd, 0, SEEK_END);
+        EXPECT_EQ(ftruncate(fd, end - 3), 0);
+    }
+    ::close(fd);
+    return std::string(name);
+}
+
+void remove_frames(std::string filename)
+{
+    std::remove(filename.c_str());
+    std::remove((filename + ".idx").c_str());
+}
+
+TEST(frame_reader_test, index_and_read)
+{
+    std::string filename = write_frames(100, 0.1);
+
+    sc::FrameReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.size(), 100);
+    ASSERT_TRUE(reader.clean_eof());
+
+    for (size_t i = 0; i < reader.size(); i++) {
+        ASSERT_DOUBLE_EQ(reader.time(i), i * 0.1);
+    }
+
+    // random access, out of order
+    for (size_t i : {57, 3, 99, 0, 42}) {
+        std::shared_ptr<sp::Frame> frame = reader.read(i);
+        ASSERT_NE(frame, nullptr);
+        ASSERT_DOUBLE_EQ(frame->time(), i * 0.1);
+        ASSERT_EQ(frame->contact_size(), static_cast<int>(i % 3 + 1));
+        ASSERT_DOUBLE_EQ(frame->contact(0).state().position().x(), i);
+    }
+    ASSERT_EQ(reader.read(100), nullptr);
+
+    ASSERT_EQ(reader.find(-1), 0);
+    ASSERT_EQ(reader.find(0), 0);
+    ASSERT_EQ(reader.find(2.05), 21);
+    ASSERT_EQ(reader.find(100), reader.size());
+
+    remove_frames(filename);
+}
+
+TEST(frame_reader_test, index_file)
+{
+    std::string filename = write_frames(20, 0.5);
+
+    sc::FrameReader reader;
+    ASSERT_TRUE(reader.open(filename));
+    reader.close();
+
+    // The sidecar index is reused on the second open
+    FILE *fp = fopen(reader.index_filename().c_str(), "rb");
+    ASSERT_NE(fp, nullptr);
+    fclose(fp);
+
+    ASSERT_TRUE(reader.open(filename));
+    ASSERT_EQ(reader.size(), 20);
+    ASSERT_DOUBLE_EQ(reader.time(19), 9.5);
+    ASSERT_DOUBLE_EQ(reader.read(19)->time(), 9.5);
+
+    remove_frames(filename);
+}
+
+TEST(frame_reader_test, truncated)
+{
+    std::string filename = write_frames(10, 1.0, true);
+
+    sc::FrameReader reader;
+    ASSERT_TRUE(reader.open(filename, false));
+    ASSERT_EQ(reader.size(), 9);
+    ASSERT_FALSE(reader.clean_eof());
+
+    remove_frames(filename);
+}
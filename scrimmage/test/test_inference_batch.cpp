@@ -0,0 +1,88 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <vector>
+
+#include <scrimmage/math/FixedMLP.h>
+#include <scrimmage/simcontrol/InferenceBatch.h>
+
+#include "tiny_dnn/tiny_dnn.h"
+#include "TestPolicy.h"
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+using namespace tiny_dnn;
+
+typedef sc::FixedMLP<200, 200, 50, 3> Policy;
+
+TEST(inference_batch_test, rows_reach_their_callbacks)
+{
+    network<sequential> net_a, net_b;
+    make_policy(net_a, policy_num_inputs);
+    make_policy(net_b, policy_num_inputs);
+    net_b.perturb_weights(1, 0.1);
+
+    Policy a, b;
+    ASSERT_TRUE(a.from_network(net_a));
+    ASSERT_TRUE(b.from_network(net_b));
+    // copies share the weights and so the queue
+    Policy a_copy = a;
+    ASSERT_EQ(a_copy.weights(), a.weights());
+    ASSERT_NE(a.weights(), b.weights());
+
+    sc::InferenceBatch batch;
+    ASSERT_EQ(&batch.queue(a), &batch.queue(a_copy));
+    ASSERT_NE(&batch.queue(a), &batch.queue(b));
+
+    std::vector<vec_t> inputs;
+    std::vector<vec_t> expected;
+    std::vector<vec_t> results(6);
+    for (int k = 0; k < 6; k++) {
+        inputs.push_back(make_input(policy_num_inputs, k));
+        Policy &policy = k % 3 == 2 ? b : (k % 3 == 1 ? a_copy : a);
+        expected.push_back(policy.predict(inputs.back()));
+        batch.queue(policy).add(inputs.back().data(),
+                                [&results, k](const vec_t &out) { results[k] = out; });
+    }
+
+    // nothing runs until run()
+    for (const vec_t &result : results) {
+        EXPECT_TRUE(result.empty());
+    }
+    batch.run();
+    for (int k = 0; k < 6; k++) {
+        EXPECT_EQ(results[k], expected[k]);
+    }
+
+    // the queues are empty again
+    results.assign(6, vec_t());
+    batch.run();
+    for (const vec_t &result : results) {
+        EXPECT_TRUE(result.empty());
+    }
+}
@@ -0,0 +1,97 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <set>
+#include <string>
+
+#include <scrimmage/plugin_manager/Plugin.h>
+#include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/pubsub/Subscriber.h>
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+TEST(loop_rate_test, loop_due)
+{
+    sc::Plugin plugin;
+    EXPECT_EQ(plugin.loop_rate(), 0);
+    EXPECT_EQ(plugin.loop_period(), 1);
+    for (unsigned int step = 0; step < 10; step++) {
+        EXPECT_TRUE(plugin.loop_due(step));
+    }
+
+    plugin.set_loop_rate(2);
+    plugin.set_loop_period(5);
+    int steps = 0;
+    for (unsigned int step = 0; step < 100; step++) {
+        if (plugin.loop_due(step)) {
+            EXPECT_EQ(step % 5, 0);
+            steps++;
+        }
+    }
+    EXPECT_EQ(steps, 20);
+
+    // a full period between due steps, less on a final step in between
+    EXPECT_EQ(plugin.loop_steps(0), 5);
+    EXPECT_EQ(plugin.loop_steps(10), 5);
+    EXPECT_EQ(plugin.loop_steps(13), 3);
+    plugin.set_loop_period(1);
+    EXPECT_EQ(plugin.loop_steps(13), 1);
+}
+
+TEST(loop_rate_test, held_messages)
+{
+    auto network = std::make_shared<sc::Network>();
+    std::string topic = "Topic";
+
+    sc::PublisherPtr pub = std::make_shared<sc::Publisher>();
+    network->add_publisher(1, pub, topic);
+    sc::SubscriberPtr fast = std::make_shared<sc::Subscriber>();
+    network->add_subscriber(2, fast, topic);
+    sc::SubscriberPtr slow = std::make_shared<sc::Subscriber>();
+    network->add_subscriber(3, slow, topic);
+
+    for (int step = 0; step < 3; step++) {
+        // the slow plugin hasn't stepped since the last delivery
+        std::set<int> held_ids;
+        if (step > 0) held_ids.insert(3);
+        network->clear_subscriber_msgs(held_ids);
+
+        pub->publish(std::make_shared<sc::Message<int>>());
+        network->distribute();
+        EXPECT_EQ(fast->msg_list().size(), 1);
+        EXPECT_EQ(slow->msg_list().size(), step + 1);
+    }
+
+    network->clear_subscriber_msgs();
+    EXPECT_TRUE(fast->msg_list().empty());
+    EXPECT_TRUE(slow->msg_list().empty());
+}
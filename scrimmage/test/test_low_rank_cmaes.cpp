@@ -0,0 +1,135 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cmath>
+#include <vector>
+
+#include <scrimmage/common/Checkpoint.h>
+#include <scrimmage/common/FitnessShaping.h>
+#include <scrimmage/math/LowRankCMAES.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+using vec_t = sc::LowRankCMAES::vec_t;
+
+// A narrow valley: steep in every direction except along (1, ..., 1)
+double cost(const vec_t &x)
+{
+    double sum = 0, sum_sq = 0;
+    for (float v : x) {
+        sum += v;
+        sum_sq += v * v;
+    }
+    return 1e3 * sum_sq - (1e3 - 1) * sum * sum / x.size();
+}
+
+vec_t start(size_t n)
+{
+    vec_t x(n);
+    for (size_t i = 0; i < n; i++) x[i] = 1 + 0.1 * std::sin(i);
+    return x;
+}
+
+// Runs the strategy from start() and returns the final cost
+double minimize(size_t n, size_t lambda, size_t rank, int generations)
+{
+    sc::LowRankCMAES cma;
+    cma.init(n, lambda, rank, 0.1);
+    vec_t mean = start(n);
+
+    std::vector<int32_t> seeds(lambda);
+    std::vector<double> scores(lambda);
+    int32_t seed = 1;
+    for (int g = 0; g < generations; g++) {
+        for (size_t k = 0; k < lambda; k++) {
+            seeds[k] = seed++;
+            vec_t x = mean;
+            cma.sample(seeds[k], x);
+            scores[k] = -cost(x);
+        }
+        cma.update(mean, seeds, sc::recombination_weights(scores));
+    }
+    return cost(mean);
+}
+
+TEST(low_rank_cmaes_test, sample_is_deterministic)
+{
+    sc::LowRankCMAES cma;
+    cma.init(1000, 10, 3, 0.5);
+
+    vec_t a(1000, 1.0), b(1000, 1.0), c(1000, 1.0);
+    cma.sample(42, a);
+    cma.sample(42, b);
+    cma.sample(43, c);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+
+    // before any update the samples are isotropic with variance sigma^2
+    double var = 0;
+    for (float x : a) var += (x - 1) * (x - 1);
+    EXPECT_NEAR(var / a.size(), 0.25, 0.03);
+}
+
+TEST(low_rank_cmaes_test, minimizes_quadratic)
+{
+    double initial = cost(start(100));
+    double separable = minimize(100, 16, 0, 1000);
+    double low_rank = minimize(100, 16, 10, 1000);
+    EXPECT_LT(separable, initial);
+    // the evolution paths stretch the samples along the valley
+    EXPECT_LT(low_rank, 0.25 * separable);
+}
+
+TEST(low_rank_cmaes_test, checkpoint)
+{
+    sc::LowRankCMAES cma;
+    cma.init(50, 8, 2, 0.3);
+    vec_t mean(50, 0.5);
+    for (int g = 0; g < 5; g++) {
+        std::vector<int32_t> seeds = {g * 10 + 1, g * 10 + 2, g * 10 + 3, g * 10 + 4};
+        std::vector<double> scores = {1.0 * g, 2.0, 0.5, -1.0};
+        cma.update(mean, seeds, sc::recombination_weights(scores));
+    }
+
+    sc::Checkpoint ckpt;
+    cma.save(ckpt);
+    sc::Checkpoint copy;
+    ASSERT_TRUE(copy.deserialize(ckpt.serialize()));
+
+    sc::LowRankCMAES restored;
+    ASSERT_TRUE(restored.load(copy));
+    EXPECT_EQ(restored.sigma(), cma.sigma());
+    EXPECT_EQ(restored.generation(), cma.generation());
+    EXPECT_EQ(restored.rank(), 2);
+
+    vec_t a = mean, b = mean;
+    cma.sample(7, a);
+    restored.sample(7, b);
+    EXPECT_EQ(a, b);
+}
@@ -0,0 +1,77 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/proto/Visual.pb.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+
+TEST(mission_parse_test, clone)
+{
+    char name[] = "/tmp/test_mission_parse_XXXXXX";
+    close(mkstemp(name));
+    std::string mission_file(name);
+    std::ofstream(mission_file)
+        << "<?xml version=\"1.0\"?>\n"
+        << "<runscript name=\"clone\">\n"
+        << "  <run start=\"0.0\" end=\"50\" dt=\"0.1\" time_warp=\"0\"/>\n"
+        << "  <grid_spacing>10</grid_spacing>\n"
+        << "  <seed>7</seed>\n"
+        << "</runscript>\n";
+
+    sc::MissionParsePtr mp = std::make_shared<sc::MissionParse>();
+    ASSERT_TRUE(mp->parse(mission_file));
+    std::remove(mission_file.c_str());
+
+    sc::MissionParsePtr copy = mp->clone();
+    EXPECT_DOUBLE_EQ(copy->tend(), 50);
+    EXPECT_DOUBLE_EQ(copy->dt(), 0.1);
+    EXPECT_EQ(copy->params()["seed"], "7");
+
+    // the copy is independent of the original, apart from the projection
+    copy->params()["seed"] = "8";
+    EXPECT_EQ(mp->params()["seed"], "7");
+
+    ASSERT_TRUE(copy->utm_terrain() != nullptr);
+    EXPECT_NE(copy->utm_terrain(), mp->utm_terrain());
+    EXPECT_DOUBLE_EQ(copy->utm_terrain()->grid_spacing(), 10);
+    copy->utm_terrain()->set_time(3);
+    EXPECT_DOUBLE_EQ(mp->utm_terrain()->time(), 0);
+
+    EXPECT_EQ(copy->projection(), mp->projection());
+}
@@ -0,0 +1,175 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <scrimmage/common/OpponentPool.h>
+#include <scrimmage/common/Random.h>
+#include <scrimmage/math/FixedMLP.h>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+using namespace tiny_dnn;
+using namespace tiny_dnn::layers;
+
+typedef sc::FixedMLP<200, 200, 50, 3> Policy;
+
+class OpponentPoolTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        for (int i = 0; i < 4; i++) {
+            network<sequential> net;
+            net << fc(13, 200) << activation::tanh()
+                << fc(200, 200) << activation::tanh()
+                << fc(200, 50) << activation::tanh()
+                << fc(50, 3) << activation::tanh();
+            net.weight_init(weight_init::lecun());
+            net.bias_init(weight_init::lecun());
+            net.init_weight();
+            net.perturb_weights(100 + i, 0.1);
+
+            char name[] = "/tmp/test_opponent_pool_XXXXXX";
+            close(mkstemp(name));
+            net.save(name);
+            paths.push_back(name);
+        }
+    }
+
+    void TearDown() override {
+        for (std::string &path : paths) std::remove(path.c_str());
+    }
+
+    std::vector<std::string> paths;
+};
+
+TEST_F(OpponentPoolTest, oldest_is_dropped)
+{
+    sc::OpponentPool pool(3);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(pool.add(i - 1, paths[i]) != nullptr);
+    }
+    ASSERT_EQ(pool.size(), 3);
+    EXPECT_EQ(pool.find(-1), nullptr);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NE(pool.find(i), nullptr);
+        EXPECT_EQ(pool.opponents()[i]->id(), i);
+    }
+
+    EXPECT_EQ(pool.add(7, "/nonexistent/nn.dat"), nullptr);
+    EXPECT_EQ(pool.size(), 3);
+}
+
+TEST_F(OpponentPoolTest, record)
+{
+    sc::Opponent opponent(0, paths[0]);
+    EXPECT_DOUBLE_EQ(opponent.win_rate(), 0.5);
+
+    opponent.record(3, 1);
+    opponent.record(1, 3);
+    opponent.record(2, 2);
+    opponent.record(5, 0);
+    EXPECT_EQ(opponent.games(), 4);
+    EXPECT_EQ(opponent.wins(), 2);
+    EXPECT_EQ(opponent.losses(), 1);
+    EXPECT_EQ(opponent.draws(), 1);
+    EXPECT_DOUBLE_EQ(opponent.win_rate(), 2.5 / 4);
+    EXPECT_DOUBLE_EQ(opponent.avg_score(), 11.0 / 4);
+}
+
+TEST_F(OpponentPoolTest, sample)
+{
+    sc::Random random;
+    random.seed(1);
+
+    sc::OpponentPool uniform(2);
+    sc::OpponentPool prioritized(2, 2.0);
+    for (sc::OpponentPool *pool : {&uniform, &prioritized}) {
+        pool->add(0, paths[0]);
+        pool->add(1, paths[1]);
+        // the learner beats opponent 0 90% of the time, opponent 1 half
+        pool->find(0)->set_stats(9, 1, 0, 0);
+        pool->find(1)->set_stats(5, 5, 0, 0);
+    }
+
+    int n = 10000;
+    int uniform_count = 0, prioritized_count = 0;
+    for (int i = 0; i < n; i++) {
+        if (uniform.sample(random)->id() == 1) uniform_count++;
+        if (prioritized.sample(random)->id() == 1) prioritized_count++;
+    }
+    EXPECT_NEAR(uniform_count / static_cast<double>(n), 0.5, 0.03);
+    // weights 0.1^2 and 0.5^2
+    EXPECT_NEAR(prioritized_count / static_cast<double>(n), 0.25 / 0.26, 0.03);
+}
+
+TEST_F(OpponentPoolTest, compiled_policy_is_shared)
+{
+    sc::OpponentPool pool(1);
+    sc::OpponentPtr opponent = pool.add(0, paths[0]);
+    ASSERT_NE(opponent, nullptr);
+
+    std::vector<std::shared_ptr<const Policy>> policies(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < policies.size(); i++) {
+        threads.emplace_back([&, i]() { policies[i] = opponent->compiled<Policy>(); });
+    }
+    for (std::thread &t : threads) t.join();
+
+    ASSERT_NE(policies[0], nullptr);
+    for (auto &policy : policies) EXPECT_EQ(policy, policies[0]);
+
+    // copies share the weights but predict independently
+    network<sequential> net;
+    net.load(paths[0]);
+    Policy a = *policies[0];
+    Policy b = *policies[0];
+    vec_t in(13), in2(13);
+    for (size_t i = 0; i < in.size(); i++) {
+        in[i] = std::sin(0.3 * i);
+        in2[i] = std::cos(0.7 * i);
+    }
+    vec_t expected = net.predict(in);
+    vec_t expected2 = net.predict(in2);
+    const vec_t &out = a.predict(in);
+    const vec_t &out2 = b.predict(in2);
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_NEAR(out[i], expected[i], 1e-6);
+        EXPECT_NEAR(out2[i], expected2[i], 1e-6);
+    }
+
+    // a topology that doesn't match isn't converted
+    EXPECT_EQ((opponent->compiled<sc::FixedMLP<10, 3>>()), nullptr);
+}
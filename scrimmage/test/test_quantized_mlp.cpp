@@ -0,0 +1,108 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cmath>
+#include <string>
+
+#include <scrimmage/math/FixedMLP.h>
+#include <scrimmage/math/QuantizedMLP.h>
+
+#include "tiny_dnn/tiny_dnn.h"
+#include "TestPolicy.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+using namespace tiny_dnn;
+using namespace tiny_dnn::layers;
+
+namespace {
+sc::QuantizationReport evaluate(sc::MLPPrecision precision)
+{
+    size_t num_inputs = policy_num_inputs;
+    network<sequential> net;
+    make_policy(net, num_inputs);
+    net.perturb_weights(12345, 0.02);
+
+    sc::FixedMLP<200, 200, 50, 3> reference;
+    sc::QuantizedMLP<200, 200, 50, 3> quantized;
+    EXPECT_TRUE(reference.from_network(net));
+    EXPECT_TRUE(quantized.from_network(net, precision));
+    EXPECT_EQ(quantized.in_data_size(), num_inputs);
+    EXPECT_EQ(quantized.out_data_size(), 3);
+
+    sc::QuantizationReport report;
+    for (int k = 0; k < 50; k++) {
+        vec_t in = make_input(num_inputs, k);
+        report.add(reference.predict(in), quantized.predict(in));
+    }
+    return report;
+}
+} // namespace
+
+TEST(quantized_mlp_test, bf16_close_to_float)
+{
+    sc::QuantizationReport report = evaluate(sc::MLPPrecision::BF16);
+    EXPECT_EQ(report.samples(), 50);
+    EXPECT_GT(report.max_abs_error(), 0);
+    EXPECT_LT(report.max_abs_error(), 0.01);
+    EXPECT_LT(report.mean_abs_error(), 0.002);
+}
+
+TEST(quantized_mlp_test, int8_close_to_float)
+{
+    sc::QuantizationReport report = evaluate(sc::MLPPrecision::INT8);
+    EXPECT_EQ(report.samples(), 50);
+    EXPECT_LT(report.max_abs_error(), 0.02);
+    EXPECT_LT(report.mean_abs_error(), 0.005);
+}
+
+TEST(quantized_mlp_test, rejects_float32_and_wrong_topology)
+{
+    network<sequential> net;
+    make_policy(net, 10);
+
+    sc::QuantizedMLP<200, 200, 50, 3> mlp;
+    EXPECT_FALSE(mlp.from_network(net, sc::MLPPrecision::FLOAT32));
+    EXPECT_FALSE(mlp.loaded());
+
+    sc::QuantizedMLP<200, 50, 3> wrong;
+    EXPECT_FALSE(wrong.from_network(net, sc::MLPPrecision::INT8));
+}
+
+TEST(quantized_mlp_test, parse_precision)
+{
+    sc::MLPPrecision p;
+    EXPECT_TRUE(sc::str2precision("int8", p));
+    EXPECT_EQ(p, sc::MLPPrecision::INT8);
+    EXPECT_TRUE(sc::str2precision("bf16", p));
+    EXPECT_EQ(p, sc::MLPPrecision::BF16);
+    EXPECT_TRUE(sc::str2precision("none", p));
+    EXPECT_EQ(p, sc::MLPPrecision::FLOAT32);
+    EXPECT_FALSE(sc::str2precision("fp8", p));
+}
@@ -0,0 +1,147 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <scrimmage/autonomy/Autonomy.h>
+#include <scrimmage/common/Arena.h>
+#include <scrimmage/metrics/Metrics.h>
+#include <scrimmage/motion/MotionModel.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/plugin_manager/Plugin.h>
+#include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/pubsub/Subscriber.h>
+#include <scrimmage/simcontrol/EntityInteraction.h>
+
+#include "TestMission.h"
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+TEST(reset_test, unsupported_by_default)
+{
+    std::map<std::string, std::string> info, params;
+    EXPECT_FALSE(sc::Autonomy().reset(params));
+    EXPECT_FALSE(sc::MotionModel().reset(info, params));
+    EXPECT_FALSE(sc::Metrics().reset(params));
+    EXPECT_FALSE(sc::EntityInteraction().reset(info, params));
+}
+
+TEST(reset_test, stop_networking)
+{
+    auto network = std::make_shared<sc::Network>();
+    auto plugin = std::make_shared<sc::Autonomy>();
+    plugin->set_network(network);
+    sc::PublisherPtr pub = plugin->create_publisher("Topic");
+    sc::SubscriberPtr sub = plugin->create_subscriber("Topic");
+    plugin->create_subscriber("Other");
+
+    auto other = std::make_shared<sc::Autonomy>();
+    other->set_network(network);
+    sc::SubscriberPtr other_sub = other->create_subscriber("Topic");
+
+    sub->msg_list().push_back(std::make_shared<sc::Message<int>>());
+    plugin->stop_networking();
+
+    EXPECT_TRUE(plugin->pubs().empty());
+    EXPECT_TRUE(plugin->subs().empty());
+    EXPECT_TRUE(sub->msg_list().empty());
+
+    // only the other plugin is left on the network
+    auto &sub_map = network->sub_map();
+    ASSERT_EQ(sub_map.size(), 1);
+    ASSERT_EQ(sub_map["Topic"].size(), 1);
+    EXPECT_EQ(sub_map["Topic"].begin()->second.front(), other_sub);
+}
+
+TEST(reset_test, clear_publisher_msgs)
+{
+    auto network = std::make_shared<sc::Network>();
+    auto plugin = std::make_shared<sc::Autonomy>();
+    plugin->set_network(network);
+    sc::PublisherPtr pub = plugin->create_publisher("Topic");
+
+    plugin->publish(0, pub, std::make_shared<sc::Message<int>>());
+    ASSERT_EQ(pub->msg_list().size(), 1);
+
+    network->clear_publisher_msgs();
+    EXPECT_TRUE(pub->msg_list().empty());
+}
+
+TEST(reset_test, arena_per_rollout)
+{
+    std::string mission_file = write_test_mission();
+    auto parse = [&]() {
+        auto mission = std::make_shared<sc::MissionParse>();
+        mission->parse(mission_file);
+        mission->params()["recycle_entities"] = "true";
+        return mission;
+    };
+
+    // reset() runs on this thread, the rollouts on the simulation's thread
+    TestEnv env;
+    ASSERT_TRUE(env.init(parse(), 1));
+
+    // holds the last messages of each rollout until reset() clears them
+    auto plugin = std::make_shared<sc::Plugin>();
+    plugin->set_network(env.sim.network());
+    sc::SubscriberPtr sub = plugin->create_subscriber("EntityPresentAtEnd");
+
+    std::vector<size_t> reserved;
+    sc::ArenaPtr last;
+    for (int i = 0; i < 4; i++) {
+        if (i > 0) {
+            env.sim.set_mission_parse(parse());
+            ASSERT_TRUE(env.sim.reset());
+            ASSERT_NE(env.sim.network()->arena(), last);
+
+            // reset() freed the blocks of the last rollout as their owner,
+            // and nothing else holds on to its arena
+            EXPECT_EQ(last->bytes_in_use(), 0);
+            std::weak_ptr<sc::Arena> weak = last;
+            last = nullptr;
+            EXPECT_TRUE(weak.expired());
+        }
+        env.sim.start();
+        env.sim.join();
+        EXPECT_FALSE(sub->msg_list().empty());
+
+        last = env.sim.network()->arena();
+        reserved.push_back(last->bytes_reserved());
+        EXPECT_GT(reserved.back(), 0);
+        EXPECT_LE(reserved.back(), 2 * reserved.front());
+    }
+    std::remove(mission_file.c_str());
+}
@@ -26,6 +26,8 @@
 /// A long description.
 /// ---------------------------------------------------------------------------
 #include <iostream>
+#include <functional>
+#include <thread>
 
 #include <list>
 #include <limits.h>
@@ -197,3 +199,100 @@ TEST(rtree_test, nearest_n_neighbors_minus_self)
     ASSERT_EQ(rtree_neighbors.size(), num_neighbors);
 }
          
+
+TEST(rtree_test, batched_nearest_neighbors)
+{
+    unsigned int k = 5;
+    for (int num_contacts : {40, 1500}) {
+        sc::Random rand;
+        rand.seed(num_contacts);
+
+        sc::RTree rtree;
+        rtree.init(num_contacts);
+        rtree.request_neighbors(k);
+        rtree.request_neighbors(k, false);
+        // a runner with a thread per job, SimControl uses its worker pool
+        size_t num_jobs = 0;
+        rtree.set_job_runner([&num_jobs](std::vector<std::function<void()>> &jobs) {
+                num_jobs += jobs.size();
+                std::vector<std::thread> threads;
+                for (std::function<void()> &job : jobs) threads.emplace_back(job);
+                for (std::thread &thread : threads) thread.join();
+            }, 4);
+
+        std::vector<Eigen::Vector3d> positions(num_contacts);
+        std::vector<sc::ID> ids(num_contacts);
+        for (int i = 0; i < num_contacts; i++) {
+            positions[i] << rand.rng_uniform() * 1000, rand.rng_uniform() * 1000,
+                rand.rng_uniform() * 100;
+            ids[i] = sc::ID(i, 0, i % 3 == 0 ? 1 : 2);
+            rtree.add(positions[i], ids[i]);
+        }
+        rtree.compute_neighbors();
+        // small batches stay in the calling thread
+        EXPECT_EQ(num_jobs, num_contacts < 128 ? 0u : 4u);
+
+        for (int i = 0; i < num_contacts; i++) {
+            for (int team_id : {-1, 1, 2}) {
+                sc::IDSlice neighbors;
+                ASSERT_TRUE(rtree.nearest_neighbors(i, k, neighbors, team_id));
+
+                std::vector<sc::ID> expected;
+                rtree.nearest_n_neighbors(positions[i], expected, k, i, team_id);
+
+                // the tree query doesn't order its results
+                auto dist = [&](const sc::ID &id) {return (positions[id.id()] - positions[i]).norm();};
+                std::sort(expected.begin(), expected.end(),
+                          [&](const sc::ID &a, const sc::ID &b) {return dist(a) < dist(b);});
+                expected.resize(std::min<size_t>(expected.size(), k));
+
+                ASSERT_EQ(neighbors.size(), expected.size());
+                for (size_t j = 0; j < expected.size(); j++) {
+                    EXPECT_NE(neighbors[j].id(), i);
+                    if (team_id != -1) {
+                        EXPECT_EQ(neighbors[j].team_id(), team_id);
+                    }
+                    // nearest first
+                    EXPECT_NEAR((positions[neighbors[j].id()] - positions[i]).norm(),
+                                (positions[expected[j].id()] - positions[i]).norm(), 1e-9);
+                }
+            }
+        }
+    }
+}
+
+TEST(rtree_test, batched_nearest_neighbors_fallback)
+{
+    sc::RTree rtree;
+    rtree.init(10);
+    std::vector<Eigen::Vector3d> positions = {{0, 0, 0}, {1, 0, 0}, {3, 0, 0}};
+    std::vector<sc::ID> ids = {{0, 0, 1}, {1, 0, 1}, {2, 0, 2}};
+    for (size_t i = 0; i < ids.size(); i++) rtree.add(positions[i], ids[i]);
+
+    // nothing was requested, so only the tree query answers
+    sc::IDSlice neighbors;
+    rtree.compute_neighbors();
+    EXPECT_FALSE(rtree.nearest_neighbors(0, 1, neighbors));
+
+    std::vector<sc::ID> storage;
+    neighbors = rtree.nearest_neighbors(positions[0], 0, 2, storage);
+    ASSERT_EQ(neighbors.size(), 2u);
+    EXPECT_EQ(neighbors[0].id(), 1);
+    EXPECT_EQ(neighbors[1].id(), 2);
+
+    // computed once requested, for at most k neighbors
+    rtree.request_neighbors(2);
+    rtree.compute_neighbors();
+    ASSERT_TRUE(rtree.nearest_neighbors(0, 2, neighbors, 2));
+    ASSERT_EQ(neighbors.size(), 1u);
+    EXPECT_EQ(neighbors.front().id(), 2);
+    EXPECT_TRUE(rtree.nearest_neighbors(2, 2, neighbors, 3));
+    EXPECT_TRUE(neighbors.empty());
+    EXPECT_FALSE(rtree.nearest_neighbors(0, 3, neighbors, 2));
+    // only per team neighbors were requested
+    EXPECT_FALSE(rtree.nearest_neighbors(0, 1, neighbors));
+
+    // stale after the tree is cleared
+    rtree.clear();
+    EXPECT_FALSE(rtree.nearest_neighbors(0, 1, neighbors));
+}
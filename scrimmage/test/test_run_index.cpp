@@ -0,0 +1,140 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <fstream>
+#include <string>
+#include <map>
+
+#include <scrimmage/log/RunIndex.h>
+
+#include <boost/filesystem.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+namespace fs = boost::filesystem;
+
+void write_summary(fs::path dir, std::map<int, double> scores)
+{
+    fs::create_directories(dir);
+    std::ofstream file((dir / "summary.csv").string());
+    file << "team_id,score" << std::endl;
+    for (auto &kv : scores) {
+        file << kv.first << "," << kv.second << std::endl;
+    }
+}
+
+TEST(run_index_test, outcome)
+{
+    std::map<int, double> scores = {{1, 10}, {2, 5}};
+    ASSERT_EQ(sc::RunIndex::outcome(scores), "team_1");
+
+    scores = {{1, 3}, {2, 3}, {3, 1}};
+    ASSERT_EQ(sc::RunIndex::outcome(scores), "draw_1_2");
+
+    scores.clear();
+    ASSERT_EQ(sc::RunIndex::outcome(scores), "");
+}
+
+TEST(run_index_test, incremental_update)
+{
+    fs::path root = fs::temp_directory_path() / fs::unique_path();
+    for (int i = 0; i < 20; i++) {
+        write_summary(root / ("gen_" + std::to_string(i / 5)) / ("job_" + std::to_string(i)),
+                      {{1, static_cast<double>(i % 3)}, {2, 1}});
+    }
+    fs::path aggregate = root / "aggregate";
+    write_summary(aggregate / "ignored", {{1, 1}});
+
+    sc::RunIndex index;
+    ASSERT_EQ(index.update(root.string(), 4, aggregate.string()), 20);
+    ASSERT_EQ(index.runs().size(), 20);
+
+    auto outcomes = index.outcomes();
+    ASSERT_EQ(outcomes["team_2"].size(), 7);
+    ASSERT_EQ(outcomes["draw_1_2"].size(), 7);
+    ASSERT_EQ(outcomes["team_1"].size(), 6);
+
+    std::string index_file = (aggregate / "runs.csv").string();
+    ASSERT_TRUE(index.save(index_file));
+
+    // Only new runs are parsed on the next update
+    write_summary(root / "gen_4" / "job_20", {{1, 5}, {2, 1}});
+    fs::remove_all(root / "gen_0" / "job_0");
+
+    sc::RunIndex index2;
+    ASSERT_TRUE(index2.load(index_file));
+    ASSERT_EQ(index2.runs().size(), 20);
+    for (auto &kv : index.runs()) {
+        sc::RunIndex::Run &run = index2.runs()[kv.first];
+        ASSERT_EQ(run.outcome, kv.second.outcome);
+        ASSERT_EQ(run.mtime_ns, kv.second.mtime_ns);
+        ASSERT_EQ(run.size, kv.second.size);
+        ASSERT_EQ(run.team_scores, kv.second.team_scores);
+    }
+    ASSERT_EQ(index2.update(root.string(), 4, aggregate.string()), 1);
+    ASSERT_EQ(index2.runs().size(), 20);
+    ASSERT_EQ(index2.outcomes()["team_1"].size(), 7);
+
+    fs::remove_all(root);
+}
+
+TEST(run_index_test, cached_runs)
+{
+    fs::path root = fs::temp_directory_path() / fs::unique_path();
+    write_summary(root / "job_0", {{1, 2}, {2, 1}});
+    write_summary(root / "job_1", {});
+
+    // A symlink back up the tree isn't followed
+    fs::create_directory_symlink(root, root / "loop");
+
+    std::string index_file = (root / "runs.csv").string();
+    sc::RunIndex index;
+    ASSERT_EQ(index.update(root.string(), 2), 2);
+    ASSERT_EQ(index.runs().size(), 2);
+    ASSERT_EQ(index.outcomes().size(), 1);
+    ASSERT_TRUE(index.save(index_file));
+
+    // The run without a winner is cached as well
+    sc::RunIndex index2;
+    ASSERT_TRUE(index2.load(index_file));
+    ASSERT_EQ(index2.update(root.string(), 2), 0);
+    ASSERT_EQ(index2.runs()[(root / "job_1").string()].outcome, "");
+
+    // Rewritten within the same second as it was indexed
+    write_summary(root / "job_0", {{1, 2}, {2, 10}});
+    ASSERT_EQ(index2.update(root.string(), 2), 1);
+    ASSERT_EQ(index2.outcomes()["team_2"].size(), 1);
+
+    // Indexes in another format are ignored
+    std::ofstream(index_file) << "team_1,0,1:1,/tmp/run" << std::endl;
+    ASSERT_FALSE(index2.load(index_file));
+    ASSERT_EQ(index2.runs().size(), 0);
+
+    fs::remove_all(root);
+}
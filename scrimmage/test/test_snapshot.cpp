@@ -0,0 +1,190 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <scrimmage/autonomy/Autonomy.h>
+#include <scrimmage/common/PID.h>
+#include <scrimmage/math/State.h>
+#include <scrimmage/motion/MotionModel.h>
+#include <scrimmage/parse/MissionParse.h>
+#include <scrimmage/pubsub/Message.h>
+#include <scrimmage/pubsub/Network.h>
+#include <scrimmage/pubsub/Publisher.h>
+#include <scrimmage/pubsub/Subscriber.h>
+#include <scrimmage/simcontrol/SimControl.h>
+#include <scrimmage/simcontrol/Snapshot.h>
+
+#include "TestMission.h"
+
+#include <gtest/gtest.h>
+
+namespace sc = scrimmage;
+
+namespace {
+class TestModel : public sc::MotionModel {
+ public:
+    sc::MotionModel::vector_t &x() { return x_; }
+};
+} // namespace
+
+TEST(snapshot_test, state)
+{
+    sc::State state;
+    state.pos() << 1.5, -2, 3e-9;
+    state.vel() << 20, 0.1, -0.3;
+    state.quat().set(0.1, -0.2, 2.5);
+
+    sc::Snapshot snapshot;
+    snapshot.set("state", state);
+
+    sc::State restored;
+    ASSERT_TRUE(snapshot.get("state", restored));
+    EXPECT_EQ(restored.pos(), state.pos());
+    EXPECT_EQ(restored.vel(), state.vel());
+    EXPECT_EQ(restored.quat().coeffs(), state.quat().coeffs());
+    EXPECT_EQ(restored.yaw(), state.yaw());
+    EXPECT_FALSE(snapshot.get("missing", restored));
+}
+
+TEST(snapshot_test, map)
+{
+    std::map<int, double> prev_fire = {{3, 1.5}, {7, 12.25}};
+    sc::Snapshot snapshot;
+    snapshot.set("prev_fire", prev_fire);
+
+    std::map<int, double> restored = {{1, 0}};
+    ASSERT_TRUE(snapshot.get("prev_fire", restored));
+    EXPECT_EQ(restored, prev_fire);
+}
+
+TEST(snapshot_test, plugins)
+{
+    TestModel model;
+    model.x() = {1, 2, 3};
+    sc::Autonomy autonomy;
+    autonomy.desired_state()->vel() << 21, 0, 0;
+
+    sc::Snapshot snapshot;
+    model.save_state(snapshot, "motion");
+    autonomy.save_state(snapshot, "autonomy0");
+
+    model.x() = {0, 0, 0};
+    autonomy.desired_state()->vel() << 0, 0, 0;
+    ASSERT_TRUE(model.restore_state(snapshot, "motion"));
+    ASSERT_TRUE(autonomy.restore_state(snapshot, "autonomy0"));
+    EXPECT_EQ(model.x(), sc::MotionModel::vector_t({1, 2, 3}));
+    EXPECT_EQ(autonomy.desired_state()->vel()(0), 21);
+
+    // a different motion model
+    model.x() = {0, 0};
+    EXPECT_FALSE(model.restore_state(snapshot, "motion"));
+
+    sc::PID pid;
+    pid.set_state(0.5, -0.25);
+    EXPECT_EQ(pid.integral(), 0.5);
+    EXPECT_EQ(pid.prev_error(), -0.25);
+}
+
+TEST(snapshot_test, messages)
+{
+    auto network = std::make_shared<sc::Network>();
+    auto plugin = std::make_shared<sc::Autonomy>();
+    plugin->set_network(network);
+    sc::SubscriberPtr sub = plugin->create_subscriber("Topic");
+
+    auto msg = std::make_shared<sc::Message<int>>();
+    msg->data = 4;
+    sub->msg_list().push_back(msg);
+
+    sc::Snapshot snapshot;
+    plugin->save_state(snapshot, "entity/1/autonomy0");
+
+    // a plugin in another simulation, with its own messages
+    auto other = std::make_shared<sc::Autonomy>();
+    other->set_network(network);
+    sc::SubscriberPtr other_sub = other->create_subscriber("Topic");
+    other_sub->msg_list().push_back(std::make_shared<sc::Message<int>>());
+    sc::SubscriberPtr empty_sub = other->create_subscriber("Other");
+    empty_sub->msg_list().push_back(std::make_shared<sc::Message<int>>());
+
+    ASSERT_TRUE(other->restore_state(snapshot, "entity/1/autonomy0"));
+    ASSERT_EQ(other_sub->msg_list().size(), 1);
+    // shared, not copied
+    EXPECT_EQ(other_sub->msg_list().front(), msg);
+    EXPECT_TRUE(empty_sub->msg_list().empty());
+}
+
+TEST(snapshot_test, fork)
+{
+    std::string mission_file = write_test_mission(8);
+    sc::MissionParsePtr mission = std::make_shared<sc::MissionParse>();
+    ASSERT_TRUE(mission->parse(mission_file));
+    std::remove(mission_file.c_str());
+
+    TestEnv reference;
+    ASSERT_TRUE(reference.init(mission->clone(), 7))
+        << "the core plugins need to be in SCRIMMAGE_PLUGIN_PATH";
+    reference.sim.start();
+    reference.sim.join();
+
+    // forks from before and after the head on collision at t = 4.8
+    std::vector<size_t> num_ents;
+    for (double t : {2.0, 6.0}) {
+        TestEnv source;
+        ASSERT_TRUE(source.init(mission->clone(), 7));
+        sc::SnapshotPtr snapshot;
+        source.sim.set_snapshot_callback(t, [&](sc::SnapshotPtr s) { snapshot = s; });
+        source.sim.start();
+        source.sim.join();
+        ASSERT_NE(snapshot, nullptr);
+        EXPECT_EQ(source.result(), reference.result());
+
+        std::vector<int> ids;
+        ASSERT_TRUE(snapshot->get("sim/entity_ids", ids));
+        num_ents.push_back(ids.size());
+
+        // a different seed, everything has to come from the snapshot
+        TestEnv fork;
+        ASSERT_TRUE(fork.init(mission->clone(), 8));
+        ASSERT_TRUE(fork.sim.restore(*snapshot));
+        // taken at the end of the step that reaches t
+        EXPECT_GE(fork.sim.t(), t);
+        EXPECT_LT(fork.sim.t(), t + 0.15);
+        fork.sim.start();
+        fork.sim.join();
+        EXPECT_EQ(fork.sim.t(), reference.sim.t());
+        EXPECT_EQ(fork.result(), reference.result()) << "fork at t = " << t;
+    }
+    EXPECT_EQ(num_ents[0], 12u);
+    EXPECT_LE(num_ents[1], 10u);
+}
@@ -0,0 +1,199 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <scrimmage/common/Checkpoint.h>
+#include <scrimmage/network/SocketChannel.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace sc = scrimmage;
+
+namespace {
+// Worker process: adds its id to every score it receives and sends it back
+// until it gets a "stop" message.
+int run_worker(std::string address, int id)
+{
+    sc::SocketChannel channel;
+    if (!channel.connect(address, 10)) return 1;
+
+    sc::Checkpoint msg;
+    while (channel.recv(msg)) {
+        std::string type;
+        msg.get("type", type);
+        if (type == "stop") return 0;
+
+        std::vector<double> scores;
+        msg.get("scores", scores);
+        for (double &s : scores) s += id;
+
+        sc::Checkpoint reply;
+        reply.set("type", std::string("result"));
+        reply.set("id", id);
+        reply.set("scores", scores);
+        if (!channel.send(reply)) return 1;
+    }
+    return 1;
+}
+
+void run_master(std::string address)
+{
+    sc::SocketServer server;
+    ASSERT_TRUE(server.listen(address));
+    std::string bound = server.address();
+
+    const int num_workers = 3;
+    std::vector<pid_t> pids;
+    for (int id = 1; id <= num_workers; id++) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) _exit(run_worker(bound, id));
+        pids.push_back(pid);
+    }
+
+    std::vector<sc::SocketChannelPtr> workers;
+    for (int i = 0; i < num_workers; i++) {
+        workers.push_back(std::make_shared<sc::SocketChannel>());
+        ASSERT_TRUE(server.accept(*workers.back()));
+    }
+
+    for (int round = 0; round < 5; round++) {
+        sc::Checkpoint task;
+        task.set("type", std::string("task"));
+        task.set("scores", std::vector<double>{1.0 * round, 2.0, 3.0});
+        for (auto &w : workers) ASSERT_TRUE(w->send(task));
+
+        for (auto &w : workers) {
+            sc::Checkpoint result;
+            ASSERT_TRUE(w->recv(result));
+            int id;
+            std::vector<double> scores;
+            ASSERT_TRUE(result.get("id", id));
+            ASSERT_TRUE(result.get("scores", scores));
+            ASSERT_EQ(scores.size(), 3);
+            EXPECT_EQ(scores[0], round + id);
+            EXPECT_EQ(scores[2], 3.0 + id);
+        }
+    }
+
+    sc::Checkpoint stop;
+    stop.set("type", std::string("stop"));
+    for (auto &w : workers) ASSERT_TRUE(w->send(stop));
+
+    for (pid_t pid : pids) {
+        int status;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        EXPECT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+}
+} // namespace
+
+TEST(socket_channel_test, unix_workers)
+{
+    std::string path = "/tmp/test_socket_channel_" + std::to_string(getpid());
+    run_master("unix:" + path);
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST(socket_channel_test, tcp_workers)
+{
+    run_master("tcp:127.0.0.1:0");
+}
+
+TEST(socket_channel_test, large_message)
+{
+    sc::SocketServer server;
+    ASSERT_TRUE(server.listen("tcp:127.0.0.1:0"));
+
+    std::string big(5 << 20, 'x');
+    big[12345] = 'y';
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        sc::SocketChannel channel;
+        _exit(channel.connect(server.address(), 10) && channel.send(big) ? 0 : 1);
+    }
+
+    sc::SocketChannel channel;
+    ASSERT_TRUE(server.accept(channel));
+    std::string msg;
+    ASSERT_TRUE(channel.recv(msg));
+    EXPECT_EQ(msg, big);
+    EXPECT_FALSE(channel.recv(msg));
+
+    int status;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST(socket_channel_test, bad_length)
+{
+    sc::SocketServer server;
+    ASSERT_TRUE(server.listen("unix:/tmp/test_socket_channel_bad_length"));
+
+    // a stray connection that doesn't send a length prefix
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, "/tmp/test_socket_channel_bad_length");
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) _exit(1);
+        std::string garbage(64, '\xff');
+        _exit(write(fd, garbage.data(), garbage.size()) == 64 ? 0 : 1);
+    }
+
+    sc::SocketChannel channel;
+    ASSERT_TRUE(server.accept(channel));
+    std::string msg;
+    EXPECT_FALSE(channel.recv(msg));
+    EXPECT_FALSE(channel.is_open());
+
+    int status;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST(socket_channel_test, connect_timeout)
+{
+    sc::SocketChannel channel;
+    EXPECT_FALSE(channel.connect("unix:/tmp/no_such_socket_channel", 0.2));
+    EXPECT_FALSE(channel.is_open());
+    EXPECT_FALSE(channel.connect("bogus", 0.2));
+}
@@ -73,3 +73,31 @@ TEST(test_state, rel_az) {
     EXPECT_NEAR(-M_PI / 4, rel_az1, 1e-10);
     EXPECT_NEAR(M_PI / 4, rel_az2, 1e-10);
 }
+
+TEST(test_state, cached_orientation) {
+    sc::State state;
+    state.quat().set(0.1, -0.2, 0.3);
+    EXPECT_EQ(state.roll(), state.quat().roll());
+    EXPECT_EQ(state.pitch(), state.quat().pitch());
+    EXPECT_EQ(state.yaw(), state.quat().yaw());
+
+    // writes through quat() invalidate the cache
+    state.quat().set(-0.4, 0.5, 2.5);
+    EXPECT_EQ(state.roll(), state.quat().roll());
+    EXPECT_EQ(state.pitch(), state.quat().pitch());
+    EXPECT_EQ(state.yaw(), state.quat().yaw());
+
+    Vector3d vec(1, -2, 3);
+    EXPECT_NEAR((state.rotation() * vec - state.quat().rotate(vec)).norm(), 0, 1e-12);
+    EXPECT_NEAR((state.orient_global_frame() -
+                 state.quat().rotate_reverse(Vector3d::UnitX())).norm(), 0, 1e-12);
+
+    sc::State copy = state;
+    EXPECT_EQ(copy.yaw(), state.yaw());
+    copy.quat().set(0, 0, 1);
+    EXPECT_DOUBLE_EQ(copy.yaw(), 1);
+    EXPECT_EQ(state.yaw(), state.quat().yaw());
+
+    state = copy;
+    EXPECT_DOUBLE_EQ(state.yaw(), 1);
+}
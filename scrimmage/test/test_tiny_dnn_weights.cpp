@@ -0,0 +1,104 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///  
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI) 
+///               All Rights Reserved
+///  
+/// The above copyright notice and this permission notice shall be included in 
+/// all copies or substantial portions of the Software.
+///  
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu> 
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+/// 
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <vector>
+
+#include "tiny_dnn/tiny_dnn.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace tiny_dnn;
+using namespace tiny_dnn::layers;
+
+void make_network(network<sequential> &net)
+{
+    net << fc(17, 20) << activation::tanh()
+        << fc(20, 10) << activation::tanh()
+        << fc(10, 3) << activation::tanh();
+    net.weight_init(weight_init::lecun());
+    net.bias_init(weight_init::lecun());
+    net.init_weight();
+}
+
+TEST(tiny_dnn_weights_test, get_set)
+{
+    network<sequential> net;
+    make_network(net);
+
+    size_t n = 17*20 + 20 + 20*10 + 10 + 10*3 + 3;
+    ASSERT_EQ(net.num_weights(), n);
+
+    vec_t theta = net.get_weights();
+    ASSERT_EQ(theta.size(), n);
+
+    for (size_t i = 0; i < theta.size(); i++) {
+        theta[i] = static_cast<float_t>(i) * 0.001;
+    }
+    net.set_weights(&theta);
+
+    // set_weights no longer consumes its input
+    ASSERT_EQ(theta.size(), n);
+    ASSERT_EQ(net.get_weights(), theta);
+
+    vec_t buffer;
+    net.get_weights(buffer);
+    ASSERT_EQ(buffer, theta);
+
+    vec_t wrong_size(n - 1);
+    ASSERT_THROW(net.set_weights(wrong_size), nn_error);
+}
+
+TEST(tiny_dnn_weights_test, views)
+{
+    network<sequential> net;
+    make_network(net);
+
+    // the views alias the network parameters in get_weights() order
+    vec_t theta = net.get_weights();
+    size_t k = 0;
+    for (vec_t *w : net.weights()) {
+        for (float_t &x : *w) {
+            ASSERT_EQ(x, theta[k++]);
+            x *= 2;
+        }
+    }
+    ASSERT_EQ(k, theta.size());
+
+    vec_t doubled = net.get_weights();
+    for (size_t i = 0; i < theta.size(); i++) {
+        ASSERT_EQ(doubled[i], theta[i] * 2);
+    }
+
+    // perturbing is unchanged: same seed, same noise
+    network<sequential> net2;
+    make_network(net2);
+    net2.set_weights(net.get_weights());
+    net.perturb_weights(5, 0.1);
+    net2.perturb_weights(5, 0.1);
+    ASSERT_EQ(net.get_weights(), net2.get_weights());
+}
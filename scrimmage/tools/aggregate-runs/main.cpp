@@ -36,9 +36,13 @@
 #include <string>
 #include <sstream>
 #include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
 #include <scrimmage/parse/MissionParse.h>
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/log/Log.h>
+#include <scrimmage/log/RunIndex.h>
 #include <scrimmage/metrics/Metrics.h>
 #include <scrimmage/common/FileSearch.h>
 
@@ -55,40 +59,41 @@ using std::endl;
 
 void usage(char *argv[])
 {
-    cout << endl << "Usage: " << argv[0] << " -d ~/swarm-log"
-         << endl << endl;
+    cout << endl << "Usage: " << argv[0] << " [-j num_threads] [-f] ~/swarm-log"
+         << endl
+         << "  -j : number of threads used to scan and parse runs"
+         << " (default: number of cores)" << endl
+         << "  -f : ignore the existing index and re-parse every run" << endl
+         << endl;
 }
 
 int main(int argc, char *argv[])
 {
-    //int opt;
-    //while ((opt = getopt (argc, argv, "d:")) != -1) {
-    //    switch (opt) {
-    //    case 'd':
-    //        log_dir = std::string(optarg);
-    //        break;
-    //    case '?':
-    //        if (optopt == 'd') {
-    //            fprintf (stderr, "Option -%d requires a log dir.\n", optopt);
-    //        } else {
-    //            fprintf (stderr,
-    //                     "Unknown option character `\\x%x'.\n",
-    //                     optopt);
-    //        }
-    //        usage(argv);
-    //        return 1;
-    //    default:
-    //        exit(EXIT_FAILURE);
-    //    }
-    //}
+    int num_threads = std::max(1u, std::thread::hardware_concurrency());
+    bool full = false;
+
+    int opt;
+    while ((opt = getopt (argc, argv, "j:f")) != -1) {
+        switch (opt) {
+        case 'j':
+            num_threads = std::stoi(optarg);
+            break;
+        case 'f':
+            full = true;
+            break;
+        default:
+            usage(argv);
+            return -1;
+        }
+    }
 
-    if (argc < 2) {
-        cout << "usage: " << argv[0] << " <directory of filter results>" << endl;
+    if (optind >= argc) {
+        usage(argv);
         return -1;
     }
 
     // Directory holding all the runs (typically, ~/scrimmage-log)
-    std::string log_dir = std::string(argv[1]);
+    std::string log_dir = std::string(argv[optind]);
 
     if (!fs::exists(fs::path(log_dir))) {
         cout << "Log directory doesn't exist: " << log_dir << endl;
@@ -96,130 +101,100 @@ int main(int argc, char *argv[])
         return -1;
     }    
 
-    // Find all summary.csv files under the directory
-    std::vector<std::string> paths;
-    fs::path root = log_dir;
-    std::string summary_csv = "summary.csv";
-    if(fs::exists(root) && fs::is_directory(root)) {
-        fs::recursive_directory_iterator it(root);
-        fs::recursive_directory_iterator endit;
+    fs::path aggregate_dir = fs::path(log_dir) / "aggregate";
+    std::string index_file = (aggregate_dir / "runs.csv").string();
+    std::string output_dir = (aggregate_dir / "team-vs-team").string();
 
-        while(it != endit) {
-            if(fs::is_regular_file(*it) && it->path().filename() == summary_csv) {
-                std::string full_path = fs::absolute(it->path()).string();
-                paths.push_back(full_path);
-            }
-            ++it;
+    if(!fs::exists(aggregate_dir)) {
+        if(!fs::create_directories(aggregate_dir)) {
+            cout << "Failed to create output directory: " << aggregate_dir << endl;
+            return -1;
         }
-    } else {
-        cout << "Path doesn't exist: " << log_dir << endl;
     }
-    
-    // Create output directory for aggregated results
-    std::string output_dir = log_dir + "/aggregate/team-vs-team";
 
-    if(!fs::remove_all(output_dir)) {
-        cout << "Failed to remove old directory: " << output_dir << endl;
+    // Incremental mode: only runs that are new or whose summary.csv
+    // changed since the last aggregation are parsed.
+    auto start = std::chrono::steady_clock::now();
+    sc::RunIndex index;
+    bool loaded = !full && index.load(index_file);
+    if (loaded) {
+        cout << "Loaded index of " << index.runs().size() << " runs." << endl;
+    }
+    std::map<std::string, std::vector<std::string>> old_outcomes = index.outcomes();
+
+    int num_parsed = index.update(log_dir, num_threads, aggregate_dir.string());
+    cout << "Aggregating " << index.runs().size() << " runs ("
+         << num_parsed << " parsed). " << endl;
+
+    // Bring the per-outcome files used by filter-runs up to date. Only the
+    // outcomes whose list of runs changed are rewritten.
+    if(!fs::exists(output_dir) && !fs::create_directories(output_dir)) {
+        cout << "Failed to create output directory: " << output_dir << endl;
         return -1;
     }
-    
-    if(!fs::exists(output_dir)) {
-        if(!fs::create_directories(output_dir)) {
-            cout << "Failed to create output directory: " << output_dir << endl;
-            return -1;
+
+    std::map<std::string, std::vector<std::string>> outcomes = index.outcomes();
+
+    boost::system::error_code ec;
+    for (fs::directory_iterator it(output_dir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (it->path().extension() == ".result" &&
+            outcomes.count(it->path().stem().string()) == 0) {
+            fs::remove(it->path(), ec);
         }
     }
 
-    int number_of_runs = paths.size();
-    cout << "Aggregating " << number_of_runs << " runs. " << endl;
-
-    int count = 0;
-    std::map<int,int> team_wins;
-    std::map<int,int> team_draws;
-    
-    std::clock_t start = std::clock();
-    std::ofstream summary_file(log_dir + "/aggregate/all_runs.csv");
+    int num_written = 0;
+    for (auto &kv : outcomes) {
+        fs::path result_path = fs::path(output_dir) / (kv.first + ".result");
+        auto it = old_outcomes.find(kv.first);
+        if (loaded && it != old_outcomes.end() && it->second == kv.second &&
+            fs::exists(result_path)) {
+            continue;
+        }
 
-    // Using the score from each summary_csv, keep track of team wins
-    for (std::string &filename : paths) {        
-        if (!fs::exists(fs::path(filename))) {
-            cout << "summary.csv doesn't exist: " << filename << endl;
+        // Write the directory of each simulation with this outcome
+        std::string tmp = result_path.string() + ".tmp";
+        {
+            std::ofstream result_file(tmp);
+            for (const std::string &dir : kv.second) {
+                result_file << dir << "\n";
+            }
+        }
+        if (std::rename(tmp.c_str(), result_path.string().c_str()) != 0) {
+            cout << "Failed to write: " << result_path << endl;
             return -1;
         }
+        num_written++;
+    }
+    cout << "Updated " << num_written << " of " << outcomes.size()
+         << " outcome files." << endl;
 
-        std::ifstream csv_file(filename);
-        std::string run_num;
-        
-        std::string line;
-        std::getline(csv_file, line); //skip header comment
+    // Saved last, so outcome files that failed to update are compared
+    // against the previous index on the next call
+    if (!index.save(index_file)) {
+        return -1;
+    }
 
-        std::map<int, double> team_scores;
-        while (std::getline(csv_file, line)) {
-            std::vector<std::string> t;
-            boost::split(t, line, boost::is_any_of(","));
+    std::map<int,int> team_wins;
+    std::map<int,int> team_draws;
 
-            int team_id = std::stoi(t[0]);            
-            team_scores[team_id] = std::stod(t[1]);            
-        }
-        
-        // Determine which teams lost, won, and drew
-        double max_score = -std::numeric_limits<double>::infinity();
-        std::vector<int> winning_team;
-        for (auto &kv : team_scores) {
-            if (std::abs(kv.second-max_score) < 0.000001) {
-                // A possible draw
-                winning_team.push_back(kv.first);
-            } else if (kv.second > max_score) {
-                max_score = kv.second;
-                winning_team.clear();
-                winning_team.push_back(kv.first);
-            }
-        }
+    for (auto &kv : outcomes) {
+        const std::string &outcome = kv.first;
+        std::vector<std::string> teams;
+        boost::split(teams, outcome, boost::is_any_of("_"));
 
-        std::string result_filename = "";
-        if (winning_team.size() == 0) {
-            cout << "Warning: Couldn't determine winner of: " << filename << endl;
-            continue;
-        } else if (winning_team.size() == 1) {
-            result_filename = "team_" + std::to_string(winning_team[0]);
-            // One winner, write a win file
-            if (team_wins.count(winning_team[0]) > 0) {
-                team_wins[winning_team[0]] += 1;
-            } else {                
-                team_wins[winning_team[0]] = 1;                
+        if (teams[0] == "team" && teams.size() == 2) {
+            team_wins[std::stoi(teams[1])] += kv.second.size();
+        } else if (teams[0] == "draw") {
+            for (size_t i = 1; i < teams.size(); i++) {
+                team_draws[std::stoi(teams[i])] += kv.second.size();
             }
-        } else if (winning_team.size() > 1) {
-            // Draw for multiple winners
-            result_filename = "draw";
-            for (auto &team : winning_team) {
-                result_filename += "_" + std::to_string(team);
-
-                if (team_draws.count(team) > 0) {
-                    team_draws[team] += 1;
-                } else {                
-                    team_draws[team] = 1;                
-                }                
-            }            
-        } else {
-            cout << "Warning" << endl;
         }
-
-        result_filename = output_dir + "/" + result_filename + ".result";
-                
-        // Write log directory to file        
-        std::ofstream result_file;
-        result_file.open(result_filename, std::ios::out | std::ios::app);
-                
-        // Write the parent directory of this specific simulation to the file.
-        result_file << fs::path(filename).parent_path().string() << endl;
-        result_file.close();                
-        
-        count++;
-        scrimmage::display_progress((float)count / (float)number_of_runs);
     }
-    cout << endl;
 
-    double duration = ( std::clock() - start ) / (double) CLOCKS_PER_SEC;
+    double duration = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
     cout << "Total time to process log files: " << duration << endl;
 
     // Make a map of the available team ids, so we can loop over it while
@@ -258,9 +233,8 @@ int main(int argc, char *argv[])
         cout << std::left << std::setw(col_wid) << kv.first;
         cout << std::left << std::setw(col_wid) << wins;
         cout << std::left << std::setw(col_wid) << draws;
-        cout << std::left << std::setw(col_wid) << paths.size() << endl;
+        cout << std::left << std::setw(col_wid) << index.runs().size() << endl;
     }
     
-    summary_file.close();
     return 0;
 }
@@ -0,0 +1,123 @@
+/// ---------------------------------------------------------------------------
+/// @section LICENSE
+///
+/// Copyright (c) 2016 Georgia Tech Research Institute (GTRI)
+///               All Rights Reserved
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+/// ---------------------------------------------------------------------------
+/// @file filename.ext
+/// @author Kevin DeMarco <kevin.demarco@gtri.gatech.edu>
+/// @author Eric Squires <eric.squires@gtri.gatech.edu>
+/// @version 1.0
+/// ---------------------------------------------------------------------------
+/// @brief A brief description.
+///
+/// @section DESCRIPTION
+/// A long description.
+/// ---------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include <unistd.h>
+
+#include <scrimmage/log/ColumnarLog.h>
+
+#include <boost/filesystem.hpp>
+
+namespace fs = boost::filesystem;
+namespace sc = scrimmage;
+
+using std::cout;
+using std::endl;
+
+void usage(char *argv[])
+{
+    cout << endl << "Usage: " << argv[0]
+         << " [-n ticks_per_chunk] [-u] <input> <output>" << endl
+         << "  Converts frames.bin to frames.col (or back), based on the"
+         << " input extension." << endl
+         << "  A log directory can also be given as the input to convert"
+         << " its frames file in place." << endl
+         << "  -n : ticks per chunk in the columnar file (default: 256)" << endl
+         << "  -u : don't compress columnar chunks" << endl
+         << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int ticks_per_chunk = 256;
+    bool compress = true;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:u")) != -1) {
+        switch (opt) {
+        case 'n':
+            ticks_per_chunk = std::stoi(optarg);
+            break;
+        case 'u':
+            compress = false;
+            break;
+        default:
+            usage(argv);
+            return -1;
+        }
+    }
+
+    if (optind >= argc) {
+        usage(argv);
+        return -1;
+    }
+
+    std::string input = argv[optind];
+    std::string output = optind + 1 < argc ? argv[optind + 1] : "";
+
+    if (fs::is_directory(input)) {
+        if (fs::exists(input + "/frames.bin")) {
+            output = input + "/frames.col";
+            input = input + "/frames.bin";
+        } else {
+            output = input + "/frames.bin";
+            input = input + "/frames.col";
+        }
+    }
+
+    if (!fs::exists(input)) {
+        cout << "Input file doesn't exist: " << input << endl;
+        usage(argv);
+        return -1;
+    }
+
+    if (output == "") {
+        usage(argv);
+        return -1;
+    }
+
+    bool success;
+    if (fs::path(input).extension() == ".col") {
+        cout << "Converting columnar log " << input << " to " << output << endl;
+        success = sc::columnar_to_frames(input, output);
+    } else {
+        cout << "Converting frames " << input << " to " << output << endl;
+        success = sc::frames_to_columnar(input, output, ticks_per_chunk, compress);
+    }
+
+    if (!success) {
+        cout << "Conversion failed." << endl;
+        return -1;
+    }
+
+    cout << "Input size: " << fs::file_size(input) << " bytes" << endl;
+    cout << "Output size: " << fs::file_size(output) << " bytes" << endl;
+    return 0;
+}
@@ -37,6 +37,7 @@
 #include <scrimmage/parse/MissionParse.h>
 #include <scrimmage/common/Utilities.h>
 #include <scrimmage/log/Log.h>
+#include <scrimmage/log/RunIndex.h>
 #include <scrimmage/metrics/Metrics.h>
 
 #include <boost/filesystem.hpp>
@@ -57,11 +58,36 @@ int main(int argc, char *argv[])
     // Directory holding all the runs (typically, ~/scrimmage-log)
     std::string dir = std::string(argv[1]);
 
+    // Key: Name of file stem
+    // Value: List of paths of this type
+    std::map<std::string, std::list<std::string> > scenarios;
+
+    // Prefer the consolidated index written by aggregate-runs, it avoids
+    // walking the log tree
+    std::string index_file = "";
+    for (fs::path p : {fs::path(dir) / "runs.csv",
+                       fs::path(dir) / "aggregate" / "runs.csv",
+                       fs::path(dir) / ".." / "runs.csv"}) {
+        if (fs::is_regular_file(p)) {
+            index_file = p.string();
+            break;
+        }
+    }
+
+    sc::RunIndex index;
+    if (index_file != "" && index.load(index_file)) {
+        for (auto &kv : index.outcomes()) {
+            scenarios[kv.first].assign(kv.second.begin(), kv.second.end());
+        }
+    }
+
     // Find all .txt files under the directory
     std::vector<std::string> paths;
     fs::path root = dir;
     std::string ext = ".result";
-    if(fs::exists(root) && fs::is_directory(root)) {
+    if (!scenarios.empty()) {
+        // Already loaded from the index
+    } else if(fs::exists(root) && fs::is_directory(root)) {
         fs::recursive_directory_iterator it(root);
         fs::recursive_directory_iterator endit;
 
@@ -76,10 +102,6 @@ int main(int argc, char *argv[])
         cout << "Path doesn't exist: " << dir << endl;
     }
 
-    // Key: Name of file stem
-    // Value: List of paths of this type
-    std::map<std::string, std::list<std::string> > scenarios;
-
     // Open each .txt file and extract a metric
     for (std::vector<std::string>::iterator it = paths.begin();
          it != paths.end(); it++) {
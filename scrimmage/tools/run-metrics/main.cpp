@@ -108,6 +108,9 @@ int main(int argc, char *argv[])
         return -1;
     }    
 
+    // Frames are parsed up front, not streamed with a FrameReader:
+    // process_log() takes the whole Log, and this tool isn't built (see
+    // tools/CMakeLists.txt).
     scrimmage::Log log;
     log.parse(log_file, scrimmage::Log::FRAMES);
     cout << "Frames parsed: " << log.frames().size() << endl;